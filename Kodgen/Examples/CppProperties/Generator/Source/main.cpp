@@ -1,5 +1,6 @@
 #include <Kodgen/Parsing/FileParser.h>
 #include <Kodgen/CodeGen/CodeGenManager.h>
+#include <Kodgen/CodeGen/CodeGenServer.h>
 #include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
 #include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
 #include <Kodgen/Misc/Filesystem.h>
@@ -32,6 +33,16 @@ void initCodeGenManagerSettings(fs::path const& workingDirectory, kodgen::CodeGe
 
 	//Only parse .h files
 	out_generatorSettings.addSupportedFileExtension(".h");
+
+	//Don't parse files again between iterations if the generated files they include didn't change
+	out_generatorSettings.shouldReuseParsingResults = true;
+	out_generatorSettings.shouldPipelineIterations = true;
+	out_generatorSettings.shouldProcessLongestFilesFirst = true;
+	out_generatorSettings.shouldUseGenerationManifest = true;
+	out_generatorSettings.shouldTrackIncludeDependencies = true;
+	out_generatorSettings.shouldSkipFilesWithoutAnnotations = true;
+	out_generatorSettings.shouldReuseWorkerInstances = true;
+	out_generatorSettings.shouldWriteFilesAsynchronously = true;
 }
 
 bool initParsingSettings(kodgen::ParsingSettings& parsingSettings)
@@ -39,6 +50,10 @@ bool initParsingSettings(kodgen::ParsingSettings& parsingSettings)
 	//We abort parsing if we encounter a single error while parsing
 	parsingSettings.shouldAbortParsingOnFirstError = true;
 
+	//Parse files with a precompiled header containing the standard headers they include
+	parsingSettings.shouldUsePrecompiledHeader = true;
+	parsingSettings.precompiledHeaderIncludes = { "string", "vector", "unordered_map" };
+
 	//Each property will be separed by a ,
 	parsingSettings.propertyParsingSettings.propertySeparator = ',';
 
@@ -122,8 +137,34 @@ int main(int argc, char** argv)
 
 	initCodeGenManagerSettings(workingDirectory, codeGenMgr.settings);
 
+	//With --state-dir <directory>, keep the files saved between runs out of the source tree
+	//With --serve <socketPath>, keep the generator running and answer generation requests sent to the socket
+	char const* socketPath = nullptr;
+
+	for (int i = 2; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+
+		if (option == "--state-dir")
+		{
+			codeGenMgr.settings.setStateDirectory(argv[i + 1]);
+		}
+		else if (option == "--serve")
+		{
+			socketPath = argv[i + 1];
+		}
+	}
+
+	if (socketPath != nullptr)
+	{
+		kodgen::CodeGenServer codeGenServer(codeGenMgr);
+		codeGenServer.logger = &logger;
+
+		return codeGenServer.serve(fileParser, codeGenUnit, socketPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	//Kick-off code generation
-	kodgen::CodeGenResult genResult = codeGenMgr.run(fileParser, codeGenUnit, true);
+	kodgen::CodeGenResult genResult = codeGenMgr.run(fileParser, codeGenUnit);
 
 	if (genResult.completed)
 	{
@@ -8,57 +8,388 @@
 #pragma once
 
 #include <set>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <memory>		//std::unique_ptr
+#include <functional>	//std::function
 #include <cassert>
 #include <type_traits>	//std::is_base_of
 #include <chrono>		//std::chrono::high_resolution_clock
+#include <algorithm>	//std::max
+#include <tuple>
+#include <array>
+#include <utility>		//std::index_sequence
 
 #include "Kodgen/Misc/ILogger.h"
 #include "Kodgen/CodeGen/CodeGenResult.h"
 #include "Kodgen/CodeGen/CodeGenUnit.h"
+#include "Kodgen/CodeGen/FileDurationHistory.h"
+#include "Kodgen/CodeGen/GenerationManifest.h"
+#include "Kodgen/CodeGen/GeneratedFileWriter.h"
+#include "Kodgen/CodeGen/IncludeDependencyGraph.h"
 #include <Kodgen/CodeGen/CodeGenManagerSettings.h>
 #include "Kodgen/Parsing/FileParser.h"
 #include "Kodgen/Threading/ThreadPool.h"
 #include "Kodgen/Threading/TaskHelper.h"
+#include "Kodgen/Threading/MemoryBudgetController.h"
 
 namespace kodgen
 {
 	class CodeGenManager
 	{
 		private:
+			struct CachedFileParsingResult
+			{
+				/** Result of the last parsing of the file. */
+				FileParsingResult								parsingResult;
+
+				/** Hash of the content libclang parsed for each generated file included by the parsed file. */
+				std::unordered_map<fs::path, uint64, PathHash>	generatedIncludesHashes;
+
+				/** Is the parsed content of any generated file included by the parsed file unknown? If so, the parsing result is never reused. */
+				bool											hasUnknownGeneratedInclude	= false;
+			};
+
+			struct FileGeneration
+			{
+				/** Is the code generated for the file by the generation unit outdated? */
+				bool	shouldGenerate			= false;
+
+				/** Did the last code generation iteration of the file by the generation unit complete successfully? */
+				bool	isGenerationSuccessful	= false;
+
+				/** Time spent (in seconds) by the generation unit to generate code for the file during all iterations. */
+				float	generationDuration		= 0.0f;
+
+				/** Part of generationDuration spent writing the generated files. */
+				float	writeDuration			= 0.0f;
+
+				/** Time spent (in seconds) by the generation tasks waiting for a worker once the file was parsed, during all iterations. */
+				float	queueWaitDuration		= 0.0f;
+			};
+
+			struct ProcessedFile
+			{
+				/** Generation of the file by each generation unit, indexed like the generation units. */
+				std::vector<FileGeneration>	generations;
+
+				/** Files included by the file during its last parsing, except generated files. Only filled when include dependencies are tracked. */
+				std::vector<fs::path>		includedFiles;
+
+				/**
+				*	Timings of the parsing tasks of the file, also used to fill the duration history of the file.
+				*	Generation timings are kept by each file generation until the end of the run.
+				*/
+				CodeGenResult::FileTimings				timings;
+
+				/** Was the file skipped without being parsed by its last parsing task, since it can't contain any entity? */
+				bool									isSkipped	= false;
+
+				/** Time at which the last parsing task of the file completed. */
+				std::chrono::steady_clock::time_point	parsingEndTime;
+			};
+
+			struct GenerationUnitState
+			{
+				/** Generation manifest stored in the output directory of the generation unit. */
+				GenerationManifest		manifest;
+
+				/** Include dependency graph stored in the output directory of the generation unit. */
+				IncludeDependencyGraph	dependencyGraph;
+
+				/** Files whose generated code is outdated for the generation unit. */
+				std::set<fs::path>		filesToProcess;
+			};
+
+			struct PipelineState
+			{
+				/** Mutex used to synchronize accesses to all the other fields. */
+				std::mutex								mutex;
+
+				/** Number of iterations completed by each file. */
+				std::vector<uint8>						completedIterationsCount;
+
+				/** Number of files each file waits for before starting its next iteration. */
+				std::vector<size_t>						pendingFilesCount;
+
+				/** Files waiting for each file to complete its current iteration. */
+				std::vector<std::vector<size_t>>		waitingFiles;
+
+				/** Generation results of the iterations completed so far. */
+				CodeGenResult							genResult;
+
+				PipelineState(size_t fileCount)	noexcept;
+			};
+
 			/** Thread pool used for files processing. */
-			ThreadPool	_threadPool;
+			ThreadPool										_threadPool;
+
+			/** Controller limiting the number of files parsed at once during a run, or nullptr if parsings are not limited. */
+			std::unique_ptr<MemoryBudgetController>			_memoryBudgetController;
 
 			/**
-			*	@brief Process all provided files on multiple threads.
+			*	@brief	Process all provided files on multiple threads.
+			*			All files complete an iteration before any file starts the next one.
 			*	
-			*	@param fileParser		Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
-			*	@param codeGenUnit		Generation unit used to generate files. It must have a clean state when this method is called.
-			*	@param toProcessFiles	Collection of all files to process.
-			*	@param out_genResult	Reference to the generation result to fill during file generation.
+			*	@param fileParser			Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
+			*	@param codeGenUnits			Generation units used to generate files. They must have a clean state when this method is called.
+			*	@param outputDirectories	Output directory of each generation unit.
+			*	@param toProcessFiles		Collection of all files to process, in submission order.
+			*	@param inout_processedFiles	Durations and generation status of each file, indexed like toProcessFiles.
+			*								The generation units each file must be generated by must be set.
+			*	@param out_genResult		Reference to the generation result to fill during file generation.
 			*/
-			template <typename FileParserType, typename CodeGenUnitType>
-			void	processFiles(FileParserType&			fileParser,
-								 CodeGenUnitType&			codeGenUnit,
-								 std::set<fs::path> const&	toProcessFiles,
-								 CodeGenResult&				out_genResult)										noexcept;
+			template <typename FileParserType, typename... CodeGenUnitTypes>
+			void	processFiles(FileParserType&							fileParser,
+								 std::tuple<CodeGenUnitTypes&...> const&	codeGenUnits,
+								 std::vector<fs::path> const&				outputDirectories,
+								 std::vector<fs::path> const&				toProcessFiles,
+								 std::vector<ProcessedFile>&				inout_processedFiles,
+								 CodeGenResult&								out_genResult)						noexcept;
+
+			/**
+			*	@brief	Process all provided files on multiple threads.
+			*			A file starts its next iteration as soon as itself and the processed files it includes completed their current iteration.
+			*	
+			*	@param fileParser			Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
+			*	@param codeGenUnits			Generation units used to generate files. They must have a clean state when this method is called.
+			*	@param outputDirectories	Output directory of each generation unit.
+			*	@param toProcessFiles		Collection of all files to process, in submission order.
+			*	@param inout_processedFiles	Durations and generation status of each file, indexed like toProcessFiles.
+			*								The generation units each file must be generated by must be set.
+			*	@param out_genResult		Reference to the generation result to fill during file generation.
+			*/
+			template <typename FileParserType, typename... CodeGenUnitTypes>
+			void	processFilesPipelined(FileParserType&							fileParser,
+										  std::tuple<CodeGenUnitTypes&...> const&	codeGenUnits,
+										  std::vector<fs::path> const&				outputDirectories,
+										  std::vector<fs::path> const&				toProcessFiles,
+										  std::vector<ProcessedFile>&				inout_processedFiles,
+										  CodeGenResult&							out_genResult)				noexcept;
+
+			/**
+			*	@brief Call a callable on each generation unit of a tuple, along with the index of the generation unit.
+			*	
+			*	@param codeGenUnits	Generation units to iterate on.
+			*	@param callable		Callable taking a std::integral_constant<size_t> index and a generation unit reference.
+			*/
+			template <typename... CodeGenUnitTypes, typename Callable>
+			static void	foreachCodeGenUnit(std::tuple<CodeGenUnitTypes&...> const&	codeGenUnits,
+										   Callable&&								callable)						noexcept;
+
+			template <typename... CodeGenUnitTypes, typename Callable, size_t... Indices>
+			static void	foreachCodeGenUnit(std::tuple<CodeGenUnitTypes&...> const&	codeGenUnits,
+										   Callable&&								callable,
+										   std::index_sequence<Indices...>)											noexcept;
+
+			/**
+			*	@brief	Submit the tasks of a code generation iteration of a file: its parsing, its generation by each generation unit
+			*			which generates the file during this iteration, and a task completing the iteration once all others completed.
+			*	
+			*	@param fileParser					Original file parser. It is copied to parse the file.
+			*	@param workerFileParsers			File parser of each worker, used instead of a copy if instances are reused between files.
+			*	@param codeGenUnits					Generation units used to generate files.
+			*	@param workerCodeGenUnits			Generation units of each worker, used instead of copies if instances are reused between files.
+			*	@param outputDirectories			Output directory of each generation unit.
+			*	@param iteration					Index of the code generation iteration.
+			*	@param file							File to process.
+			*	@param inout_cachedParsingResult	Cached parsing result of the file.
+			*	@param inout_processedFile			Processed file state.
+			*	@param onIterationCompleted			Callable run by the completion task once the file completed the iteration, taking the parsing result
+			*										of the file and the CodeGenResult&& of the iteration, and returning the indices of the files
+			*										which can start their next iteration.
+			*	@param submitIteration				Callable submitting the next iteration of a file, taking the index of the file.
+			*										It is called once the parsing result has been released, unless it is reused.
+			*
+			*	@return The completion task.
+			*/
+			template <typename FileParserType, typename... CodeGenUnitTypes, typename OnIterationCompleted, typename SubmitIteration>
+			std::shared_ptr<TaskBase>	submitFileIteration(FileParserType&												fileParser,
+															std::vector<std::unique_ptr<FileParserType>>&				workerFileParsers,
+															std::tuple<CodeGenUnitTypes&...> const&						codeGenUnits,
+															std::tuple<std::vector<std::unique_ptr<CodeGenUnitTypes>>...>&	workerCodeGenUnits,
+															std::vector<fs::path> const&								outputDirectories,
+															uint8														iteration,
+															fs::path const&												file,
+															CachedFileParsingResult&									inout_cachedParsingResult,
+															ProcessedFile&												inout_processedFile,
+															OnIterationCompleted										onIterationCompleted,
+															SubmitIteration												submitIteration)	noexcept;
+
+			/**
+			*	@brief Get the highest iteration count between generation units.
+			*	
+			*	@param codeGenUnits Generation units.
+			*
+			*	@return The highest iteration count between generation units.
+			*/
+			template <typename... CodeGenUnitTypes>
+			static uint8				getIterationCount(std::tuple<CodeGenUnitTypes&...> const& codeGenUnits)							noexcept;
+
+			/**
+			*	@brief	Get the instance a task should use: the instance of the calling worker if instances are reused between files,
+			*			or a new copy of the original instance otherwise.
+			*	
+			*	@param original					Original instance to copy.
+			*	@param inout_workerInstances	Instance of each worker, indexed by worker index. Missing instances are copied from the original.
+			*	@param out_taskInstance			Storage of the copy if instances are not reused between files.
+			*
+			*	@return The instance the task should use.
+			*/
+			template <typename T>
+			T&		getTaskInstance(T const&							original,
+									std::vector<std::unique_ptr<T>>&	inout_workerInstances,
+									std::unique_ptr<T>&					out_taskInstance)								noexcept;
+
+			/**
+			*	@brief Parse a file for a code generation iteration, unless the cached parsing result can be reused.
+			*	
+			*	@param fileParser					Original file parser. It is copied to parse the file.
+			*	@param workerFileParsers			File parser of each worker, used instead of a copy if instances are reused between files.
+			*	@param outputDirectories			Output directory of each generation unit.
+			*	@param file							File to parse.
+			*	@param inout_cachedParsingResult	Cached parsing result of the file, updated if the file is parsed.
+			*	@param canReuseResult				Can the cached parsing result be reused if it is still valid?
+			*	@param inout_processedFile			Processed file state, its parsing duration is increased by the time spent in this method.
+			*
+			*	@return true if the file has been parsed, false if the cached parsing result has been reused.
+			*/
+			template <typename FileParserType>
+			bool	parseFile(FileParserType const&							fileParser,
+							  std::vector<std::unique_ptr<FileParserType>>&	workerFileParsers,
+							  std::vector<fs::path> const&					outputDirectories,
+							  fs::path const&								file,
+							  CachedFileParsingResult&						inout_cachedParsingResult,
+							  bool											canReuseResult,
+							  ProcessedFile&								inout_processedFile)				noexcept;
+
+			/**
+			*	@brief Generate code for a parsed file with a generation unit.
+			*	
+			*	@param codeGenUnit			Generation unit model. It is copied to generate code.
+			*	@param workerCodeGenUnits	Generation unit of each worker, used instead of a copy if instances are reused between files.
+			*	@param cachedParsingResult	Cached parsing result of the file.
+			*	@param inout_generation		Generation of the file by the generation unit, its generation duration is increased
+			*								by the time spent in this method and its generation status is updated.
+			*
+			*	@return true if the code generation completed successfully, else false.
+			*/
+			template <typename CodeGenUnitType>
+			bool			generateFile(CodeGenUnitType const&							codeGenUnit,
+										 std::vector<std::unique_ptr<CodeGenUnitType>>&	workerCodeGenUnits,
+										 CachedFileParsingResult const&					cachedParsingResult,
+										 FileGeneration&								inout_generation)			noexcept;
+
+			/**
+			*	@brief	Generate code for a parsed file, splitting the generation of its entities across the thread pool if it contains
+			*			enough entities. The generated code is the same as the code generated by CodeGenUnit::generateCode.
+			*	
+			*	@param codeGenUnit		Generation unit model. It is copied to generate the code of each shard.
+			*	@param generationUnit	Generation unit merging the code of all shards and writing the generated files.
+			*	@param parsingResult	Result of the file parsing.
+			*
+			*	@return true if the code generation completed successfully, else false.
+			*/
+			template <typename CodeGenUnitType>
+			bool			generateCodeInShards(CodeGenUnitType const&		codeGenUnit,
+												 CodeGenUnitType&			generationUnit,
+												 FileParsingResult const&	parsingResult)									noexcept;
+
+			/**
+			*	@brief Update the files included by a processed file from its parsing result, except files generated by any generation unit.
+			*	
+			*	@param parsingResult		Last parsing result of the file.
+			*	@param outputDirectories	Output directory of each generation unit.
+			*	@param inout_processedFile	Processed file to update the included files of.
+			*/
+			static void					updateIncludedFiles(FileParsingResult const&		parsingResult,
+															std::vector<fs::path> const&	outputDirectories,
+															ProcessedFile&					inout_processedFile)				noexcept;
+
+			/**
+			*	@brief	Get the processed files a file depends on to start its next iteration.
+			*			If the file could not be parsed, it depends on all processed files.
+			*	
+			*	@param parsingResult		Last parsing result of the file.
+			*	@param processedFileIndices	Index of each processed file.
+			*
+			*	@return Indices of the processed files included by the file.
+			*/
+			static std::vector<size_t>	getProcessedIncludes(FileParsingResult const&								parsingResult,
+															 std::unordered_map<fs::path, size_t, PathHash> const&	processedFileIndices)	noexcept;
+
+			/**
+			*	@brief Mark an iteration of a file as completed and retrieve the files which can start their next iteration.
+			*	
+			*	@param inout_pipelineState	State of the pipeline.
+			*	@param fileIndex			Index of the file which completed an iteration.
+			*	@param iterationCount		Number of iterations each file must complete.
+			*	@param processedIncludes	Processed files the file must wait for before starting its next iteration.
+			*
+			*	@return Indices of the files which can start their next iteration.
+			*/
+			static std::vector<size_t>	completeIteration(PipelineState&				inout_pipelineState,
+														  size_t						fileIndex,
+														  uint8							iterationCount,
+														  std::vector<size_t> const&	processedIncludes)								noexcept;
 
 			/**
 			*	@brief Identify all files which will be parsed & regenerated.
 			*	
 			*	@param codeGenUnit			Generation unit used to determine whether a file should be reparsed/regenerated or not.
+			*	@param manifest				Generation manifest used to detect content changes. If nullptr, last write times are used instead.
+			*	@param dependencyGraph		Include dependency graph used to detect changes in included files. Can be nullptr.
 			*	@param out_genResult		Reference to the generation result to fill during file generation.
 			*	@param forceRegenerateAll	Should all files be regenerated or not (regardless of CodeGenManager::shouldRegenerateFile() returned value).
 			*
 			*	@return A collection of all files which will be regenerated.
 			*/
-			std::set<fs::path>		identifyFilesToProcess(CodeGenUnit const&	codeGenUnit,
-														   CodeGenResult&		out_genResult,
-														   bool					forceRegenerateAll)				noexcept;
+			std::set<fs::path>		identifyFilesToProcess(CodeGenUnit const&		codeGenUnit,
+														   GenerationManifest*		manifest,
+														   IncludeDependencyGraph*	dependencyGraph,
+														   CodeGenResult&			out_genResult,
+														   bool						forceRegenerateAll)			noexcept;
+
+			/**
+			*	@brief	Check whether the code generated for a file is up-to-date.
+			*			With a manifest, the file is up-to-date if its content didn't change since its last successful generation
+			*			and its generated files exist. Otherwise, CodeGenUnit::isUpToDate is used.
+			*			With a dependency graph, none of the files included by the file must have changed either.
+			*	
+			*	@param codeGenUnit		Generation unit used to check the generated files.
+			*	@param file				Source file to check.
+			*	@param manifest			Generation manifest used to detect content changes. Can be nullptr.
+			*	@param dependencyGraph	Include dependency graph used to detect changes in included files. Can be nullptr.
+			*
+			*	@return true if the code generated for the file is up-to-date, else false.
+			*/
+			static bool				isFileUpToDate(CodeGenUnit const&		codeGenUnit,
+												   fs::path const&			file,
+												   GenerationManifest*		manifest,
+												   IncludeDependencyGraph*	dependencyGraph)								noexcept;
+
+			/**
+			*	@brief	Compute the fingerprint of the whole generation environment: parsing settings, generation unit
+			*			and build identity of the running generator executable and of the loaded Kodgen library.
+			*	
+			*	@param parsingSettings	Parsing settings used to parse files.
+			*	@param codeGenUnit		Generation unit used to generate code.
+			*
+			*	@return The fingerprint of the generation environment.
+			*/
+			static uint64			computeGenerationFingerprint(ParsingSettings const&	parsingSettings,
+																 CodeGenUnit const&		codeGenUnit)					noexcept;
 
 			/**
-			*	@brief	Get the number of threads to use based on the provided thread count.
-			*			If 0 is provided, std::thread::hardware_concurrency is used, or 8 if std::thread::hardware_concurrency returns 0.
-			*			For all other initial thread count values, the function returns immediately this number.
+			*	@brief	Create the controller limiting the number of files parsed at once to stay under the memory budget.
+			* 
+			*	@return The controller, or nullptr if there is no memory budget or the memory of the process can't be sampled on this platform.
+			*/
+			std::unique_ptr<MemoryBudgetController>	createMemoryBudgetController()				const	noexcept;
+
+			/**
+			*	@brief	Get the number of threads to use based on the provided thread count (see System::getThreadCount).
 			* 
 			*	@param initialThreadCount The number of threads to use.
 			* 
@@ -66,6 +397,63 @@ namespace kodgen
 			*/
 			uint32					getThreadCount(uint32 initialThreadCount)							const	noexcept;
 
+			/**
+			*	@brief	Keep the hash of the content parsed for all files included by a parsed file which are located in the output directory.
+			*			Only generated files are considered since they are the only ones that can be rewritten between two iterations.
+			*			Hashes come from the content libclang parsed, so that a generated file rewritten while the file was parsed is detected.
+			* 
+			*	@param inout_cachedParsingResult	Cached parsing result to refresh the hashes of.
+			*	@param outputDirectories			Directories in which files are generated.
+			*/
+			static void				refreshGeneratedIncludesHashes(CachedFileParsingResult&		inout_cachedParsingResult,
+																   std::vector<fs::path> const&	outputDirectories)			noexcept;
+
+			/**
+			*	@brief Check whether any generated file included by a parsed file has been modified since the file was parsed.
+			* 
+			*	@param cachedParsingResult The cached parsing result to check.
+			* 
+			*	@return true if any included generated file content changed or is unknown, else false.
+			*/
+			static bool				hasGeneratedIncludeChanged(CachedFileParsingResult const& cachedParsingResult)		noexcept;
+
+			/**
+			*	@brief	Check whether parsing a file might produce any entity, without parsing it.
+			*			A file can't produce any entity if it doesn't contain any property macro name
+			*			and no shouldParseAll[EntityType] setting parses non-annotated file level entities.
+			*	
+			*	@param file					File to check.
+			*	@param parsingSettings		Settings used to parse the file.
+			*	@param unsavedFileOverlay	In-memory contents overriding files on disk. Can be nullptr.
+			*
+			*	@return true if parsing the file might produce any entity, else false.
+			*/
+			static bool				mightContainEntities(fs::path const&			file,
+														 ParsingSettings const&		parsingSettings,
+														 UnsavedFileOverlay const*	unsavedFileOverlay)				noexcept;
+
+			/**
+			*	@brief Find the <> includes shared by at least half of the provided files (and at least 2 of them).
+			*	
+			*	@param files Files to scan.
+			*
+			*	@return The common includes, as written between the <> of the #include directives, sorted alphabetically.
+			*/
+			static std::vector<std::string>	detectCommonIncludes(std::set<fs::path> const& files)			noexcept;
+
+			/**
+			*	@brief	Build the precompiled header used to parse files in the state directory, or reuse the one built by a previous run
+			*			if its includes, the compilation arguments and all included files are unchanged.
+			*			On success, the precompiled header is set in the file parser settings.
+			*	
+			*	@param fileParser		File parser used to build the precompiled header. Its settings must have been initialized.
+			*	@param files			Files to process, used to detect common includes if none are configured.
+			*	@param stateDirectory	Directory in which the precompiled header is built.
+			*/
+			void					preparePrecompiledHeader(FileParser&				fileParser,
+															 std::set<fs::path> const&	files,
+															 fs::path const&			stateDirectory)			const	noexcept;
+
 			/**
 			*	@brief Generate / update the entity macros file.
 			*	
@@ -86,6 +474,55 @@ namespace kodgen
 			bool					checkGenerationSetup(FileParser const&	fileParser,
 														 CodeGenUnit const& codeGenUnit)						noexcept;
 
+			/**
+			*	@brief Check that no output directory is shared by several generation units.
+			* 
+			*	@param outputDirectories Output directory of each generation unit.
+			* 
+			*	@return true if all output directories are different, else false.
+			*/
+			bool					checkOutputDirectories(std::vector<fs::path> const& outputDirectories)	const	noexcept;
+
+			/**
+			*	@brief	Wait until all the generated files handed to a writer are written, and mark the generations of the files
+			*			whose generated files could not be written as failed, so that they are processed again by the next run.
+			* 
+			*	@param writer						Writer the generated files were handed to.
+			*	@param processedFiles				Processed files, in submission order.
+			*	@param inout_processedFilesStates	Generation status of each file, indexed like processedFiles.
+			* 
+			*	@return false if any generated file could not be written, else true.
+			*/
+			bool					flushGeneratedFiles(GeneratedFileWriter&			writer,
+														std::vector<fs::path> const&	processedFiles,
+														std::vector<ProcessedFile>&		inout_processedFilesStates)		const	noexcept;
+
+			/**
+			*	@brief	Get the directory containing the files a generation unit keeps between runs, and create it if needed.
+			*			It is the output directory of the generation unit if no state directory is set in the settings.
+			* 
+			*	@param outputDirectory Output directory of the generation unit.
+			* 
+			*	@return The state directory of the generation unit.
+			*/
+			fs::path				getStateDirectory(fs::path const& outputDirectory)						const	noexcept;
+
+			/**
+			*	@brief	Update and save the generation manifest and include dependencies of a generation unit
+			*			for the files it generated, if they are used.
+			* 
+			*	@param inout_unitState		State of the generation unit.
+			*	@param codeGenUnitIndex		Index of the generation unit.
+			*	@param stateDirectory		State directory of the generation unit.
+			*	@param processedFiles		Processed files, in submission order.
+			*	@param processedFilesStates	Durations and generation status of each file, indexed like processedFiles.
+			*/
+			void					saveGenerationUnitState(GenerationUnitState&				inout_unitState,
+															size_t								codeGenUnitIndex,
+															fs::path const&						stateDirectory,
+															std::vector<fs::path> const&		processedFiles,
+															std::vector<ProcessedFile> const&	processedFilesStates)	const	noexcept;
+
 		public:
 			/** Logger used to issue logs from the CodeGenManager. */
 			ILogger*				logger		= nullptr;
@@ -97,7 +534,8 @@ namespace kodgen
 			*	@brief Construct a CodeGenManager that will work with the specified number of threads.
 			* 
 			*	@param threadCount	Number of threads to use for file parsing and generation.
-			*							If 0 is provided, the number of concurrent threads supported by the implementation will be used (std::thread::hardware_concurrency(), and 8 if std::thread::hardware_concurrency() returns 0).
+			*							If 0 is provided, the number of concurrent threads supported by the implementation will be used (std::thread::hardware_concurrency(), and 8 if std::thread::hardware_concurrency() returns 0),
+			*							limited to the cgroup v2 CPU quota of the process if any.
 			*							If 1 is provided, all the process will be handled by the main thread.
 			*/
 			CodeGenManager(uint32 threadCount = 0u)	noexcept;
@@ -116,6 +554,26 @@ namespace kodgen
 			CodeGenResult run(FileParserType&	fileParser,
 							  CodeGenUnitType&	codeGenUnit,
 							  bool				forceRegenerateAll	= false)	noexcept;
+
+			/**
+			*	@brief	Same as CodeGenManager::run with a single generation unit, but each file is parsed once for all generation units,
+			*			and its parsing result is provided to the generation of each generation unit the file is outdated for.
+			*			Whether a file is up-to-date is checked for each generation unit, against the files it generates.
+			*			The entity macros file, generation manifest and include dependencies of each generation unit are kept in its
+			*			own output (or state) directory, so generation units must have different output directories. The precompiled header
+			*			and file durations are kept in the state directory of the first generation unit.
+			*
+			*	@param fileParser			Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
+			*	@param codeGenUnits			Generation units used to generate code, typically built with std::tie.
+			*								They must have a clean state when this method is called.
+			*	@param forceRegenerateAll	Ignore the last write time check and reparse / regenerate all files.
+			*
+			*	@return Structure containing file generation report.
+			*/
+			template <typename FileParserType, typename... CodeGenUnitTypes>
+			CodeGenResult run(FileParserType&					fileParser,
+							  std::tuple<CodeGenUnitTypes&...>	codeGenUnits,
+							  bool								forceRegenerateAll	= false)	noexcept;
 	};
 
 	#include "Kodgen/CodeGen/CodeGenManager.inl"
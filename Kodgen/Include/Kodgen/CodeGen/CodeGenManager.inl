@@ -5,114 +5,672 @@
 *	See the LICENSE.md file for full license details.
 */
 
-template <typename FileParserType, typename CodeGenUnitType>
-void CodeGenManager::processFiles(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, std::set<fs::path> const& toProcessFiles, CodeGenResult& out_genResult) noexcept
+
+template <typename FileParserType, typename... CodeGenUnitTypes>
+void CodeGenManager::processFiles(FileParserType& fileParser, std::tuple<CodeGenUnitTypes&...> const& codeGenUnits, std::vector<fs::path> const& outputDirectories, std::vector<fs::path> const& toProcessFiles, std::vector<ProcessedFile>& inout_processedFiles, CodeGenResult& out_genResult) noexcept
 {
-	std::vector<std::shared_ptr<TaskBase>>	generationTasks;
-	uint8									iterationCount = codeGenUnit.getIterationCount();
+	std::vector<std::shared_ptr<TaskBase>>							completionTasks;
+	std::vector<CachedFileParsingResult>							cachedParsingResults(toProcessFiles.size());
+	std::vector<std::unique_ptr<FileParserType>>					workerFileParsers(_threadPool.getWorkerCount());
+	std::tuple<std::vector<std::unique_ptr<CodeGenUnitTypes>>...>	workerCodeGenUnits(std::vector<std::unique_ptr<CodeGenUnitTypes>>(_threadPool.getWorkerCount())...);
+	uint8															iterationCount = getIterationCount(codeGenUnits);
 
-	//Reserve enough space for all tasks
-	generationTasks.reserve(toProcessFiles.size() * iterationCount);
+	std::mutex														genResultMutex;
 
-	//Launch all parsing -> generation processes
-	std::shared_ptr<TaskBase> parsingTask;
-	
-	for (int i = 0; i < iterationCount; i++)
+	//Reserve enough space for the tasks of an iteration
+	completionTasks.reserve(toProcessFiles.size());
+
+	//Files never start their next iteration from a completion task since all files wait for each other
+	auto onIterationCompleted = [&out_genResult, &genResultMutex](FileParsingResult const&, CodeGenResult&& generationResult)
+	{
+		std::lock_guard lock(genResultMutex);
+
+		out_genResult.mergeResult(std::move(generationResult));
+
+		return std::vector<size_t>();
+	};
+
+	auto submitIteration = [](size_t) {};
+
+	for (uint8 i = 0u; i < iterationCount; i++)
 	{
-		//Lock the thread pool until all tasks have been pushed to avoid competing for the tasks mutex
-		_threadPool.setIsRunning(false);
+		//Each file has its own cached parsing result and processed file slots, so tasks never access the same slot concurrently
+		for (size_t fileIndex = 0u; fileIndex < toProcessFiles.size(); fileIndex++)
+		{
+			completionTasks.emplace_back(submitFileIteration(fileParser, workerFileParsers, codeGenUnits, workerCodeGenUnits, outputDirectories, i,
+															 toProcessFiles[fileIndex], cachedParsingResults[fileIndex], inout_processedFiles[fileIndex],
+															 onIterationCompleted, submitIteration));
+		}
+
+		//Wait for this iteration to complete before continuing any further
+		//(an iteration N depends on the iteration N - 1)
+		_threadPool.waitForTasks(completionTasks);
 
-		for (fs::path const& file : toProcessFiles)
+		//Results have been merged by the tasks themselves
+		completionTasks.clear();
+
+		//The next iteration parses the files generated by this one, so they must be on disk.
+		//All generation units share the same writer.
+		if (std::get<0>(codeGenUnits).generatedFileWriter != nullptr && i + 1 < iterationCount)
+		{
+			out_genResult.completed &= flushGeneratedFiles(*std::get<0>(codeGenUnits).generatedFileWriter, toProcessFiles, inout_processedFiles);
+		}
+	}
+}
+
+template <typename FileParserType, typename... CodeGenUnitTypes>
+void CodeGenManager::processFilesPipelined(FileParserType& fileParser, std::tuple<CodeGenUnitTypes&...> const& codeGenUnits, std::vector<fs::path> const& outputDirectories, std::vector<fs::path> const& toProcessFiles, std::vector<ProcessedFile>& inout_processedFiles, CodeGenResult& out_genResult) noexcept
+{
+	std::unordered_map<fs::path, size_t, PathHash>					fileIndices;
+	std::vector<CachedFileParsingResult>							cachedParsingResults(toProcessFiles.size());
+	std::vector<std::unique_ptr<FileParserType>>					workerFileParsers(_threadPool.getWorkerCount());
+	std::tuple<std::vector<std::unique_ptr<CodeGenUnitTypes>>...>	workerCodeGenUnits(std::vector<std::unique_ptr<CodeGenUnitTypes>>(_threadPool.getWorkerCount())...);
+	PipelineState													pipelineState(toProcessFiles.size());
+	uint8															iterationCount = getIterationCount(codeGenUnits);
+
+	for (size_t i = 0u; i < toProcessFiles.size(); i++)
+	{
+		fileIndices.emplace(toProcessFiles[i].lexically_normal(), i);
+	}
+
+	//Submit the next iteration of a file, called again by the completion task for the following iteration
+	std::function<void(size_t)> submitNextIteration = [&](size_t fileIndex)
+	{
+		//The completed iterations count of a file is only modified by the completion task of the file, which is not running
+		uint8 iteration = pipelineState.completedIterationsCount[fileIndex];
+
+		auto onIterationCompleted = [&, fileIndex, iteration](FileParsingResult const& parsingResult, CodeGenResult&& generationResult)
 		{
-			auto parsingTaskLambda = [&fileParser, &file](TaskBase*) -> FileParsingResult
 			{
-				//Copy a parser for this task
-				FileParserType		fileParserCopy = fileParser;
-				FileParsingResult	parsingResult;
+				std::lock_guard lock(pipelineState.mutex);
 
-				fileParserCopy.parse(file, parsingResult);
+				pipelineState.genResult.mergeResult(std::move(generationResult));
+			}
 
-				return parsingResult;
-			};
+			//Includes are only needed if the file runs another iteration
+			std::vector<size_t> processedIncludes;
 
-			auto generationTaskLambda = [&codeGenUnit](TaskBase* parsingTask) -> CodeGenResult
+			if (iteration + 1 < iterationCount)
 			{
-				CodeGenResult out_generationResult;
+				processedIncludes = getProcessedIncludes(parsingResult, fileIndices);
+			}
 
-				//Copy the generation unit model to have a fresh one for this generation unit
-				CodeGenUnitType	generationUnit = codeGenUnit;
+			return completeIteration(pipelineState, fileIndex, iterationCount, processedIncludes);
+		};
 
-				//Get the result of the parsing task
-				FileParsingResult parsingResult = TaskHelper::getDependencyResult<FileParsingResult>(parsingTask, 0u);
+		//Completion tasks merge their own results, so they are only kept alive by the pool until they run
+		submitFileIteration(fileParser, workerFileParsers, codeGenUnits, workerCodeGenUnits, outputDirectories, iteration,
+							toProcessFiles[fileIndex], cachedParsingResults[fileIndex], inout_processedFiles[fileIndex],
+							onIterationCompleted, std::ref(submitNextIteration));
+	};
 
-				//Generate the file if no errors occured during parsing
-				if (parsingResult.errors.empty())
-				{
-					out_generationResult.completed = generationUnit.generateCode(parsingResult);
-				}
+	for (size_t i = 0u; i < toProcessFiles.size(); i++)
+	{
+		submitNextIteration(i);
+	}
+
+	//Tasks of following iterations are submitted by running tasks, so wait for the whole pool
+	_threadPool.joinWorkers();
+
+	out_genResult.mergeResult(std::move(pipelineState.genResult));
+}
+
+template <typename... CodeGenUnitTypes, typename Callable>
+void CodeGenManager::foreachCodeGenUnit(std::tuple<CodeGenUnitTypes&...> const& codeGenUnits, Callable&& callable) noexcept
+{
+	foreachCodeGenUnit(codeGenUnits, std::forward<Callable>(callable), std::index_sequence_for<CodeGenUnitTypes...>());
+}
+
+template <typename... CodeGenUnitTypes, typename Callable, size_t... Indices>
+void CodeGenManager::foreachCodeGenUnit(std::tuple<CodeGenUnitTypes&...> const& codeGenUnits, Callable&& callable, std::index_sequence<Indices...>) noexcept
+{
+	(callable(std::integral_constant<size_t, Indices>(), std::get<Indices>(codeGenUnits)), ...);
+}
+
+template <typename... CodeGenUnitTypes>
+uint8 CodeGenManager::getIterationCount(std::tuple<CodeGenUnitTypes&...> const& codeGenUnits) noexcept
+{
+	uint8 result = 0u;
+
+	foreachCodeGenUnit(codeGenUnits, [&result](auto, CodeGenUnit const& codeGenUnit)
+	{
+		result = std::max(result, codeGenUnit.getIterationCount());
+	});
+
+	return result;
+}
 
-				return out_generationResult;
+template <typename FileParserType, typename... CodeGenUnitTypes, typename OnIterationCompleted, typename SubmitIteration>
+std::shared_ptr<TaskBase> CodeGenManager::submitFileIteration(FileParserType& fileParser, std::vector<std::unique_ptr<FileParserType>>& workerFileParsers, std::tuple<CodeGenUnitTypes&...> const& codeGenUnits,
+															  std::tuple<std::vector<std::unique_ptr<CodeGenUnitTypes>>...>& workerCodeGenUnits, std::vector<fs::path> const& outputDirectories, uint8 iteration,
+															  fs::path const& file, CachedFileParsingResult& inout_cachedParsingResult, ProcessedFile& inout_processedFile,
+															  OnIterationCompleted onIterationCompleted, SubmitIteration submitIteration) noexcept
+{
+	bool canReuseResult	= iteration > 0 && settings.shouldReuseParsingResults;
+	bool shouldParse	= false;
+
+	//A generation unit running fewer iterations than others is done with the file after its last iteration
+	auto shouldGenerate = [&inout_processedFile, iteration](size_t codeGenUnitIndex, CodeGenUnit const& codeGenUnit)
+	{
+		return inout_processedFile.generations[codeGenUnitIndex].shouldGenerate && iteration < codeGenUnit.getIterationCount();
+	};
+
+	foreachCodeGenUnit(codeGenUnits, [&shouldGenerate, &shouldParse](size_t codeGenUnitIndex, CodeGenUnit const& codeGenUnit)
+	{
+		shouldParse |= shouldGenerate(codeGenUnitIndex, codeGenUnit);
+	});
+
+	auto submissionTime = std::chrono::steady_clock::now();
+
+	auto parsingTaskLambda = [this, &fileParser, &workerFileParsers, &outputDirectories, &file, &inout_cachedParsingResult, &inout_processedFile, canReuseResult, shouldParse, submissionTime](TaskBase*) -> bool
+	{
+		inout_processedFile.timings.queueWaitDuration += std::chrono::duration<float>(std::chrono::steady_clock::now() - submissionTime).count();
+
+		bool result = shouldParse && parseFile(fileParser, workerFileParsers, outputDirectories, file, inout_cachedParsingResult, canReuseResult, inout_processedFile);
+
+		inout_processedFile.parsingEndTime = std::chrono::steady_clock::now();
+
+		return result;
+	};
+
+	//The completion task depends on the parsing task first, then on each generation task
+	//For multiple iterations on a same file, the parsing task is submitted once the previous iteration completed
+	std::vector<std::shared_ptr<TaskBase>> dependencies{ _threadPool.submitTask(std::string("Parsing ") + std::to_string(iteration), parsingTaskLambda) };
+
+	//Each generation unit generates code for the file from the same parsing result
+	foreachCodeGenUnit(codeGenUnits, [&](auto codeGenUnitIndex, auto& codeGenUnit)
+	{
+		if (shouldGenerate(codeGenUnitIndex, codeGenUnit))
+		{
+			FileGeneration&	generation				= inout_processedFile.generations[codeGenUnitIndex];
+			auto&			unitWorkerCodeGenUnits	= std::get<decltype(codeGenUnitIndex)::value>(workerCodeGenUnits);
+
+			auto generationTaskLambda = [this, &codeGenUnit, &unitWorkerCodeGenUnits, &inout_cachedParsingResult, &inout_processedFile, &generation](TaskBase*) -> bool
+			{
+				//The parsing task this task depends on has completed, so its end time is visible here
+				generation.queueWaitDuration += std::chrono::duration<float>(std::chrono::steady_clock::now() - inout_processedFile.parsingEndTime).count();
+
+				return generateFile(codeGenUnit, unitWorkerCodeGenUnits, inout_cachedParsingResult, generation);
 			};
 
-			//Add file to the list of parsed files before starting the task to avoid having to synchronize threads
-			out_genResult.parsedFiles.push_back(file);
+			dependencies.emplace_back(_threadPool.submitTask(std::string("Generation ") + std::to_string(iteration), generationTaskLambda, { dependencies[0] }));
+		}
+	});
+
+	size_t	generationTasksCount	= dependencies.size() - 1u;
+	bool	isLastIteration			= iteration + 1 >= getIterationCount(codeGenUnits);
+
+	auto completionTaskLambda = [this, &file, &outputDirectories, &inout_cachedParsingResult, &inout_processedFile, iteration, generationTasksCount, isLastIteration, onIterationCompleted, submitIteration](TaskBase* completionTask) -> void
+	{
+		CodeGenResult out_generationResult;
+
+		//Get the result of the parsing task: true if the file has been parsed during this iteration
+		if (TaskHelper::getDependencyResult<bool>(completionTask, 0u))
+		{
+			out_generationResult.parsedFiles.push_back(file);
+		}
+		//Skipped files are skipped by all iterations, so only report them once
+		else if (iteration == 0u && inout_processedFile.isSkipped && generationTasksCount > 0u)
+		{
+			out_generationResult.skippedFiles.push_back(file);
+		}
 
-			//Parse files
-			//For multiple iterations on a same file, the parsing task depends on the previous generation task for the same file
-			parsingTask = _threadPool.submitTask(std::string("Parsing ") + std::to_string(i), parsingTaskLambda);
+		out_generationResult.completed = true;
 
-			//Generate code
-			generationTasks.emplace_back(_threadPool.submitTask(std::string("Generation ") + std::to_string(i), generationTaskLambda, { parsingTask }));
+		for (size_t i = 1u; i <= generationTasksCount; i++)
+		{
+			out_generationResult.completed &= TaskHelper::getDependencyResult<bool>(completionTask, i);
 		}
 
-		//Wait for this iteration to complete before continuing any further
-		//(an iteration N depends on the iteration N - 1)
-		_threadPool.setIsRunning(true);
-		_threadPool.joinWorkers();
+		//Generated files are rewritten by each run, so only track the other included files
+		if (settings.shouldTrackIncludeDependencies && generationTasksCount > 0u)
+		{
+			updateIncludedFiles(inout_cachedParsingResult.parsingResult, outputDirectories, inout_processedFile);
+		}
+
+		std::vector<size_t> readyFileIndices = onIterationCompleted(inout_cachedParsingResult.parsingResult, std::move(out_generationResult));
+
+		//Release the parsing result as soon as possible if no next iteration reuses it
+		if (!settings.shouldReuseParsingResults || isLastIteration)
+		{
+			inout_cachedParsingResult.parsingResult = FileParsingResult();
+			inout_cachedParsingResult.generatedIncludesHashes.clear();
+		}
+
+		for (size_t readyFileIndex : readyFileIndices)
+		{
+			submitIteration(readyFileIndex);
+		}
+	};
+
+	return _threadPool.submitTask(std::string("Completion ") + std::to_string(iteration), completionTaskLambda, std::move(dependencies));
+}
+
+template <typename T>
+T& CodeGenManager::getTaskInstance(T const& original, std::vector<std::unique_ptr<T>>& inout_workerInstances, std::unique_ptr<T>& out_taskInstance) noexcept
+{
+	if (settings.shouldReuseWorkerInstances)
+	{
+		int32 workerIndex = _threadPool.getCurrentWorkerIndex();
+
+		//Tasks always run on workers
+		assert(workerIndex != -1);
+
+		//A worker instance is only accessed by its own worker, so no synchronization is needed
+		std::unique_ptr<T>& workerInstance = inout_workerInstances[workerIndex];
+
+		if (workerInstance == nullptr)
+		{
+			workerInstance = std::make_unique<T>(original);
+		}
+
+		return *workerInstance;
+	}
+	else
+	{
+		out_taskInstance = std::make_unique<T>(original);
+
+		return *out_taskInstance;
+	}
+}
+
+template <typename FileParserType>
+bool CodeGenManager::parseFile(FileParserType const& fileParser, std::vector<std::unique_ptr<FileParserType>>& workerFileParsers, std::vector<fs::path> const& outputDirectories, fs::path const& file, CachedFileParsingResult& inout_cachedParsingResult, bool canReuseResult, ProcessedFile& inout_processedFile) noexcept
+{
+	//Skip the parsing if no generated file included by this file has been modified by the previous iteration
+	if (canReuseResult && inout_cachedParsingResult.parsingResult.errors.empty() && !hasGeneratedIncludeChanged(inout_cachedParsingResult))
+	{
+		return false;
+	}
+
+	//Files without any entity generate the same code as an empty parsing result, so don't parse them
+	if (settings.shouldSkipFilesWithoutAnnotations && !mightContainEntities(file, fileParser.getSettings(), fileParser.unsavedFileOverlay.get()))
+	{
+		inout_cachedParsingResult.parsingResult				= FileParsingResult();
+		inout_cachedParsingResult.parsingResult.parsedFile	= FilesystemHelpers::sanitizePath(file);
+		inout_cachedParsingResult.generatedIncludesHashes.clear();
+		inout_cachedParsingResult.hasUnknownGeneratedInclude	= false;
+
+		inout_processedFile.isSkipped = true;
+
+		return false;
 	}
 
-	//Merge all generation results together
-	for (std::shared_ptr<TaskBase>& task : generationTasks)
+	//Copy a parser for this task, or use the parser of this worker
+	std::unique_ptr<FileParserType>	fileParserCopy;
+	FileParserType&					taskFileParser = getTaskInstance(fileParser, workerFileParsers, fileParserCopy);
+
+	inout_cachedParsingResult.parsingResult = FileParsingResult();
+	inout_processedFile.isSkipped			= false;
+
+	//Generated includes get the content parsed hashed to detect their rewrites by the following iterations
+	if (settings.shouldReuseParsingResults)
 	{
-		out_genResult.mergeResult(TaskHelper::getResult<CodeGenResult>(task.get()));
+		taskFileParser.hashedIncludeDirectories = outputDirectories;
 	}
+
+	//Translation units are the biggest memory consumers, so only parse as many files at once as the memory budget allows
+	{
+		MemoryBudgetController::Admission admission(_memoryBudgetController.get());
+
+		taskFileParser.parse(file, inout_cachedParsingResult.parsingResult);
+	}
+
+	inout_processedFile.timings.parsingDuration		+= inout_cachedParsingResult.parsingResult.translationUnitParsingDuration;
+	inout_processedFile.timings.extractionDuration	+= inout_cachedParsingResult.parsingResult.entityExtractionDuration;
+
+	if (settings.shouldReuseParsingResults)
+	{
+		refreshGeneratedIncludesHashes(inout_cachedParsingResult, outputDirectories);
+	}
+
+	return true;
+}
+
+template <typename CodeGenUnitType>
+bool CodeGenManager::generateFile(CodeGenUnitType const& codeGenUnit, std::vector<std::unique_ptr<CodeGenUnitType>>& workerCodeGenUnits, CachedFileParsingResult const& cachedParsingResult, FileGeneration& inout_generation) noexcept
+{
+	auto start		= std::chrono::steady_clock::now();
+	bool completed	= false;
+
+	//Copy the generation unit model to have a fresh one for this generation unit, or reset the generation unit of this worker
+	std::unique_ptr<CodeGenUnitType>	codeGenUnitCopy;
+	CodeGenUnitType&					generationUnit = getTaskInstance(codeGenUnit, workerCodeGenUnits, codeGenUnitCopy);
+
+	if (settings.shouldReuseWorkerInstances)
+	{
+		generationUnit.reset();
+	}
+
+	//Generate the file if no errors occured during parsing
+	if (cachedParsingResult.parsingResult.errors.empty())
+	{
+		if (settings.shouldSplitLargeFiles && generationUnit.canGenerateCodeInShards())
+		{
+			completed = generateCodeInShards(codeGenUnit, generationUnit, cachedParsingResult.parsingResult);
+		}
+		else
+		{
+			completed = generationUnit.generateCode(cachedParsingResult.parsingResult);
+		}
+	}
+
+	//Only the last iteration matters since it overwrites the generated files
+	inout_generation.isGenerationSuccessful	= completed;
+	inout_generation.generationDuration		+= std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+	inout_generation.writeDuration			+= generationUnit.getWriteDuration();
+
+	return completed;
+}
+
+template <typename CodeGenUnitType>
+bool CodeGenManager::generateCodeInShards(CodeGenUnitType const& codeGenUnit, CodeGenUnitType& generationUnit, FileParsingResult const& parsingResult) noexcept
+{
+	std::vector<CodeGenUnit::ShardEntity> shardEntities;
+
+	CodeGenUnit::collectShardEntities(parsingResult, shardEntities);
+
+	size_t shardsCount = std::min<size_t>(_threadPool.getWorkerCount(), shardEntities.size() / std::max<size_t>(settings.minEntitiesPerShard, 1u));
+
+	if (shardsCount < 2u)
+	{
+		return generationUnit.generateCode(parsingResult);
+	}
+
+	std::vector<std::unique_ptr<CodeGenUnitType>>	shardUnits(shardsCount);
+	std::vector<uint8>								shardResults(shardsCount, false);
+
+	//Shards are generated by idle workers, or by this thread if none is available
+	_threadPool.parallelFor(shardsCount, [&](size_t shardIndex)
+	{
+		size_t first	= shardEntities.size() * shardIndex / shardsCount;
+		size_t last		= shardEntities.size() * (shardIndex + 1u) / shardsCount;
+
+		shardUnits[shardIndex]		= std::make_unique<CodeGenUnitType>(codeGenUnit);
+		shardResults[shardIndex]	= shardUnits[shardIndex]->generateShardCode(parsingResult, shardEntities, first, last);
+	});
+
+	std::vector<CodeGenUnit*> shardUnitPointers;
+
+	shardUnitPointers.reserve(shardsCount);
+
+	for (std::unique_ptr<CodeGenUnitType>& shardUnit : shardUnits)
+	{
+		shardUnitPointers.push_back(shardUnit.get());
+	}
+
+	//A traversal aborted, or skipping entities across shards, is only reproduced by a traversal of the whole file
+	if (std::find(shardResults.cbegin(), shardResults.cend(), false) != shardResults.cend() ||
+		!CodeGenUnit::canMergeShardCode(shardEntities, shardUnitPointers))
+	{
+		return generationUnit.generateCode(parsingResult);
+	}
+
+	return generationUnit.generateCodeFromShards(parsingResult, shardUnitPointers);
 }
 
 template <typename FileParserType, typename CodeGenUnitType>
 CodeGenResult CodeGenManager::run(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, bool forceRegenerateAll) noexcept
+{
+	return run(fileParser, std::tie(codeGenUnit), forceRegenerateAll);
+}
+
+template <typename FileParserType, typename... CodeGenUnitTypes>
+CodeGenResult CodeGenManager::run(FileParserType& fileParser, std::tuple<CodeGenUnitTypes&...> codeGenUnits, bool forceRegenerateAll) noexcept
 {
 	//Check FileParser validity
 	static_assert(std::is_base_of_v<FileParser, FileParserType>, "fileParser type must be a derived class of kodgen::FileParser.");
 	static_assert(std::is_copy_constructible_v<FileParserType>, "The provided file parser must be copy-constructible.");
 
 	//Check FileGenerationUnit validity
-	static_assert(std::is_base_of_v<CodeGenUnit, CodeGenUnitType>, "codeGenUnit type must be a derived class of kodgen::CodeGenUnit.");
-	static_assert(std::is_copy_constructible_v<CodeGenUnitType>, "The CodeGenUnit you provide must be copy-constructible.");
+	static_assert(sizeof...(CodeGenUnitTypes) > 0u, "At least one CodeGenUnit must be provided.");
+	static_assert((std::is_base_of_v<CodeGenUnit, CodeGenUnitTypes> && ...), "codeGenUnit type must be a derived class of kodgen::CodeGenUnit.");
+	static_assert((std::is_copy_constructible_v<CodeGenUnitTypes> && ...), "The CodeGenUnit you provide must be copy-constructible.");
+
+	CodeGenResult			genResult;
+	bool					isSetupValid = true;
+	std::vector<fs::path>	outputDirectories;
 
-	CodeGenResult genResult;
 	genResult.completed = true;
 
-	if (!checkGenerationSetup(fileParser, codeGenUnit))
+	foreachCodeGenUnit(codeGenUnits, [this, &fileParser, &isSetupValid](size_t, CodeGenUnit const& codeGenUnit)
+	{
+		isSetupValid &= checkGenerationSetup(fileParser, codeGenUnit);
+	});
+
+	if (isSetupValid)
+	{
+		foreachCodeGenUnit(codeGenUnits, [&outputDirectories](size_t, CodeGenUnit const& codeGenUnit)
+		{
+			outputDirectories.push_back(codeGenUnit.getSettings()->getOutputDirectory());
+		});
+
+		isSetupValid = checkOutputDirectories(outputDirectories);
+	}
+
+	if (!isSetupValid)
 	{
 		genResult.completed = false;
 	}
 	else
 	{
 		//Start timer here
-		auto				start			= std::chrono::high_resolution_clock::now();
-		std::set<fs::path>	filesToProcess	= identifyFilesToProcess(codeGenUnit, genResult, forceRegenerateAll);
+		auto													start = std::chrono::high_resolution_clock::now();
+		std::array<GenerationUnitState, sizeof...(CodeGenUnitTypes)>	unitStates;
+		std::set<fs::path>										filesToProcess;
+		std::vector<fs::path>									upToDateFiles;
+		std::vector<fs::path>									stateDirectories;
+
+		for (fs::path const& outputDirectory : outputDirectories)
+		{
+			stateDirectories.push_back(getStateDirectory(outputDirectory));
+		}
+
+		foreachCodeGenUnit(codeGenUnits, [&](size_t codeGenUnitIndex, CodeGenUnit const& codeGenUnit)
+		{
+			GenerationUnitState&	unitState = unitStates[codeGenUnitIndex];
+			CodeGenResult			unitGenResult;
+			auto					loadingStart = std::chrono::steady_clock::now();
+
+			if (settings.shouldUseGenerationManifest)
+			{
+				//A missing manifest or a different fingerprint makes all files outdated
+				unitState.manifest.loadFromFile(stateDirectories[codeGenUnitIndex] / GenerationManifest::filename);
+				unitState.manifest.setFingerprint(computeGenerationFingerprint(fileParser.getSettings(), codeGenUnit));
+			}
+
+			if (settings.shouldTrackIncludeDependencies)
+			{
+				//Files without recorded dependencies are outdated, so a missing graph makes all files outdated
+				unitState.dependencyGraph.loadFromFile(stateDirectories[codeGenUnitIndex] / IncludeDependencyGraph::filename);
+			}
+
+			genResult.upToDateCheckDuration += std::chrono::duration<float>(std::chrono::steady_clock::now() - loadingStart).count();
+
+			unitState.filesToProcess = identifyFilesToProcess(codeGenUnit,
+															  settings.shouldUseGenerationManifest ? &unitState.manifest : nullptr,
+															  settings.shouldTrackIncludeDependencies ? &unitState.dependencyGraph : nullptr,
+															  unitGenResult,
+															  forceRegenerateAll);
+
+			genResult.directoryScanDuration	+= unitGenResult.directoryScanDuration;
+			genResult.upToDateCheckDuration	+= unitGenResult.upToDateCheckDuration;
+
+			//All generation units process the same files, so the up-to-date files of the first one include all up-to-date files
+			if (codeGenUnitIndex == 0u)
+			{
+				upToDateFiles = std::move(unitGenResult.upToDateFiles);
+			}
+
+			filesToProcess.insert(unitState.filesToProcess.cbegin(), unitState.filesToProcess.cend());
+		});
+
+		//A file is only up-to-date if it is up-to-date for all generation units
+		for (fs::path& upToDateFile : upToDateFiles)
+		{
+			if (filesToProcess.find(upToDateFile) == filesToProcess.cend())
+			{
+				genResult.upToDateFiles.push_back(std::move(upToDateFile));
+			}
+		}
 
 		//Don't setup anything if there are no files to generate
 		if (filesToProcess.size() > 0u)
 		{
+			auto settingsInitStart = std::chrono::steady_clock::now();
+
 			//Initialize the parsing settings to setup parser compilation arguments.
 			//parsingSettings can't be nullptr since it has been checked in the checkGenerationSetup call.
 			fileParser.getSettings().init(logger);
 
-			generateMacrosFile(fileParser.getSettings(), codeGenUnit.getSettings()->getOutputDirectory());
+			if (fileParser.getSettings().shouldUsePrecompiledHeader)
+			{
+				preparePrecompiledHeader(fileParser, filesToProcess, stateDirectories[0]);
+			}
+
+			auto macrosFileGenerationStart = std::chrono::steady_clock::now();
+
+			for (fs::path const& outputDirectory : outputDirectories)
+			{
+				generateMacrosFile(fileParser.getSettings(), outputDirectory);
+			}
+
+			genResult.settingsInitDuration			= std::chrono::duration<float>(macrosFileGenerationStart - settingsInitStart).count();
+			genResult.macrosFileGenerationDuration	= std::chrono::duration<float>(std::chrono::steady_clock::now() - macrosFileGenerationStart).count();
+
+			FileDurationHistory			durationHistory;
+			fs::path					durationHistoryPath = stateDirectories[0] / FileDurationHistory::filename;
+			std::vector<fs::path>		orderedFilesToProcess(filesToProcess.cbegin(), filesToProcess.cend());
+			std::vector<ProcessedFile>	processedFiles(orderedFilesToProcess.size());
+
+			//Files are processed in submission order, so submit the most expensive ones first
+			if (settings.shouldProcessLongestFilesFirst)
+			{
+				durationHistory.loadFromFile(durationHistoryPath);
+				orderedFilesToProcess = durationHistory.sortByDecreasingCost(orderedFilesToProcess);
+			}
+
+			//A file is only generated by the generation units it is outdated for
+			for (size_t i = 0u; i < orderedFilesToProcess.size(); i++)
+			{
+				processedFiles[i].generations.resize(unitStates.size());
+
+				for (size_t codeGenUnitIndex = 0u; codeGenUnitIndex < unitStates.size(); codeGenUnitIndex++)
+				{
+					processedFiles[i].generations[codeGenUnitIndex].shouldGenerate = unitStates[codeGenUnitIndex].filesToProcess.count(orderedFilesToProcess[i]) != 0u;
+				}
+			}
+
+			bool requiresIterationBarrier = false;
+
+			foreachCodeGenUnit(codeGenUnits, [&requiresIterationBarrier](size_t, CodeGenUnit const& codeGenUnit)
+			{
+				requiresIterationBarrier |= codeGenUnit.requiresIterationBarrier();
+			});
+
+			bool								shouldPipelineIterations	= settings.shouldPipelineIterations && !requiresIterationBarrier;
+			std::unique_ptr<GeneratedFileWriter>	generatedFileWriter;
+
+			//Pipelined iterations parse the files generated for their includes without any barrier to flush the writes
+			if (settings.shouldWriteFilesAsynchronously && (!shouldPipelineIterations || getIterationCount(codeGenUnits) <= 1u))
+			{
+				generatedFileWriter = std::make_unique<GeneratedFileWriter>(std::max<size_t>(settings.generatedFilesQueueDepth, 1u));
+
+				foreachCodeGenUnit(codeGenUnits, [&generatedFileWriter](size_t, CodeGenUnit& codeGenUnit)
+				{
+					codeGenUnit.generatedFileWriter = generatedFileWriter.get();
+				});
+			}
+
+			//Unchanged generated files are only touched to pass the last write time check, which the generation manifest replaces
+			foreachCodeGenUnit(codeGenUnits, [this](size_t, CodeGenUnit& codeGenUnit)
+			{
+				codeGenUnit.shouldTouchUnchangedFiles = !settings.shouldUseGenerationManifest;
+			});
+
+			_memoryBudgetController = createMemoryBudgetController();
 
 			//Start files processing
-			processFiles(fileParser, codeGenUnit, filesToProcess, genResult);
+			if (shouldPipelineIterations)
+			{
+				processFilesPipelined(fileParser, codeGenUnits, outputDirectories, orderedFilesToProcess, processedFiles, genResult);
+			}
+			else
+			{
+				processFiles(fileParser, codeGenUnits, outputDirectories, orderedFilesToProcess, processedFiles, genResult);
+			}
+
+			_memoryBudgetController.reset();
+
+			//All generated files must be written when run returns
+			if (generatedFileWriter != nullptr)
+			{
+				genResult.completed &= flushGeneratedFiles(*generatedFileWriter, orderedFilesToProcess, processedFiles);
+
+				foreachCodeGenUnit(codeGenUnits, [](size_t, CodeGenUnit& codeGenUnit)
+				{
+					codeGenUnit.generatedFileWriter = nullptr;
+				});
+			}
+
+			if (settings.shouldProcessLongestFilesFirst)
+			{
+				for (size_t i = 0u; i < orderedFilesToProcess.size(); i++)
+				{
+					//Time spent waiting for the memory budget depends on the other files, so it is not part of the cost of the file
+					FileDurationHistory::Entry durations;
+					durations.parsingDuration = processedFiles[i].timings.parsingDuration + processedFiles[i].timings.extractionDuration;
+
+					//A file costs the generation of all generation units since it is parsed once for all of them
+					for (FileGeneration const& generation : processedFiles[i].generations)
+					{
+						durations.generationDuration += generation.generationDuration;
+					}
+
+					durationHistory.updateEntry(orderedFilesToProcess[i], durations);
+				}
+
+				if (!durationHistory.saveToFile(durationHistoryPath) && logger != nullptr)
+				{
+					logger->log("Could not save file durations to " + durationHistoryPath.string() + ".", ILogger::ELogSeverity::Warning);
+				}
+			}
+
+			//Gather the timings of each file now that no task can update them anymore
+			genResult.fileTimings.reserve(orderedFilesToProcess.size());
+
+			for (size_t i = 0u; i < orderedFilesToProcess.size(); i++)
+			{
+				CodeGenResult::FileTimings& timings = processedFiles[i].timings;
+
+				timings.file = orderedFilesToProcess[i];
+				timings.generationDurations.reserve(processedFiles[i].generations.size());
+
+				for (FileGeneration const& generation : processedFiles[i].generations)
+				{
+					timings.generationDurations.push_back(generation.generationDuration - generation.writeDuration);
+					timings.writeDuration		+= generation.writeDuration;
+					timings.queueWaitDuration	+= generation.queueWaitDuration;
+				}
+
+				genResult.fileTimings.push_back(std::move(timings));
+			}
+
+			for (size_t codeGenUnitIndex = 0u; codeGenUnitIndex < unitStates.size(); codeGenUnitIndex++)
+			{
+				saveGenerationUnitState(unitStates[codeGenUnitIndex], codeGenUnitIndex, stateDirectories[codeGenUnitIndex], orderedFilesToProcess, processedFiles);
+			}
+		}
+		else
+		{
+			//Nothing was generated, but the states of touched files must be saved so that they are not hashed again on next runs
+			for (size_t codeGenUnitIndex = 0u; codeGenUnitIndex < unitStates.size(); codeGenUnitIndex++)
+			{
+				if (unitStates[codeGenUnitIndex].manifest.hasRefreshedStates() || unitStates[codeGenUnitIndex].dependencyGraph.hasRefreshedStates())
+				{
+					saveGenerationUnitState(unitStates[codeGenUnitIndex], codeGenUnitIndex, stateDirectories[codeGenUnitIndex], {}, {});
+				}
+			}
 		}
 
 		genResult.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() * 0.001f;
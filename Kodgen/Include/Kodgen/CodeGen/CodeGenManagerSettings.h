@@ -9,9 +9,11 @@
 
 #include <unordered_set>
 #include <string>
+#include <functional>	//std::function
 
 #include "Kodgen/Misc/Settings.h"
 #include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
 
 namespace kodgen
 {
@@ -50,6 +52,12 @@ namespace kodgen
 			/** Extensions of files that should be considered for code generation. */
 			std::unordered_set<std::string>			_supportedFileExtensions;
 
+			/**
+			*	Directory containing the files kept between runs (generation manifest, include dependencies, file durations and precompiled header).
+			*	If empty, they are kept in the output directory of each generation unit.
+			*/
+			fs::path								_stateDirectory;
+
 			/** Dirty flag set if _toProcessFiles hasn't been refreshed since last modification. */
 			bool									_toProcessFilesDirtyFlag		= false;
 
@@ -132,7 +140,205 @@ namespace kodgen
 			void			loadIgnoredDirectories(toml::value const&	generationSettings,
 												   ILogger*				logger)					noexcept;
 
+			/**
+			*	@brief Load the shouldReuseParsingResults setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldReuseParsingResults(toml::value const&	generationSettings,
+														  ILogger*				logger)			noexcept;
+
+			/**
+			*	@brief Load the shouldPipelineIterations setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldPipelineIterations(toml::value const&	generationSettings,
+														 ILogger*			logger)				noexcept;
+
+			/**
+			*	@brief Load the shouldProcessLongestFilesFirst setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldProcessLongestFilesFirst(toml::value const&	generationSettings,
+															   ILogger*				logger)		noexcept;
+
+			/**
+			*	@brief Load the shouldUseGenerationManifest setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldUseGenerationManifest(toml::value const&	generationSettings,
+															ILogger*			logger)				noexcept;
+
+			/**
+			*	@brief Load the shouldTrackIncludeDependencies setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldTrackIncludeDependencies(toml::value const&	generationSettings,
+															   ILogger*				logger)				noexcept;
+
+			/**
+			*	@brief Load the shouldSkipFilesWithoutAnnotations setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldSkipFilesWithoutAnnotations(toml::value const&	generationSettings,
+																  ILogger*				logger)				noexcept;
+
+			/**
+			*	@brief Load the shouldReuseWorkerInstances setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldReuseWorkerInstances(toml::value const&	generationSettings,
+													   ILogger*				logger)				noexcept;
+
+			/**
+			*	@brief Load the shouldWriteFilesAsynchronously setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldWriteFilesAsynchronously(toml::value const&	generationSettings,
+														   ILogger*				logger)				noexcept;
+
+			/**
+			*	@brief Load the generatedFilesQueueDepth setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadGeneratedFilesQueueDepth(toml::value const&	generationSettings,
+													 ILogger*			logger)					noexcept;
+
+			/**
+			*	@brief Load the shouldSplitLargeFiles setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldSplitLargeFiles(toml::value const&	generationSettings,
+												  ILogger*				logger)				noexcept;
+
+			/**
+			*	@brief Load the minEntitiesPerShard setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadMinEntitiesPerShard(toml::value const&	generationSettings,
+												ILogger*			logger)					noexcept;
+
+			/**
+			*	@brief Load the memoryBudget setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadMemoryBudget(toml::value const&	generationSettings,
+											 ILogger*			logger)						noexcept;
+
+			/**
+			*	@brief Load the _stateDirectory setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadStateDirectory(toml::value const&	generationSettings,
+											   ILogger*				logger)					noexcept;
+
 		public:
+			/**
+			*	If set to true, the result of the first parsing of a file is kept and reused for all following code generation iterations.
+			*	A file is parsed again only if a generated file it includes has been rewritten with a different content by a previous iteration.
+			*/
+			bool shouldReuseParsingResults = false;
+
+			/**
+			*	If set to true, a file starts its next code generation iteration as soon as its own iteration
+			*	and the iteration of all processed files it includes are completed, instead of waiting for all files.
+			*	All files still wait for each other if a code generator of the unit requires an iteration barrier.
+			*/
+			bool shouldPipelineIterations = false;
+
+			/**
+			*	If set to true, the parsing and generation durations of each file are saved in the state directory,
+			*	and the files which took the longest to process during previous runs are processed first.
+			*	Files which have never been processed are estimated from their size.
+			*/
+			bool shouldProcessLongestFilesFirst = false;
+
+			/**
+			*	If set to true, the content hash of each successfully generated file is saved in the state directory along with
+			*	a fingerprint of the settings, code generators and generator executable. Files are then considered up-to-date
+			*	if their content and the fingerprint didn't change, regardless of last write times.
+			*/
+			bool shouldUseGenerationManifest = false;
+
+			/**
+			*	If set to true, the files included (directly or not) by each generated file are saved in the state directory,
+			*	and a file is regenerated as soon as any of its included files changed, even if the file itself didn't.
+			*/
+			bool shouldTrackIncludeDependencies = false;
+
+			/**
+			*	If set to true, files which don't contain any property macro name are not parsed, and code is generated for them
+			*	as for a file without any entity. Only enable this setting if property macros are never used through other macros.
+			*/
+			bool shouldSkipFilesWithoutAnnotations = false;
+
+			/**
+			*	If set to true, each thread copies the file parser and the generation unit once and reuses them for all the files it processes,
+			*	instead of copying them for each file. Generation units are reset through CodeGenUnit::reset between files, and their modules
+			*	must initialize any per-file state in ICodeGenerator::initialGenerateCode.
+			*/
+			bool shouldReuseWorkerInstances = false;
+
+			/**
+			*	If set to true, generated files are written by a dedicated writer thread instead of the generating threads,
+			*	which hand off the generated content and never wait for the disk unless the write queue is full.
+			*	All files are written when CodeGenManager::run returns. Files are written synchronously when iterations are pipelined
+			*	over more than one iteration, since the next iteration of a file parses the files generated for its includes.
+			*/
+			bool shouldWriteFilesAsynchronously = false;
+
+			/**
+			*	Maximum number of generated files waiting to be written when files are written asynchronously.
+			*	Generating threads wait for the writer thread when the queue is full, which bounds the memory used by pending files.
+			*/
+			uint32 generatedFilesQueueDepth = 64u;
+
+			/**
+			*	If set to true, the code generation of a file containing many entities is split across the thread pool:
+			*	consecutive ranges of entities are generated in parallel, then their generated code is merged in traversal order.
+			*	Each range runs ICodeGenerator::initialGenerateCode on its own generation unit, so code generators must not carry state
+			*	between entities. The file is generated again on a single thread if a code generator stops a traversal prematurely.
+			*/
+			bool shouldSplitLargeFiles = false;
+
+			/**
+			*	Minimum number of entities generated by each thread when the code generation of a file is split.
+			*	Only files with at least twice as many top-level entities (entities of namespaces count as top-level) are split.
+			*/
+			uint32 minEntitiesPerShard = 32u;
+
+			/**
+			*	Memory (in MiB) the process should stay under while parsing files. The number of files parsed at once is adapted
+			*	to the memory used by each parsing, so that fewer files are parsed at once as memory grows.
+			*	If 0, 90% of the cgroup v2 memory limit of the process is used, or parsings are not limited if there is no such limit.
+			*/
+			uint32 memoryBudget = 0u;
+
 			/**
 			*	@brief	Add a file to the list of processed files.
 			*			If the path is invalid, doesn't exist, is not a file, or is already in the list, nothing happens.
@@ -272,6 +478,16 @@ namespace kodgen
 			*/
 			bool isIgnoredDirectory(fs::path const& directory)					noexcept;
 
+			/**
+			*	@brief	Call a visitor on each file to process: each registered file, then each file with a supported extension
+			*			found recursively in registered directories, except ignored files and the content of ignored directories.
+			*			Registered files and directories which don't exist are skipped with a warning.
+			* 
+			*	@param visitor	Visitor called with the path of each file to process.
+			*	@param logger	Optional logger used to issue warnings. Can be nullptr.
+			*/
+			void foreachFileToProcess(std::function<void(fs::path const&)> const&	visitor,
+									  ILogger*										logger)		noexcept;
 
 			/**
 			*	@brief Getter for _toProcessFiles.
@@ -307,5 +523,23 @@ namespace kodgen
 			*	@return _supportedExtensions.
 			*/
 			std::unordered_set<std::string> const&			getSupportedExtensions()	const	noexcept;
+
+			/**
+			*	@brief	Setter for _stateDirectory.
+			*			Each generation unit keeps its files in its own subdirectory of the state directory.
+			*			The directory is created when files are saved if it doesn't exist.
+			*
+			*	@param stateDirectory New state directory path, or an empty path to keep the files in the output directories.
+			*
+			*	@return true if _stateDirectory has been updated, else false.
+			*/
+			bool											setStateDirectory(fs::path stateDirectory)	noexcept;
+
+			/**
+			*	@brief Getter for _stateDirectory.
+			*	
+			*	@return _stateDirectory.
+			*/
+			fs::path const&									getStateDirectory()			const	noexcept;
 	};
 }
\ No newline at end of file
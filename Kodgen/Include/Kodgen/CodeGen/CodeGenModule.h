@@ -9,15 +9,16 @@
 
 #include <string>
 #include <vector>
+#include <type_traits>	//std::is_base_of_v
 
 #include "Kodgen/Misc/ICloneable.h"
 #include "Kodgen/CodeGen/ICodeGenerator.h"
 #include "Kodgen/CodeGen/ETraversalBehaviour.h"
+#include "Kodgen/CodeGen/PropertyCodeGen.h"
 
 namespace kodgen
 {
 	//Forward declaration
-	class	PropertyCodeGen;
 	class	CodeGenEnv;
 	class	EntityInfo;
 
@@ -60,13 +61,25 @@ namespace kodgen
 															  std::string&		inout_result,
 															  void const*		data)										noexcept final override;
 
-		protected:
 			/**
 			*	@brief Add a property code generator to this generation module.
 			* 
+			*	@param propertyCodeGen				PropertyCodeGen to register.
+			*	@param isDispatchedByPropertyName	Can the generator be run on the properties named after it only?
+			*/
+			void	registerPropertyCodeGen(PropertyCodeGen&	propertyCodeGen,
+											bool				isDispatchedByPropertyName)	noexcept;
+
+		protected:
+			/**
+			*	@brief	Add a property code generator to this generation module.
+			*			If PropertyCodeGenType overrides PropertyCodeGen::shouldGenerateCodeForEntity, the generator is run on
+			*			all entities rather than only on the properties named after it.
+			* 
 			*	@param propertyCodeGen PropertyCodeGen to register.
 			*/
-			void	addPropertyCodeGen(PropertyCodeGen& propertyCodeGen)			noexcept;
+			template <typename PropertyCodeGenType>
+			void	addPropertyCodeGen(PropertyCodeGenType& propertyCodeGen)		noexcept;
 
 			/**
 			*	@brief Remove a property code generator from this generation module.
@@ -94,6 +107,11 @@ namespace kodgen
 			*/
 			virtual int32							getGenerationOrder()							const	noexcept override;
 
+			/**
+			*	@return true if any registered property code generator requires an iteration barrier, else false.
+			*/
+			virtual bool							requiresIterationBarrier()						const	noexcept override;
+
 			/**
 			*	@brief Getter for _propertyCodeGenerators field.
 			*
@@ -101,4 +119,6 @@ namespace kodgen
 			*/
 			std::vector<PropertyCodeGen*> const&	getPropertyCodeGenerators()						const	noexcept;
 	};
+
+	#include "Kodgen/CodeGen/CodeGenModule.inl"
 }
\ No newline at end of file
@@ -16,6 +16,30 @@ namespace kodgen
 	class CodeGenResult
 	{
 		public:
+			/**
+			*	Time spent (in seconds) in each phase of the processing of a file, summed over all iterations.
+			*/
+			struct FileTimings
+			{
+				/** Path to the processed file. */
+				fs::path			file;
+
+				/** Time spent by the tasks of the file waiting for a worker once they could run. */
+				float				queueWaitDuration	= 0.0f;
+
+				/** Time spent by libclang to parse the file into a translation unit. */
+				float				parsingDuration		= 0.0f;
+
+				/** Time spent extracting the entities of the file from its translation unit. */
+				float				extractionDuration	= 0.0f;
+
+				/** Time spent by each generation unit to generate code for the file, write excluded, indexed like the generation units. */
+				std::vector<float>	generationDurations;
+
+				/** Time spent by all generation units to write the generated files, or to queue them when files are written asynchronously. */
+				float				writeDuration		= 0.0f;
+			};
+
 			/**
 			*	This boolean is set to true if the whole generation process has been completed successfully,
 			*	and false otherwise. Make sure to check the logs to get some hints about the failure cause.
@@ -28,9 +52,27 @@ namespace kodgen
 			/** List of paths to files that have been parsed and got their metadata regenerated. */
 			std::vector<fs::path>	parsedFiles;
 
+			/** List of paths to files which got their metadata regenerated without being parsed, since they can't contain any entity. */
+			std::vector<fs::path>	skippedFiles;
+
 			/** List of paths to files which metadata are up-to-date. */
 			std::vector<fs::path>	upToDateFiles;
 
+			/** Timings of each parsed or regenerated file. */
+			std::vector<FileTimings>	fileTimings;
+
+			/** Time spent (in seconds) to list the files to process in the directories to process. */
+			float					directoryScanDuration			= 0.0f;
+
+			/** Time spent (in seconds) to check whether listed files are up-to-date, including the loading of the manifests and dependency graphs. */
+			float					upToDateCheckDuration			= 0.0f;
+
+			/** Time spent (in seconds) to initialize the parsing settings, including the preparation of the precompiled header. */
+			float					settingsInitDuration			= 0.0f;
+
+			/** Time spent (in seconds) to generate the entity macros file of each output directory. */
+			float					macrosFileGenerationDuration	= 0.0f;
+
 			/**
 			*	@brief Merge a result to this result.
 			*	
@@ -0,0 +1,150 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <memory>	//std::shared_ptr
+
+#include "Kodgen/CodeGen/CodeGenManager.h"
+#include "Kodgen/CodeGen/CodeGenResult.h"
+#include "Kodgen/Parsing/TranslationUnitCache.h"
+#include "Kodgen/Parsing/UnsavedFileOverlay.h"
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/ILogger.h"
+
+namespace kodgen
+{
+	/**
+	*	Long-running generation server answering generation requests sent through a local (Unix domain) socket.
+	*	Settings are loaded and the compiler is probed once, and translation units are kept alive between requests
+	*	so that changed files are incrementally reparsed. Translation units of files which are not processed anymore
+	*	are disposed after each request.
+	*
+	*	Each connection sends a single request line and receives the response before the connection is closed:
+	*		- "generate": generate code for outdated files. Responds "completed <duration>" or "failed <duration>",
+	*		  followed by one "parsed <file>" line per regenerated file, then one "skipped <file>" line per file regenerated
+	*		  without being parsed since it can't contain any entity.
+	*		- "regenerate": same as generate, but all files are regenerated.
+	*		- "stop": stop the server. Responds "stopped".
+	*
+	*	Local sockets are not supported on Windows yet.
+	*/
+	class CodeGenServer
+	{
+		private:
+			/** Manager used to run the code generation for each request. */
+			CodeGenManager&	_codeGenManager;
+
+			/** Socket listening for requests, or -1 when the server is not listening. */
+			int				_listeningSocket = -1;
+
+			/** Path to the socket file the server is listening to. */
+			fs::path		_socketPath;
+
+			/**
+			*	@brief	Create the socket file and start listening for requests.
+			*			A socket file left by a server which didn't stop properly is replaced.
+			*
+			*	@param socketPath Path to the socket file to create.
+			*
+			*	@return true if the server is listening, else false.
+			*/
+			bool				startListening(fs::path const& socketPath)				noexcept;
+
+			/**
+			*	@brief Stop listening for requests and remove the socket file.
+			*/
+			void				stopListening()											noexcept;
+
+			/**
+			*	@brief Wait for the next request.
+			*
+			*	@param out_clientSocket	Socket of the client which sent the request, or -1 if no request could be received.
+			*	@param out_request		The received request line, without line terminator.
+			*
+			*	@return false if the server can't receive requests anymore, else true.
+			*/
+			bool				receiveRequest(int&			out_clientSocket,
+											   std::string&	out_request)					noexcept;
+
+			/**
+			*	@brief Send the response to a request and close the connection.
+			*
+			*	@param clientSocket	Socket of the client which sent the request.
+			*	@param response		Response to send.
+			*/
+			static void			sendResponse(int				clientSocket,
+											 std::string const&	response)					noexcept;
+
+			/**
+			*	@brief Format the response to a generation request.
+			*
+			*	@param genResult Result of the generation.
+			*
+			*	@return The response to send to the client.
+			*/
+			static std::string	formatResponse(CodeGenResult const& genResult)			noexcept;
+
+			/**
+			*	@brief Dispose the cached translation units of the files which have not been processed by a generation.
+			*
+			*	@param translationUnitCache	Cache to dispose translation units from.
+			*	@param unsavedFileOverlay	Overlay of the file parser, files it contains are parsed from their normalized path. Can be nullptr.
+			*	@param genResult			Result of the generation.
+			*/
+			static void			retainProcessedFiles(TranslationUnitCache&		translationUnitCache,
+													 UnsavedFileOverlay const*	unsavedFileOverlay,
+													 CodeGenResult const&		genResult)			noexcept;
+
+		public:
+			/** Logger used to issue logs from the CodeGenServer. Can be nullptr. */
+			ILogger*	logger							= nullptr;
+
+			/** Capacity of the translation unit cache used by the server if the file parser doesn't have one. */
+			uint32		translationUnitCacheCapacity	= 32u;
+
+			CodeGenServer(CodeGenManager& codeGenManager)	noexcept;
+			CodeGenServer(CodeGenServer const&)				= delete;
+			CodeGenServer(CodeGenServer&&)					= delete;
+			~CodeGenServer()								noexcept;
+
+			/**
+			*	@brief	Answer generation requests until a stop request is received.
+			*			If the file parser doesn't have a translation unit cache, one is used for the lifetime of the server,
+			*			with a capacity of translationUnitCacheCapacity.
+			*
+			*	@param fileParser	Original file parser to use to parse files, see CodeGenManager::run.
+			*	@param codeGenUnit	Generation unit used to generate code, see CodeGenManager::run.
+			*	@param socketPath	Path to the socket file the server listens to.
+			*
+			*	@return true if the server stopped after a stop request, false if it could not listen or receive requests.
+			*/
+			template <typename FileParserType, typename CodeGenUnitType>
+			bool				serve(FileParserType&	fileParser,
+									  CodeGenUnitType&	codeGenUnit,
+									  fs::path const&	socketPath)							noexcept;
+
+			/**
+			*	@brief Send a request to a running server and wait for its response.
+			*
+			*	@param socketPath	Path to the socket file the server listens to.
+			*	@param request		Request to send, without line terminator.
+			*	@param out_response	Response of the server.
+			*
+			*	@return true if the response has been received, else false (for example if no server is listening).
+			*/
+			static bool			sendRequest(fs::path const&		socketPath,
+											std::string const&	request,
+											std::string&		out_response)				noexcept;
+
+			CodeGenServer& operator=(CodeGenServer const&)	= delete;
+			CodeGenServer& operator=(CodeGenServer&&)		= delete;
+	};
+
+	#include "Kodgen/CodeGen/CodeGenServer.inl"
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename FileParserType, typename CodeGenUnitType>
+bool CodeGenServer::serve(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, fs::path const& socketPath) noexcept
+{
+	if (!startListening(socketPath))
+	{
+		return false;
+	}
+
+	//Keep translation units alive between requests
+	std::shared_ptr<TranslationUnitCache> previousTranslationUnitCache = fileParser.translationUnitCache;
+
+	if (fileParser.translationUnitCache == nullptr)
+	{
+		fileParser.translationUnitCache = std::make_shared<TranslationUnitCache>(translationUnitCacheCapacity);
+	}
+
+	bool		isStopRequested	= false;
+	int			clientSocket	= -1;
+	std::string	request;
+
+	while (!isStopRequested && receiveRequest(clientSocket, request))
+	{
+		if (clientSocket == -1)
+		{
+			continue;
+		}
+
+		if (request == "generate" || request == "regenerate")
+		{
+			CodeGenResult genResult = _codeGenManager.run(fileParser, codeGenUnit, request == "regenerate");
+
+			retainProcessedFiles(*fileParser.translationUnitCache, fileParser.unsavedFileOverlay.get(), genResult);
+
+			sendResponse(clientSocket, formatResponse(genResult));
+		}
+		else if (request == "stop")
+		{
+			isStopRequested = true;
+
+			sendResponse(clientSocket, "stopped\n");
+		}
+		else
+		{
+			sendResponse(clientSocket, "error Unknown request: " + request + "\n");
+		}
+	}
+
+	fileParser.translationUnitCache = std::move(previousTranslationUnitCache);
+
+	stopListening();
+
+	return isStopRequested;
+}
\ No newline at end of file
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <vector>
+#include <unordered_map>
+#include <string_view>
 #include <functional>	//std::function
 
 #include "Kodgen/Parsing/ParsingResults/FileParsingResult.h"
@@ -15,6 +17,8 @@
 #include "Kodgen/CodeGen/CodeGenEnv.h"
 #include "Kodgen/CodeGen/CodeGenUnitSettings.h"
 #include "Kodgen/CodeGen/CodeGenModule.h"
+#include "Kodgen/CodeGen/PropertyCodeGen.h"
+#include "Kodgen/CodeGen/GeneratedFileWriter.h"
 #include "Kodgen/Misc/ILogger.h"
 #include "Kodgen/Misc/Filesystem.h"
 #include "Kodgen/Misc/FundamentalTypes.h"
@@ -23,10 +27,70 @@ namespace kodgen
 {
 	class CodeGenUnit
 	{
+		public:
+			/**
+			*	Entity generated by a shard of a file: a namespace alone, or any other entity along with all its nested entities.
+			*	Generating the shard entities of a file in order traverses the same entities in the same order as a traversal of the file.
+			*/
+			struct ShardEntity
+			{
+				/** The entity. */
+				EntityInfo const*	entity;
+
+				/** Mask of the types of all the outer entities of the entity. */
+				EEntityType			outerEntityTypes;
+
+				/** Index following the last shard entity nested in the entity. Only namespaces have nested shard entities. */
+				size_t				nestedEntitiesEnd;
+
+				/** Index following the last shard entity of the same kind and the same outer entity as the entity, or nested in it. */
+				size_t				siblingEntitiesEnd;
+			};
+
+		protected:
+			struct PropertyOccurrence
+			{
+				/** Entity the property is attached to. */
+				EntityInfo const*	entity;
+
+				/** Index of the property in the entity's propertyGroup. */
+				uint8				propertyIndex;
+
+				/** Mask of the types of all the outer entities of the entity. */
+				EEntityType			outerEntityTypes;
+			};
+
+			/** All property occurrences of a file by property name, in traversal order. */
+			using PropertyIndex = std::unordered_map<std::string_view, std::vector<PropertyOccurrence>>;
+
 		private:
+			struct ShardVisit
+			{
+				/** Index of the visited shard entity. */
+				size_t	entityIndex;
+
+				/** Index of the first shard entity visited after this one, the entities in between being skipped by the traversal. */
+				size_t	nextEntityIndex;
+
+				/** Has code been generated for the shard entity or one of its nested entities? */
+				bool	hasGeneratedCode;
+			};
+
+			struct ShardTraversal
+			{
+				/** Is the code generator run through a traversal? Property code generators are run through a property index instead. */
+				bool					isTraversed	= false;
+
+				/** Shard entities visited by the traversal, in order. */
+				std::vector<ShardVisit>	visits;
+			};
+
 			/** Collection of all registered generation modules. */
 			std::vector<CodeGenModule*>	_generationModules;
 
+			/** Traversal of the shard entities by each sorted code generator, filled by CodeGenUnit::generateShardCode. */
+			std::vector<ShardTraversal>	_shardTraversals;
+
 			/** Keep track of either this CodeGenUnit instance was constructed from the copy constructor
 			*	or the copy assignement operator.
 			*/
@@ -122,6 +186,90 @@ namespace kodgen
 																										 CodeGenEnv&,
 																										 void const*)>		visitor)			noexcept;
 
+			/**
+			*	@brief	Execute recursively a visitor function on a shard entity/registered module pair.
+			*			Namespaces are visited alone since their nested entities are shard entities too.
+			* 
+			*	@param codeGenerator	Code generator to run.
+			*	@param shardEntity		Shard entity to iterate on.
+			*	@param env				Generation environment structure.
+			*	@param visitor			Visitor function to execute on all traversed entities.
+			* 
+			*	@return The result of the visitor on the namespace if the shard entity is a namespace,
+			*			else the same as the traversal of the entity.
+			*/
+			ETraversalBehaviour			foreachCodeGenEntityPairInShardEntity(ICodeGenerator&										codeGenerator,
+																			  ShardEntity const&									shardEntity,
+																			  CodeGenEnv&											env,
+																			  std::function<ETraversalBehaviour(ICodeGenerator&,
+																												EntityInfo const&,
+																												CodeGenEnv&,
+																												void const*)>		visitor)		noexcept;
+
+			/**
+			*	@brief Add the properties of an entity to a property index.
+			* 
+			*	@param entity			Entity to index the properties of.
+			*	@param outerEntityTypes	Mask of the types of all the outer entities of the entity.
+			*	@param out_index		Index to fill.
+			*/
+			static void					indexProperties(EntityInfo const&	entity,
+														EEntityType			outerEntityTypes,
+														PropertyIndex&		out_index)															noexcept;
+
+			/**
+			*	@brief Index the properties of a namespace and all its nested entities, in traversal order.
+			* 
+			*	@param namespace_		Namespace to index.
+			*	@param outerEntityTypes	Mask of the types of all the outer entities of the namespace.
+			*	@param out_index		Index to fill.
+			*/
+			static void					indexPropertiesInNamespace(NamespaceInfo const&	namespace_,
+																   EEntityType			outerEntityTypes,
+																   PropertyIndex&		out_index)												noexcept;
+
+			/**
+			*	@brief Index the properties of a struct or class and all its nested entities, in traversal order.
+			* 
+			*	@param struct_			Struct/class to index.
+			*	@param outerEntityTypes	Mask of the types of all the outer entities of the struct/class.
+			*	@param out_index		Index to fill.
+			*/
+			static void					indexPropertiesInStruct(StructClassInfo const&	struct_,
+																EEntityType				outerEntityTypes,
+																PropertyIndex&			out_index)												noexcept;
+
+			/**
+			*	@brief Index the properties of an enum and all its enum values, in traversal order.
+			* 
+			*	@param enum_			Enum to index.
+			*	@param outerEntityTypes	Mask of the types of all the outer entities of the enum.
+			*	@param out_index		Index to fill.
+			*/
+			static void					indexPropertiesInEnum(EnumInfo const&	enum_,
+															  EEntityType		outerEntityTypes,
+															  PropertyIndex&	out_index)														noexcept;
+
+			/**
+			*	@brief	Execute a visitor function on each entity/property pair a property code generator runs on, using a property index
+			*			instead of traversing all entities. Pairs are visited in the same order as a traversal would.
+			* 
+			*	@param propertyCodeGen	Property code generator to run.
+			*	@param propertyIndex	Index of all the properties of the file.
+			*	@param env				Generation environment structure.
+			*	@param visitor			Visitor function to execute on all entity/property pairs.
+			* 
+			*	@return ETraversalBehaviour::Recurse if the traversal completed successfully.
+			*			ETraversalBehaviour::AbortWithFailure if the traversal was aborted prematurely with an error.
+			*/
+			ETraversalBehaviour			foreachPropertyCodeGenEntityPair(PropertyCodeGen&									propertyCodeGen,
+																		 PropertyIndex const&								propertyIndex,
+																		 CodeGenEnv&										env,
+																		 std::function<ETraversalBehaviour(ICodeGenerator&,
+																										   EntityInfo const&,
+																										   CodeGenEnv&,
+																										   void const*)>	visitor)			noexcept;
+
 			/**
 			*	@brief Call ICodeGenerator::initialGenerateCode on all provided code generators.
 			* 
@@ -161,7 +309,10 @@ namespace kodgen
 
 		protected:
 			/** Settings used for code generation. */
-			CodeGenUnitSettings const*	settings = nullptr;
+			CodeGenUnitSettings const*	settings		= nullptr;
+
+			/** Time spent (in seconds) in the postGenerateCode step of the last code generation. */
+			float						writeDuration	= 0.0f;
 
 			/**
 			*	@brief	Execute the codeGenModule->generateCode method with the given entity and environment.
@@ -254,9 +405,151 @@ namespace kodgen
 			*/
 			std::vector<ICodeGenerator*>	getSortedCodeGenerators()										const	noexcept;
 
+			/**
+			*	@brief Index all the properties of a parsed file, in traversal order.
+			* 
+			*	@param parsingResult	Result of the file parsing.
+			*	@param out_index		Index to fill.
+			*/
+			static void						buildPropertyIndex(FileParsingResult const&	parsingResult,
+															   PropertyIndex&			out_index)						noexcept;
+
+			/**
+			*	@brief Index all the properties of a range of shard entities, in traversal order.
+			* 
+			*	@param shardEntities	Shard entities of the file.
+			*	@param first			Index of the first shard entity of the range.
+			*	@param last				Index following the last shard entity of the range.
+			*	@param out_index		Index to fill.
+			*/
+			static void						buildPropertyIndex(std::vector<ShardEntity> const&	shardEntities,
+															   size_t							first,
+															   size_t							last,
+															   PropertyIndex&					out_index)				noexcept;
+
+			/**
+			*	@brief	Called by CodeGenUnit::generateShardCode once all code generators generated their initial code,
+			*			then once each code generator generated the code of the shard entities, in generation order.
+			*			The code generated since the previous call must be kept apart so that mergeShardCode can merge it.
+			*			The default implementation does nothing.
+			*/
+			virtual void					completeShardStep()														noexcept;
+
+			/**
+			*	@brief	Get the size of all the code generated by this unit since the beginning of the current generation.
+			*			Used to check whether code has been generated for an entity, so units which can generate code in shards
+			*			must override it. The default implementation returns 0.
+			* 
+			*	@return The size of all the code generated by this unit.
+			*/
+			virtual size_t					getGeneratedCodeSize()											const	noexcept;
+
+			/**
+			*	@brief	Merge the code generated by shard units by CodeGenUnit::generateShardCode into this unit,
+			*			as if this unit had generated the code of all their shard entities.
+			*			The initial code generated by shard units must be dropped since this unit generates its own.
+			*			The default implementation does nothing.
+			* 
+			*	@param shardUnits Units which generated the code of consecutive ranges of shard entities, in order.
+			*/
+			virtual void					mergeShardCode(std::vector<CodeGenUnit*> const& shardUnits)				noexcept;
+
+			/**
+			*	@brief	Execute a visitor on all parsed entities, in the same order and with the same traversal rules as the visitors
+			*			run on each code generator. The visitor type is known at compile time, so the whole traversal can be inlined.
+			* 
+			*	@param parsingResult	Result of the file parsing.
+			*	@param visitor			Callable taking an EntityInfo const& and returning an ETraversalBehaviour.
+			* 
+			*	@return ETraversalBehaviour::Recurse if the traversal completed successfully.
+			*			ETraversalBehaviour::AbortWithSuccess if the traversal was aborted prematurely without error.
+			*			ETraversalBehaviour::AbortWithFailure if the traversal was aborted prematurely with an error.
+			*/
+			template <typename Visitor>
+			static ETraversalBehaviour		foreachEntity(FileParsingResult const&	parsingResult,
+														  Visitor&					visitor)										noexcept;
+
+			/**
+			*	@brief Execute a visitor on a namespace and all its nested entities.
+			* 
+			*	@param namespace_	Namespace to iterate on.
+			*	@param visitor		Callable taking an EntityInfo const& and returning an ETraversalBehaviour.
+			* 
+			*	@return Same as CodeGenUnit::foreachEntity.
+			*/
+			template <typename Visitor>
+			static ETraversalBehaviour		foreachEntityInNamespace(NamespaceInfo const&	namespace_,
+																	 Visitor&				visitor)								noexcept;
+
+			/**
+			*	@brief Execute a visitor on a struct or class and all its nested entities.
+			* 
+			*	@param struct_	Struct/class to iterate on.
+			*	@param visitor	Callable taking an EntityInfo const& and returning an ETraversalBehaviour.
+			* 
+			*	@return Same as CodeGenUnit::foreachEntity.
+			*/
+			template <typename Visitor>
+			static ETraversalBehaviour		foreachEntityInStruct(StructClassInfo const&	struct_,
+																  Visitor&					visitor)								noexcept;
+
+			/**
+			*	@brief Execute a visitor on an enum and all its enum values.
+			* 
+			*	@param enum_	Enum to iterate on.
+			*	@param visitor	Callable taking an EntityInfo const& and returning an ETraversalBehaviour.
+			* 
+			*	@return Same as CodeGenUnit::foreachEntity.
+			*/
+			template <typename Visitor>
+			static ETraversalBehaviour		foreachEntityInEnum(EnumInfo const&	enum_,
+																Visitor&		visitor)											noexcept;
+
+			/**
+			*	@brief Execute a visitor on each entity/property pair a property code generator runs on, using a property index.
+			* 
+			*	@param propertyCodeGen	Property code generator to run.
+			*	@param propertyIndex	Index of all the properties of the file.
+			*	@param visitor			Callable taking an EntityInfo const&, a Property const& and the uint8 property index,
+			*							and returning false to abort the traversal with a failure.
+			* 
+			*	@return ETraversalBehaviour::Recurse if the traversal completed successfully.
+			*			ETraversalBehaviour::AbortWithFailure if the visitor returned false.
+			*/
+			template <typename Visitor>
+			static ETraversalBehaviour		foreachPropertyOccurrence(PropertyCodeGen const&	propertyCodeGen,
+																	  PropertyIndex const&		propertyIndex,
+																	  Visitor&					visitor)							noexcept;
+
+			/**
+			*	@brief	Execute a visitor on each entity/property pair a property code generator runs on, traversing all the entities of a file.
+			*			Used for the property code generators which are not dispatched by property name.
+			* 
+			*	@param propertyCodeGen	Property code generator to run.
+			*	@param parsingResult	Result of the file parsing.
+			*	@param visitor			Callable taking an EntityInfo const&, a Property const& and the uint8 property index,
+			*							and returning false to abort the traversal with a failure.
+			* 
+			*	@return ETraversalBehaviour::Recurse if the traversal completed successfully.
+			*			ETraversalBehaviour::AbortWithFailure if the visitor returned false.
+			*/
+			template <typename Visitor>
+			static ETraversalBehaviour		foreachPropertyOccurrence(PropertyCodeGen const&	propertyCodeGen,
+																	  FileParsingResult const&	parsingResult,
+																	  Visitor&					visitor)							noexcept;
+
 		public:
 			/** Logger used to issue logs from this CodeGenUnit. */
-			ILogger*	logger	= nullptr;
+			ILogger*				logger				= nullptr;
+
+			/** Writer generated files are handed to. If nullptr, generated files are written by the generating thread. */
+			GeneratedFileWriter*	generatedFileWriter	= nullptr;
+
+			/**
+			*	Should generated files whose content didn't change get a newer last write time than their source file?
+			*	Only files checked with last write times need it, so CodeGenManager disables it when a generation manifest is used.
+			*/
+			bool					shouldTouchUnchangedFiles	= true;
 
 			CodeGenUnit()					= default;
 			CodeGenUnit(CodeGenUnit const&)	noexcept;
@@ -272,6 +565,25 @@ namespace kodgen
 			*/
 			virtual bool				isUpToDate(fs::path const& sourceFile)			const	noexcept = 0;
 
+			/**
+			*	@brief	Check whether all the files generated for a given source file exist, regardless of their last write time.
+			*			Used with a generation manifest, where content hashes replace last write times to detect changes.
+			*			The default implementation conservatively falls back to isUpToDate.
+			* 
+			*	@param sourceFile Path to the source file.
+			*
+			*	@return true if all the files generated for sourceFile exist, else false.
+			*/
+			virtual bool				hasGeneratedFiles(fs::path const& sourceFile)	const	noexcept;
+
+			/**
+			*	@brief	Compute a fingerprint of everything in this unit affecting the generated code:
+			*			settings and registered code generators along with their generation order and iteration count.
+			* 
+			*	@return The fingerprint of this unit.
+			*/
+			virtual uint64				computeFingerprint()							const	noexcept;
+
 			/**
 			*	@brief	Check whether all settings are setup correctly for this unit to work.
 			*			If output directory path is valid but doesn't exist yet, it is created.
@@ -282,6 +594,14 @@ namespace kodgen
 			*/
 			virtual bool				checkSettings()									const	noexcept;
 
+			/**
+			*	@brief	Reset the state left by a previous generateCode call, so that this unit generates code for another file
+			*			exactly as a fresh copy of the original unit would. Registered modules are not cloned again, so they must
+			*			initialize any per-file state in ICodeGenerator::initialGenerateCode.
+			*			Called by the CodeGenManager before each file when it reuses generation units between files.
+			*/
+			virtual void				reset()													noexcept;
+
 			/**
 			*	@brief	Calls preGenerateCode, foreachModuleEntityPair, and postGenerateCode in that order.
 			*			If any of the previously mentioned method returns false, the generation aborts (next methods
@@ -295,6 +615,68 @@ namespace kodgen
 			*/
 			bool						generateCode(FileParsingResult const& parsingResult)	noexcept;
 
+			/**
+			*	@brief	Check whether this unit can generate the code of a file in shards through CodeGenUnit::generateShardCode
+			*			and CodeGenUnit::generateCodeFromShards. The default implementation returns false.
+			* 
+			*	@return true if this unit can generate the code of a file in shards, else false.
+			*/
+			virtual bool				canGenerateCodeInShards()						const	noexcept;
+
+			/**
+			*	@brief Collect the shard entities of a parsed file, in traversal order.
+			* 
+			*	@param parsingResult	Result of the file parsing.
+			*	@param out_entities		Collection to fill.
+			*/
+			static void					collectShardEntities(FileParsingResult const&	parsingResult,
+															 std::vector<ShardEntity>&	out_entities)			noexcept;
+
+			/**
+			*	@brief	Check whether the traversals of the shard entities by shard units are the same as a traversal of the whole file.
+			*			A traversal can skip the following entities of a shard (ETraversalBehaviour::Break on an entity, or anything but
+			*			ETraversalBehaviour::Recurse on a namespace), which the following shards can't know while they generate code.
+			*			Entities visited by a shard but skipped by the whole file traversal are fine as long as no code was generated for them.
+			* 
+			*	@param shardEntities	Shard entities of the file, as collected by CodeGenUnit::collectShardEntities.
+			*	@param shardUnits		Units for which CodeGenUnit::generateShardCode succeeded on consecutive ranges covering
+			*							all the shard entities of the file, in order.
+			* 
+			*	@return true if the code generated by the shard units can be merged, else false.
+			*/
+			static bool					canMergeShardCode(std::vector<ShardEntity> const&	shardEntities,
+														  std::vector<CodeGenUnit*> const&	shardUnits)			noexcept;
+
+			/**
+			*	@brief	Generate the code of a range of shard entities of a file, to be merged by another unit through
+			*			CodeGenUnit::generateCodeFromShards. Generated files are not written.
+			*			Code generators run their initial code as for a whole file, but not their final code.
+			* 
+			*	@param parsingResult	Result of the file parsing.
+			*	@param shardEntities	Shard entities of the file, as collected by CodeGenUnit::collectShardEntities.
+			*	@param first			Index of the first shard entity of the range.
+			*	@param last				Index following the last shard entity of the range.
+			* 
+			*	@return	false if the pre-generation step failed or if a traversal has been aborted, in which case the file must be generated
+			*			with CodeGenUnit::generateCode instead, else true.
+			*/
+			bool						generateShardCode(FileParsingResult const&			parsingResult,
+														  std::vector<ShardEntity> const&	shardEntities,
+														  size_t							first,
+														  size_t							last)				noexcept;
+
+			/**
+			*	@brief	Same as CodeGenUnit::generateCode, but the code of all entities is merged from shard units
+			*			instead of being generated by this unit.
+			* 
+			*	@param parsingResult	Result of a file parsing used to generate code.
+			*	@param shardUnits		Units for which CodeGenUnit::canMergeShardCode returned true.
+			* 
+			*	@return true if preGenerateCode and postGenerateCode calls have succeeded, else false.
+			*/
+			bool						generateCodeFromShards(FileParsingResult const&			parsingResult,
+															   std::vector<CodeGenUnit*> const&	shardUnits)			noexcept;
+
 			/**
 			*	@brief Add a module to the internal list of generation modules.
 			* 
@@ -323,6 +705,19 @@ namespace kodgen
 			*/
 			uint8								getIterationCount()						const	noexcept;
 
+			/**
+			*	@brief	Check whether any registered module requires all files to complete an iteration before any file starts the next one.
+			*/
+			bool								requiresIterationBarrier()				const	noexcept;
+
+			/**
+			*	@brief	Get the time spent (in seconds) in the postGenerateCode step of the last code generation,
+			*			where generated files are written, or queued when a generatedFileWriter is set.
+			* 
+			*	@return The write duration of the last code generation, or 0 if it didn't reach the postGenerateCode step.
+			*/
+			float								getWriteDuration()						const	noexcept;
+
 			/**
 			*	@brief Getter for _generationModules field.
 			* 
@@ -333,4 +728,6 @@ namespace kodgen
 			CodeGenUnit&	operator=(CodeGenUnit const&)	noexcept;
 			CodeGenUnit&	operator=(CodeGenUnit&&)		= default;
 	};
+
+	#include "Kodgen/CodeGen/CodeGenUnit.inl"
 }
\ No newline at end of file
@@ -0,0 +1,240 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#define HANDLE_NESTED_ENTITY_ITERATION_RESULT(result)																\
+	if (result == ETraversalBehaviour::Break)																		\
+	{																												\
+		break;																										\
+	}																												\
+	else if (result == ETraversalBehaviour::AbortWithFailure || result == ETraversalBehaviour::AbortWithSuccess)	\
+	{																												\
+		return result;																								\
+	}
+
+template <typename Visitor>
+ETraversalBehaviour CodeGenUnit::foreachEntity(FileParsingResult const& parsingResult, Visitor& visitor) noexcept
+{
+	ETraversalBehaviour result;
+
+	for (NamespaceInfo const& namespace_ : parsingResult.namespaces)
+	{
+		result = foreachEntityInNamespace(namespace_, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (StructClassInfo const& struct_ : parsingResult.structs)
+	{
+		result = foreachEntityInStruct(struct_, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (StructClassInfo const& class_ : parsingResult.classes)
+	{
+		result = foreachEntityInStruct(class_, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (EnumInfo const& enum_ : parsingResult.enums)
+	{
+		result = foreachEntityInEnum(enum_, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (VariableInfo const& variable : parsingResult.variables)
+	{
+		result = visitor(static_cast<EntityInfo const&>(variable));
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (FunctionInfo const& function : parsingResult.functions)
+	{
+		result = visitor(static_cast<EntityInfo const&>(function));
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	return ETraversalBehaviour::Recurse;
+}
+
+template <typename Visitor>
+ETraversalBehaviour CodeGenUnit::foreachEntityInNamespace(NamespaceInfo const& namespace_, Visitor& visitor) noexcept
+{
+	ETraversalBehaviour result = visitor(static_cast<EntityInfo const&>(namespace_));
+
+	if (result != ETraversalBehaviour::Recurse)
+	{
+		return result;
+	}
+
+	for (NamespaceInfo const& nestedNamespace : namespace_.namespaces)
+	{
+		result = foreachEntityInNamespace(nestedNamespace, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (StructClassInfo const& struct_ : namespace_.structs)
+	{
+		result = foreachEntityInStruct(struct_, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (StructClassInfo const& class_ : namespace_.classes)
+	{
+		result = foreachEntityInStruct(class_, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (EnumInfo const& enum_ : namespace_.enums)
+	{
+		result = foreachEntityInEnum(enum_, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (VariableInfo const& variable : namespace_.variables)
+	{
+		result = visitor(static_cast<EntityInfo const&>(variable));
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (FunctionInfo const& function : namespace_.functions)
+	{
+		result = visitor(static_cast<EntityInfo const&>(function));
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	return ETraversalBehaviour::Recurse;
+}
+
+template <typename Visitor>
+ETraversalBehaviour CodeGenUnit::foreachEntityInStruct(StructClassInfo const& struct_, Visitor& visitor) noexcept
+{
+	ETraversalBehaviour result = visitor(static_cast<EntityInfo const&>(struct_));
+
+	if (result != ETraversalBehaviour::Recurse)
+	{
+		return result;
+	}
+
+	for (std::shared_ptr<NestedStructClassInfo> const& nestedStruct : struct_.nestedStructs)
+	{
+		result = foreachEntityInStruct(*nestedStruct, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (std::shared_ptr<NestedStructClassInfo> const& nestedClass : struct_.nestedClasses)
+	{
+		result = foreachEntityInStruct(*nestedClass, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (NestedEnumInfo const& nestedEnum : struct_.nestedEnums)
+	{
+		result = foreachEntityInEnum(nestedEnum, visitor);
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (FieldInfo const& field : struct_.fields)
+	{
+		result = visitor(static_cast<EntityInfo const&>(field));
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	for (MethodInfo const& method : struct_.methods)
+	{
+		result = visitor(static_cast<EntityInfo const&>(method));
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	return ETraversalBehaviour::Recurse;
+}
+
+template <typename Visitor>
+ETraversalBehaviour CodeGenUnit::foreachEntityInEnum(EnumInfo const& enum_, Visitor& visitor) noexcept
+{
+	ETraversalBehaviour result = visitor(static_cast<EntityInfo const&>(enum_));
+
+	if (result != ETraversalBehaviour::Recurse)
+	{
+		return result;
+	}
+
+	for (EnumValueInfo const& enumValue : enum_.enumValues)
+	{
+		result = visitor(static_cast<EntityInfo const&>(enumValue));
+
+		HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
+	}
+
+	return ETraversalBehaviour::Recurse;
+}
+
+#undef HANDLE_NESTED_ENTITY_ITERATION_RESULT
+
+template <typename Visitor>
+ETraversalBehaviour CodeGenUnit::foreachPropertyOccurrence(PropertyCodeGen const& propertyCodeGen, PropertyIndex const& propertyIndex, Visitor& visitor) noexcept
+{
+	auto it = propertyIndex.find(propertyCodeGen.getPropertyName());
+
+	if (it != propertyIndex.end())
+	{
+		for (PropertyOccurrence const& occurrence : it->second)
+		{
+			EntityInfo const&	entity		= *occurrence.entity;
+			Property const&		property	= entity.properties[occurrence.propertyIndex];
+
+			//Skip entities a traversal would not have reached for this generator
+			if (propertyCodeGen.canReachNestedEntities(occurrence.outerEntityTypes) &&
+				(propertyCodeGen.getEligibleEntityMask() && entity.entityType) &&
+				propertyCodeGen.shouldGenerateCodeForEntity(entity, property, occurrence.propertyIndex) &&
+				!visitor(entity, property, occurrence.propertyIndex))
+			{
+				return ETraversalBehaviour::AbortWithFailure;
+			}
+		}
+	}
+
+	return ETraversalBehaviour::Recurse;
+}
+
+template <typename Visitor>
+ETraversalBehaviour CodeGenUnit::foreachPropertyOccurrence(PropertyCodeGen const& propertyCodeGen, FileParsingResult const& parsingResult, Visitor& visitor) noexcept
+{
+	//Same rules as PropertyCodeGen::callVisitorOnEntity
+	auto entityVisitor = [&propertyCodeGen, &visitor](EntityInfo const& entity)
+	{
+		if (propertyCodeGen.getEligibleEntityMask() && entity.entityType)
+		{
+			for (uint8 i = 0u; i < entity.properties.size(); i++)
+			{
+				if (propertyCodeGen.shouldGenerateCodeForEntity(entity, entity.properties[i], i) && !visitor(entity, entity.properties[i], i))
+				{
+					return ETraversalBehaviour::AbortWithFailure;
+				}
+			}
+		}
+
+		return propertyCodeGen.shouldIterateOnNestedEntities(entity) ? ETraversalBehaviour::Recurse : ETraversalBehaviour::Continue;
+	};
+
+	return (foreachEntity(parsingResult, entityVisitor) == ETraversalBehaviour::AbortWithFailure) ? ETraversalBehaviour::AbortWithFailure : ETraversalBehaviour::Recurse;
+}
\ No newline at end of file
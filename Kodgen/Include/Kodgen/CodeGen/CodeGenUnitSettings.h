@@ -65,5 +65,13 @@ namespace kodgen
 			*	@return _outputDirectory.
 			*/
 			fs::path const&	getOutputDirectory()						const	noexcept;
+
+			/**
+			*	@brief	Compute a fingerprint of all the settings affecting the generated code.
+			*			Overrides must combine their own settings with this base implementation.
+			*
+			*	@return The fingerprint of these settings.
+			*/
+			virtual uint64	computeFingerprint()						const	noexcept;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	/**
+	*	Parsing and generation durations of each processed file, persisted between runs
+	*	so that the most expensive files can be processed first.
+	*/
+	class FileDurationHistory
+	{
+		public:
+			struct Entry
+			{
+				/** Time spent (in seconds) to parse the file during all code generation iterations. */
+				float	parsingDuration		= 0.0f;
+
+				/** Time spent (in seconds) to generate code for the file during all code generation iterations. */
+				float	generationDuration	= 0.0f;
+			};
+
+		private:
+			/** Recorded durations of each file. */
+			std::unordered_map<fs::path, Entry, PathHash>	_entries;
+
+		public:
+			/** Name of the file the history is saved to, in the state directory. */
+			static inline fs::path const filename = "KodgenFileDurations.txt";
+
+			/**
+			*	@brief Load the history from a file, replacing all entries.
+			*
+			*	@param historyFile Path to the history file.
+			*
+			*	@return true if the file could be loaded, else false.
+			*/
+			bool					loadFromFile(fs::path const& historyFile)					noexcept;
+
+			/**
+			*	@brief Save the history to a file. Entries of files which don't exist anymore are discarded.
+			*
+			*	@param historyFile Path to the history file.
+			*
+			*	@return true if the file could be written, else false.
+			*/
+			bool					saveToFile(fs::path const& historyFile)				const	noexcept;
+
+			/**
+			*	@brief Replace the recorded durations of a file.
+			*
+			*	@param file		Processed file.
+			*	@param entry	Durations of the file.
+			*/
+			void					updateEntry(fs::path const&	file,
+												Entry const&	entry)							noexcept;
+
+			/**
+			*	@brief	Sort files from the most to the least expensive to process.
+			*			Files without recorded durations are estimated from their size,
+			*			using the average duration per byte of recorded files.
+			*
+			*	@param files Files to sort.
+			*
+			*	@return The sorted files.
+			*/
+			std::vector<fs::path>	sortByDecreasingCost(std::vector<fs::path> const& files)	const	noexcept;
+	};
+}
\ No newline at end of file
@@ -8,18 +8,66 @@
 #pragma once
 
 #include <string>
-#include <fstream>
 
 #include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/ChunkedBuffer.h"
 
 namespace kodgen
 {
+	//Forward declaration
+	class GeneratedFileWriter;
+
+	/**
+	*	File whose content is built in memory and saved when the GeneratedFile is destroyed, or handed to a GeneratedFileWriter.
+	*	The content is kept in chunks which are written as is, so it is never flattened into a single string.
+	*	The file on disk is only replaced, atomically, if its content changed, so that the files including it are not rebuilt.
+	*/
 	class GeneratedFile
 	{
+		friend GeneratedFileWriter;
+
 		private:
-			fs::path		_path;
-			fs::path		_sourceFilePath;
-			std::ofstream	_streamToFile;
+			fs::path				_path;
+			fs::path				_sourceFilePath;
+			ChunkedBuffer			_content;
+
+			/** Writer the file is handed to when destroyed. If nullptr, the file is saved by the destructor. */
+			GeneratedFileWriter*	_writer;
+
+			/** Should the file be touched if it already has its content and is older than its source file? */
+			bool					_shouldTouchIfUnchanged;
+
+			/** Has the file already been saved or handed to the writer? */
+			bool					_isSaved	= false;
+
+			/**
+			*	@brief	Check whether a file on disk already has some content.
+			*			Sizes are compared first, so the file is only read if both sizes match.
+			*
+			*	@param path		Path to the file.
+			*	@param content	Content to compare with.
+			*
+			*	@return true if the file exists and has the content, else false.
+			*/
+			static bool isContentUnchanged(fs::path const&		path,
+										   ChunkedBuffer const&	content)			noexcept;
+
+			/**
+			*	@brief	Save a generated content to a file, unless the file already has this content.
+			*			The content is written to a temporary file which then replaces the file, so that the file is never partially written.
+			*			If the file already has this content and is older than its source file, its last write time is updated instead.
+			*
+			*	@param path						Path to the generated file.
+			*	@param sourceFilePath			Path to the source file of the generated file. Can be empty, in which case an unchanged file is never touched.
+			*	@param content					Content of the generated file.
+			*	@param shouldTouchIfUnchanged	Should the file be touched if it already has the content and is older than its source file?
+			*
+			*	@return true if the file has the content, else false.
+			*/
+			static bool saveToFile(fs::path const&		path,
+								   fs::path const&		sourceFilePath,
+								   ChunkedBuffer const&	content,
+								   bool					shouldTouchIfUnchanged)	noexcept;
 
 			/**
 			*	@brief Write a single line in the generated file
@@ -50,12 +98,23 @@ namespace kodgen
 
 		public:
 			GeneratedFile()													= delete;
-			GeneratedFile(fs::path&&		generatedFilePath,
-						  fs::path const&	sourceFilePath = fs::path())	noexcept;
+			GeneratedFile(fs::path&&			generatedFilePath,
+						  fs::path const&		sourceFilePath			= fs::path(),
+						  GeneratedFileWriter*	writer					= nullptr,
+						  bool					shouldTouchIfUnchanged	= true)		noexcept;
 			GeneratedFile(GeneratedFile const&)								= delete;
 			GeneratedFile(GeneratedFile&&)									= delete;
 			~GeneratedFile()												noexcept;
 
+			/**
+			*	@brief	Save the file, or hand it to the writer if any. The file is not saved again when destroyed.
+			*			Files are saved by their destructor if this method is never called.
+			*
+			*	@return	false if the file could not be written, else true.
+			*			Files handed to a writer are always reported successful here, and their failures are reported by GeneratedFileWriter::flush.
+			*/
+			bool save()														noexcept;
+
 			/**
 			*	@brief Write a line in the generated file
 			*
@@ -63,6 +122,7 @@ namespace kodgen
 			*/
 			void writeLine(std::string const& line)				noexcept;
 			void writeLine(std::string&& line)					noexcept;
+			void writeLine(ChunkedBuffer&& line)				noexcept;
 
 			/**
 			*	@brief Write multiple lines in the generated file
@@ -89,6 +149,15 @@ namespace kodgen
 			void writeMacro(std::string&&	macroPrototype,
 							Lines&&...		lines)				noexcept;
 
+			/**
+			*	@brief Write a macro in the generated file whose body is already made of \ terminated lines.
+			*
+			*	@param macroPrototype	Full prototype of the macro, for example: "MY_MACRO(arg1, arg2)" or "MY_MACRO2(...)"
+			*	@param body				Body of the macro. Its chunks are moved to the generated file instead of being copied.
+			*/
+			void writeMacro(std::string&&	macroPrototype,
+							ChunkedBuffer&&	body)				noexcept;
+
 			/**
 			*	@brief Define a macro without parameters nor value like #define MY_MACRO
 			*/
@@ -0,0 +1,112 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <condition_variable>
+#include <mutex>
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+#include "Kodgen/Misc/ChunkedBuffer.h"
+
+namespace kodgen
+{
+	/**
+	*	Writer stage saving generated files on dedicated threads, so that generating threads don't wait for the disk.
+	*	Each writer thread takes all the files queued so far at once and saves them in a row.
+	*	All methods can be called from multiple threads at once.
+	*/
+	class GeneratedFileWriter
+	{
+		private:
+			struct PendingFile
+			{
+				/** Path to the generated file. */
+				fs::path		path;
+
+				/** Path to the source file of the generated file. Can be empty. */
+				fs::path		sourceFilePath;
+
+				/** Content of the generated file. */
+				ChunkedBuffer	content;
+
+				/** Should the file be touched if it already has its content and is older than its source file? */
+				bool			shouldTouchIfUnchanged;
+			};
+
+			/** Maximum number of files queued or being written at once. */
+			size_t						_maxPendingFilesCount;
+
+			/** Files waiting to be written. */
+			std::vector<PendingFile>	_pendingFiles;
+
+			/** Number of files taken by writer threads which have not been written yet. */
+			size_t						_writingFilesCount	= 0u;
+
+			/** Source files (or generated files without source file) whose generated file could not be written since the last flush. */
+			std::vector<fs::path>		_failedFiles;
+
+			/** Set to true when the writer is destroyed. */
+			bool						_isStopping			= false;
+
+			/** Mutex used to synchronize accesses to the pending files. */
+			std::mutex					_mutex;
+
+			/** Condition used to notify writer threads that files are pending. */
+			std::condition_variable		_pendingCondition;
+
+			/** Condition used to notify submitting and flushing threads that files have been written. */
+			std::condition_variable		_writtenCondition;
+
+			/** Threads writing the pending files. */
+			std::vector<std::thread>	_writerThreads;
+
+			/**
+			*	@brief Routine run by writer threads.
+			*/
+			void writerRoutine()	noexcept;
+
+		public:
+			/**
+			*	@param maxPendingFilesCount	Maximum number of files queued or being written at once. Must be greater than 0.
+			*	@param writerThreadCount	Number of threads writing the files. Must be greater than 0.
+			*/
+			GeneratedFileWriter(size_t	maxPendingFilesCount	= 64u,
+								uint32	writerThreadCount		= 1u)		noexcept;
+			GeneratedFileWriter(GeneratedFileWriter const&)				= delete;
+			GeneratedFileWriter(GeneratedFileWriter&&)					= delete;
+			~GeneratedFileWriter()										noexcept;
+
+			/**
+			*	@brief	Queue a generated file to be written.
+			*			Wait for some files to be written first if the queue is full.
+			*
+			*	@param path				Path to the generated file.
+			*	@param sourceFilePath	Path to the source file of the generated file. Can be empty.
+			*	@param content			Content of the generated file. Move a buffer in to avoid any copy.
+			*	@param shouldTouchIfUnchanged	Should the file be touched if it already has its content and is older than its source file?
+			*/
+			void					submit(fs::path			path,
+										   fs::path			sourceFilePath,
+										   ChunkedBuffer	content,
+										   bool				shouldTouchIfUnchanged	= true)	noexcept;
+
+			/**
+			*	@brief Wait until all the files submitted so far are written.
+			*
+			*	@return	The source files of the generated files which could not be written since the last flush
+			*			(or the generated files themselves when they have no source file).
+			*/
+			std::vector<fs::path>	flush()														noexcept;
+
+			GeneratedFileWriter& operator=(GeneratedFileWriter const&)	= delete;
+			GeneratedFileWriter& operator=(GeneratedFileWriter&&)		= delete;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <unordered_map>
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Content hash of each source file at the time its code was last successfully generated, persisted between runs
+	*	along with a fingerprint of the generation environment (settings, code generators, generator executable).
+	*	Unlike last write times, content hashes are not invalidated by checkouts or build cache restores.
+	*	The last write time and size of each file are kept too, so that only touched files are hashed again.
+	*/
+	class GenerationManifest
+	{
+		private:
+			struct FileState
+			{
+				/** Content hash of the file. */
+				uint64	hash			= 0u;
+
+				/** Last write time of the file when it was hashed. */
+				int64	lastWriteTime	= 0;
+
+				/** Size of the file when it was hashed. */
+				uint64	size			= 0u;
+			};
+
+			/** Fingerprint of the generation environment the entries were generated with. */
+			uint64												_fingerprint = 0u;
+
+			/** State of each source file when its code was last successfully generated. */
+			std::unordered_map<fs::path, FileState, PathHash>	_generatedFileStates;
+
+			/** State of each outdated source file, computed by checkUpToDate and committed by markGenerated. */
+			std::unordered_map<fs::path, FileState, PathHash>	_outdatedFileStates;
+
+			/** Did checkUpToDate record the new state of touched but unchanged files since the manifest was loaded? */
+			bool												_hasRefreshedStates = false;
+
+		public:
+			/** Name of the file the manifest is saved to, in the state directory. */
+			static inline fs::path const filename = "KodgenManifest.txt";
+
+			/**
+			*	@brief Load the manifest from a file, replacing all entries.
+			*
+			*	@param manifestFile Path to the manifest file.
+			*
+			*	@return true if the file could be loaded, else false.
+			*/
+			bool	loadFromFile(fs::path const& manifestFile)				noexcept;
+
+			/**
+			*	@brief Save the manifest to a file. Entries of files which don't exist anymore are discarded.
+			*
+			*	@param manifestFile Path to the manifest file.
+			*
+			*	@return true if the file could be written, else false.
+			*/
+			bool	saveToFile(fs::path const& manifestFile)		const	noexcept;
+
+			/**
+			*	@brief	Set the fingerprint of the current generation environment.
+			*			If it differs from the loaded fingerprint, all entries are discarded.
+			*
+			*	@param fingerprint Fingerprint of the current generation environment.
+			*/
+			void	setFingerprint(uint64 fingerprint)						noexcept;
+
+			/**
+			*	@brief	Check whether the content of a source file changed since its code was last successfully generated.
+			*			The file is only hashed if its last write time or size changed.
+			*			If its content changed, the current content hash is kept until markGenerated or markOutdated is called for the file.
+			*
+			*	@param sourceFile Path to the source file.
+			*
+			*	@return true if the content of sourceFile didn't change since its last successful generation, else false.
+			*/
+			bool	checkUpToDate(fs::path const& sourceFile)				noexcept;
+
+			/**
+			*	@brief	Check whether checkUpToDate recorded the new state of touched but unchanged files since the manifest was loaded,
+			*			in which case the manifest should be saved even if no file was generated.
+			*
+			*	@return true if some file states were refreshed, else false.
+			*/
+			bool	hasRefreshedStates()							const	noexcept;
+
+			/**
+			*	@brief Record that code was successfully generated for a source file previously reported outdated by checkUpToDate.
+			*
+			*	@param sourceFile Path to the source file.
+			*/
+			void	markGenerated(fs::path const& sourceFile)				noexcept;
+
+			/**
+			*	@brief Discard the entry of a source file so that it is reported outdated by the next checkUpToDate call.
+			*
+			*	@param sourceFile Path to the source file.
+			*/
+			void	markOutdated(fs::path const& sourceFile)				noexcept;
+	};
+}
\ No newline at end of file
@@ -106,6 +106,16 @@ namespace kodgen
 			*/
 			virtual uint8				getIterationCount()															const	noexcept;
 
+			/**
+			*	@brief	When iterations are pipelined, a file starts its next iteration as soon as itself and the processed files it includes
+			*			completed their current iteration. Generators sharing any other state between files must require a barrier
+			*			so that all files complete an iteration before any file starts the next one.
+			*			Default is false.
+			* 
+			*	@return true if all files must complete an iteration before starting the next one, else false.
+			*/
+			virtual bool				requiresIterationBarrier()													const	noexcept;
+
 			ICodeGenerator& operator=(ICodeGenerator const&)	= default;
 			ICodeGenerator& operator=(ICodeGenerator&&)			= default;
 	};
@@ -0,0 +1,144 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Files included (directly or not) by each successfully generated file, persisted between runs
+	*	along with the state of each included file at that time.
+	*	A file must be regenerated as soon as any of its included files changed, even if the file itself didn't.
+	*/
+	class IncludeDependencyGraph
+	{
+		private:
+			struct FileState
+			{
+				/** Last write time of the file, used to avoid hashing files which have not been touched. */
+				int64	lastWriteTime	= 0;
+
+				/** Content hash of the file. */
+				uint64	hash			= 0u;
+			};
+
+			struct Dependency
+			{
+				/** Path to the included file. */
+				fs::path	file;
+
+				/** State of the included file when the dependent file was generated. */
+				FileState	state;
+			};
+
+			struct CurrentFileState
+			{
+				/** Current state of the file. The hash is only valid if isHashComputed is true. */
+				FileState	state;
+
+				/** Has the content hash of the file been computed? */
+				bool		isHashComputed	= false;
+			};
+
+			/** Included files of each generated file. */
+			std::unordered_map<fs::path, std::vector<Dependency>, PathHash>	_dependencies;
+
+			/** Current state of all included files queried so far, so that each file is read at most once. */
+			std::unordered_map<fs::path, CurrentFileState, PathHash>		_currentStates;
+
+			/** Did haveDependenciesChanged record the new state of touched but unchanged included files since the graph was loaded? */
+			bool															_hasRefreshedStates = false;
+
+			/**
+			*	@brief Get the last write time of a file.
+			*
+			*	@param file Path to the file.
+			*
+			*	@return The last write time of the file, or 0 if it could not be retrieved.
+			*/
+			static int64		getLastWriteTime(fs::path const& file)							noexcept;
+
+			/**
+			*	@brief Get the current state of a file, computing its content hash only if required.
+			*
+			*	@param file			Path to the file.
+			*	@param shouldHash	Is the content hash of the file required?
+			*
+			*	@return The current state of the file.
+			*/
+			FileState const&	getCurrentState(fs::path const&	file,
+												bool			shouldHash)						noexcept;
+
+		public:
+			/** Name of the file the graph is saved to, in the state directory. */
+			static inline fs::path const filename = "KodgenIncludeDependencies.txt";
+
+			/**
+			*	@brief	Load the graph from a file, replacing all entries.
+			*			If the file is malformed, no entry is loaded at all.
+			*
+			*	@param graphFile Path to the graph file.
+			*
+			*	@return true if the file could be loaded, else false.
+			*/
+			bool	loadFromFile(fs::path const& graphFile)										noexcept;
+
+			/**
+			*	@brief Save the graph to a file. Entries of files which don't exist anymore are discarded.
+			*
+			*	@param graphFile Path to the graph file.
+			*
+			*	@return true if the file could be written, else false.
+			*/
+			bool	saveToFile(fs::path const& graphFile)								const	noexcept;
+
+			/**
+			*	@brief	Check whether any file included by a file changed since the file was last generated.
+			*			A file without recorded dependencies is considered changed, since its dependencies are unknown.
+			*			Included files which were touched without changing their content get their new last write time recorded.
+			*
+			*	@param file					Path to the file.
+			*	@param shouldCompareContent	Should included files with a different last write time be compared by content?
+			*								If false, any last write time change is a change, as expected by consumers validating
+			*								their inputs with last write times such as precompiled headers.
+			*
+			*	@return true if the file has no recorded dependencies or if any of its included files changed, else false.
+			*/
+			bool	haveDependenciesChanged(fs::path const&	file,
+											bool			shouldCompareContent = true)		noexcept;
+
+			/**
+			*	@brief Replace the recorded dependencies of a file with the current state of the provided included files.
+			*
+			*	@param file				Generated file.
+			*	@param includedFiles	Files included (directly or not) by the file.
+			*/
+			void	updateDependencies(fs::path const&				file,
+									   std::vector<fs::path> const&	includedFiles)				noexcept;
+
+			/**
+			*	@brief	Check whether haveDependenciesChanged recorded the new state of touched but unchanged included files
+			*			since the graph was loaded, in which case the graph should be saved even if no file was generated.
+			*
+			*	@return true if some included file states were refreshed, else false.
+			*/
+			bool	hasRefreshedStates()												const	noexcept;
+
+			/**
+			*	@brief Discard the recorded dependencies of a file so that haveDependenciesChanged returns true for it.
+			*
+			*	@param file Path to the file.
+			*/
+			void	removeDependencies(fs::path const& file)									noexcept;
+	};
+}
\ No newline at end of file
@@ -9,12 +9,12 @@
 
 #include "Kodgen/CodeGen/CodeGenModule.h"
 #include "Kodgen/CodeGen/Macro/MacroCodeGenerator.h"
+#include "Kodgen/CodeGen/Macro/MacroPropertyCodeGen.h"
 
 namespace kodgen
 {
 	//Forward declaration
 	class MacroCodeGenEnv;
-	class MacroPropertyCodeGen;
 
 	/**
 	*	Code generation module used with MacroCodeGenEnv environments.
@@ -114,7 +114,8 @@ namespace kodgen
 			* 
 			*	@param propertyCodeGen PropertyRule to register.
 			*/
-			void						addPropertyCodeGen(MacroPropertyCodeGen& propertyCodeGen)				noexcept;
+			template <typename MacroPropertyCodeGenType>
+			void						addPropertyCodeGen(MacroPropertyCodeGenType& propertyCodeGen)			noexcept;
 
 		public:
 			/**
@@ -164,4 +165,6 @@ namespace kodgen
 			virtual bool				finalGenerateCode(CodeGenEnv&	env,
 														  std::string&	inout_result)			noexcept override final;
 	};
+
+	#include "Kodgen/CodeGen/Macro/MacroCodeGenModule.inl"
 }
\ No newline at end of file
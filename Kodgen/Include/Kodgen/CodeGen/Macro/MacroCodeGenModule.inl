@@ -0,0 +1,14 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename MacroPropertyCodeGenType>
+void MacroCodeGenModule::addPropertyCodeGen(MacroPropertyCodeGenType& propertyCodeGen) noexcept
+{
+	static_assert(std::is_base_of_v<MacroPropertyCodeGen, MacroPropertyCodeGenType>, "MacroPropertyCodeGenType must be a derived class of kodgen::MacroPropertyCodeGen.");
+
+	CodeGenModule::addPropertyCodeGen(propertyCodeGen);
+}
\ No newline at end of file
@@ -10,9 +10,11 @@
 #include <string>
 #include <array>
 #include <unordered_map>
+#include <cassert>
 
 #include "Kodgen/CodeGen/CodeGenUnit.h"
 #include "Kodgen/CodeGen/Macro/MacroCodeGenEnv.h"
+#include "Kodgen/Misc/ChunkedBuffer.h"
 
 namespace kodgen
 {
@@ -23,17 +25,26 @@ namespace kodgen
 	/**
 	*	CodeGenEnv type: MacroCodeGenEnv
 	*/
-	class MacroCodeGenUnit final : public CodeGenUnit
+	class MacroCodeGenUnit : public CodeGenUnit
 	{
 		private:
 			/** Separator used for each code location. */
 			static std::array<std::string, static_cast<size_t>(ECodeGenLocation::Count)> const _separators;
 
 			/** Array containing the generated code per location. ClassFooter value is not used since code is generated in _classFooterGeneratedCode. */
-			std::array<std::string, static_cast<size_t>(ECodeGenLocation::Count)>	_generatedCodePerLocation;
+			std::array<ChunkedBuffer, static_cast<size_t>(ECodeGenLocation::Count)>	_generatedCodePerLocation;
 
 			/** Map containing the class footer generated code for each struct/class. */
-			std::unordered_map<StructClassInfo const*, std::string>					_classFooterGeneratedCode;
+			std::unordered_map<StructClassInfo const*, ChunkedBuffer>				_classFooterGeneratedCode;
+
+			/** Code generated by a single generate call, appended to the code of its location right after the call. */
+			std::string																_generatedCode;
+
+			/** Size of all the code generated since the last reset. */
+			size_t																	_generatedCodeSize	= 0u;
+
+			/** Generated code per location of each shard step when this unit generates the code of a shard, in step order. */
+			std::vector<std::array<ChunkedBuffer, static_cast<size_t>(ECodeGenLocation::Count)>>	_shardGeneratedCode;
 			
 			//Make the addModule method taking a CodeGenModule private to replace it with a more restrictive method accepting MacroCodeGenModule only.
 			using CodeGenUnit::addModule;
@@ -43,27 +54,30 @@ namespace kodgen
 			* 
 			*	@param entity	Entity we generate the code for. Must be one of Struct/Class/Field/Method.
 			*	@param env		Generation environment.
-			*	@param generate	Code generation method.
+			*	@param generate	Code generation callable taking an EntityInfo const&, a MacroCodeGenEnv& and a std::string&.
 			*/
-			void		generateEntityClassFooterCode(EntityInfo const&						entity,
-													  CodeGenEnv&							env,
-													  std::function<void(EntityInfo const&,
-																		 CodeGenEnv&,
-																		 std::string&)>		generate)	noexcept;
+			template <typename Generate>
+			void		generateEntityClassFooterCode(EntityInfo const&	entity,
+													  MacroCodeGenEnv&	env,
+													  Generate&			generate)								noexcept;
 
 			/**
 			*	@brief	(Re)generate the header file.
 			* 
 			*	@param env Generation environment.
+			* 
+			*	@return false if the header file could not be written, else true.
 			*/
-			void		generateHeaderFile(MacroCodeGenEnv&	env)										noexcept;
+			bool		generateHeaderFile(MacroCodeGenEnv&	env)										noexcept;
 
 			/**
 			*	@brief	(Re)generate the source file.
 			* 
 			*	@param env Generation environment.
+			* 
+			*	@return false if the source file could not be written, else true.
 			*/
-			void		generateSourceFile(MacroCodeGenEnv&	env)										noexcept;
+			bool		generateSourceFile(MacroCodeGenEnv&	env)										noexcept;
 
 			/**
 			*	@brief Compute the path of the header file generated from the provided source file.
@@ -84,6 +98,32 @@ namespace kodgen
 			fs::path	getGeneratedSourceFilePath(fs::path const& sourceFile)					const	noexcept;
 
 		protected:
+			/**
+			*	@brief	Call generate once per code location except ECodeGenLocation::ClassFooter with the given environment,
+			*			by updating the environment between each call (MacroCodeGenEnv::codeGenLocation and MacroCodeGenEnv::separator are updated).
+			*			The generate type is known at compile time, so calls can be inlined.
+			* 
+			*	@param env		Generation environment structure.
+			*	@param generate	Code generation callable taking a MacroCodeGenEnv& and a std::string&.
+			*/
+			template <typename Generate>
+			void						generateCodeAtLocations(MacroCodeGenEnv&	env,
+																Generate&			generate)								noexcept;
+
+			/**
+			*	@brief	Call generate once per code location with the given entity and environment,
+			*			by updating the environment between each call (MacroCodeGenEnv::codeGenLocation and MacroCodeGenEnv::separator are updated).
+			*			The generate type is known at compile time, so calls can be inlined.
+			* 
+			*	@param entity	Target entity for code generation.
+			*	@param env		Generation environment structure.
+			*	@param generate	Code generation callable taking an EntityInfo const&, a MacroCodeGenEnv& and a std::string&.
+			*/
+			template <typename Generate>
+			void						generateCodeForEntityAtLocations(EntityInfo const&	entity,
+																		 MacroCodeGenEnv&	env,
+																		 Generate&			generate)						noexcept;
+
 			/**
 			*	@brief	Instantiate a MacroCodeGenEnv object (using new).
 			* 
@@ -149,7 +189,39 @@ namespace kodgen
 			*/
 			virtual bool				postGenerateCode(CodeGenEnv& env)										noexcept	override;
 
+			/**
+			*	@brief Move the code generated at each location since the previous shard step to a new shard step.
+			*/
+			virtual void				completeShardStep()														noexcept	override;
+
+			/**
+			*	@brief	Append the code generated by each code generator in each shard, shard after shard, to each location,
+			*			and take the class footer code of the structs/classes of each shard.
+			* 
+			*	@param shardUnits MacroCodeGenUnits which generated the code of consecutive ranges of shard entities, in order.
+			*/
+			virtual void				mergeShardCode(std::vector<CodeGenUnit*> const& shardUnits)				noexcept	override;
+
+			/**
+			*	@brief Get the size of all the code generated since the last reset.
+			* 
+			*	@return The size of all the generated code.
+			*/
+			virtual size_t				getGeneratedCodeSize()											const	noexcept	override;
+
 		public:
+			/**
+			*	@brief Clear the code generated for the previous file.
+			*/
+			virtual void					reset()												noexcept	override;
+
+			/**
+			*	@brief Check whether this unit can generate the code of a file in shards.
+			* 
+			*	@return true.
+			*/
+			virtual bool					canGenerateCodeInShards()							const	noexcept	override;
+
 			/**
 			*	@brief	Check that both the generated header and source files are newer than the source file.
 			*			If the generated header file doesn't exist, create it and leave it empty.
@@ -162,6 +234,16 @@ namespace kodgen
 			*/
 			virtual bool					isUpToDate(fs::path const& sourceFile)				const	noexcept	override;
 
+			/**
+			*	@brief	Check that both the generated header and source files exist.
+			*			As in isUpToDate, the generated header file is created empty if it doesn't exist.
+			* 
+			*	@param sourceFile Path to the source file.
+			*
+			*	@return true if both generated files exist for sourceFile, else false.
+			*/
+			virtual bool					hasGeneratedFiles(fs::path const& sourceFile)		const	noexcept	override;
+
 			/**
 			*	@brief	Add a module to the internal list of generation modules.
 			*			This method is a more restrictive replacement for the CodeGenUnit::addModule(CodeGenModule&) method.
@@ -182,4 +264,6 @@ namespace kodgen
 			*/
 			void							setSettings(MacroCodeGenUnitSettings const& cguSettings)	noexcept;
 	};
+
+	#include "Kodgen/CodeGen/Macro/MacroCodeGenUnit.inl"
 }
\ No newline at end of file
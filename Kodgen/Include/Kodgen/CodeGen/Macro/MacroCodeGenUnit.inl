@@ -0,0 +1,87 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename Generate>
+void MacroCodeGenUnit::generateEntityClassFooterCode(EntityInfo const& entity, MacroCodeGenEnv& env, Generate& generate) noexcept
+{
+	if (entity.entityType == EEntityType::Struct || entity.entityType == EEntityType::Class)
+	{
+		//If the entity is a struct/class, append to the footer of the struct/class
+		generate(entity, env, _generatedCode);
+		_generatedCodeSize += _generatedCode.size();
+		_classFooterGeneratedCode[&reinterpret_cast<StructClassInfo const&>(entity)].append(std::move(_generatedCode));
+	}
+	else
+	{
+		assert(entity.outerEntity != nullptr);
+		assert(entity.outerEntity->entityType == EEntityType::Struct || entity.outerEntity->entityType == EEntityType::Class);
+
+		//If the entity is NOT a struct/class, append to the footer of the outer struct/class
+		generate(entity, env, _generatedCode);
+		_generatedCodeSize += _generatedCode.size();
+		_classFooterGeneratedCode[reinterpret_cast<StructClassInfo const*>(entity.outerEntity)].append(std::move(_generatedCode));
+	}
+}
+
+template <typename Generate>
+void MacroCodeGenUnit::generateCodeAtLocations(MacroCodeGenEnv& env, Generate& generate) noexcept
+{
+	//Generate code for each code location
+	for (int i = 0u; i < static_cast<int>(ECodeGenLocation::Count); i++)
+	{
+		env._codeGenLocation	= static_cast<ECodeGenLocation>(i);
+		env._separator			= _separators[i];
+
+		/**
+		*	No initial call when the CodeGenLocation is ClassFooter
+		*/
+		if (env._codeGenLocation == ECodeGenLocation::ClassFooter)
+		{
+			continue;
+		}
+		else
+		{
+			generate(env, _generatedCode);
+			_generatedCodeSize += _generatedCode.size();
+			_generatedCodePerLocation[i].append(std::move(_generatedCode));
+		}
+	}
+}
+
+template <typename Generate>
+void MacroCodeGenUnit::generateCodeForEntityAtLocations(EntityInfo const& entity, MacroCodeGenEnv& env, Generate& generate) noexcept
+{
+	//Generate code for each code location
+	for (int i = 0u; i < static_cast<int>(ECodeGenLocation::Count); i++)
+	{
+		env._codeGenLocation	= static_cast<ECodeGenLocation>(i);
+		env._separator			= _separators[i];
+
+		/**
+		*	Forward ECodeGenLocation::ClassFooter generation only if the entity is a
+		*	struct, class, method or field
+		*/
+		if (env._codeGenLocation == ECodeGenLocation::ClassFooter)
+		{
+			if (!(entity.entityType == EEntityType::Struct || entity.entityType == EEntityType::Class ||
+				entity.entityType == EEntityType::Method || entity.entityType == EEntityType::Field))
+			{
+				continue;
+			}
+			else
+			{
+				generateEntityClassFooterCode(entity, env, generate);
+			}
+		}
+		else
+		{
+			generate(entity, env, _generatedCode);
+			_generatedCodeSize += _generatedCode.size();
+			_generatedCodePerLocation[i].append(std::move(_generatedCode));
+		}
+	}
+}
\ No newline at end of file
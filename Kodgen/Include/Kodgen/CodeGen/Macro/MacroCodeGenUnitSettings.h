@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <string>
 #include <string_view>
+#include <vector>
+#include <initializer_list>
 
 #include "Kodgen/CodeGen/CodeGenUnitSettings.h"
 
@@ -19,6 +22,83 @@ namespace kodgen
 	class MacroCodeGenUnitSettings : public CodeGenUnitSettings
 	{
 		private:
+			/**
+			*	Name pattern split once into literal texts and tags, so that it is expanded without searching the tags again.
+			*/
+			class CompiledPattern
+			{
+				public:
+					enum class ESegmentKind : uint8
+					{
+						/** Literal text of the pattern. */
+						Text = 0u,
+
+						/** ##FILENAME## tag. */
+						FileName,
+
+						/** ##CLASSNAME## tag. */
+						ClassName,
+
+						/** ##CLASSFULLNAME## tag. */
+						ClassFullName
+					};
+
+					struct Segment
+					{
+						/** Kind of the segment. */
+						ESegmentKind	kind;
+
+						/** Offset of the literal text in the pattern. Only used by Text segments. */
+						size_t			offset;
+
+						/** Size of the literal text. Only used by Text segments. */
+						size_t			size;
+					};
+
+				private:
+					/** The pattern. */
+					std::string				_pattern;
+
+					/** Segments of the pattern, in order. */
+					std::vector<Segment>	_segments;
+
+				public:
+					CompiledPattern(std::string																pattern,
+									std::initializer_list<std::pair<std::string_view, ESegmentKind>>	tags)	noexcept;
+
+					/**
+					*	@brief Getter for the pattern.
+					*
+					*	@return The pattern.
+					*/
+					std::string const&				getPattern()									const	noexcept;
+
+					/**
+					*	@brief Getter for the segments of the pattern.
+					*
+					*	@return The segments of the pattern, in order.
+					*/
+					std::vector<Segment> const&		getSegments()									const	noexcept;
+
+					/**
+					*	@brief Get the literal text of a Text segment.
+					*
+					*	@param segment A Text segment of this pattern.
+					*
+					*	@return The literal text of the segment.
+					*/
+					std::string_view				getText(Segment const& segment)					const	noexcept;
+
+					/**
+					*	@brief Check whether the pattern contains a tag.
+					*
+					*	@param kind Kind of the tag.
+					*
+					*	@return true if the pattern contains at least one segment of the given kind, else false.
+					*/
+					bool							hasSegment(ESegmentKind kind)					const	noexcept;
+			};
+
 			/**
 			*	Tag usable in _generatedHeaderFileNamePattern and _generatedSourceFileNamePattern.
 			*	All instances of this tag will be replaced by the actual target file name.
@@ -41,25 +121,25 @@ namespace kodgen
 			*	Pattern to use to generate header files.
 			*	##FILENAME## will be replaced by the target file name.
 			*/
-			std::string		_generatedHeaderFileNamePattern	= "##FILENAME##.h.h";
+			CompiledPattern	_generatedHeaderFileNamePattern	= compileFileNamePattern("##FILENAME##.h.h");
 
 			/**
 			*	Pattern to use to generate source files.
 			*	##FILENAME## will be replaced by the target file name.
 			*/
-			std::string		_generatedSourceFileNamePattern	= "##FILENAME##.src.h";
+			CompiledPattern	_generatedSourceFileNamePattern	= compileFileNamePattern("##FILENAME##.src.h");
 
 			/**
 			*	Pattern to use to generate class footer macro.
 			*	##CLASSNAME## and ##CLASSFULLNAME## will be replaced by the class name and full name respectively.
 			*/
-			std::string		_classFooterMacroPattern		= "##CLASSFULLNAME##_GENERATED";
+			CompiledPattern	_classFooterMacroPattern		= compileClassNamePattern("##CLASSFULLNAME##_GENERATED");
 
 			/**
 			*	Pattern to use to generate header file footer macro.
 			*	##FILENAME## will be replaced by the target file name.
 			*/
-			std::string		_headerFileFooterMacroPattern	= "File_##FILENAME##_GENERATED";
+			CompiledPattern	_headerFileFooterMacroPattern	= compileFileNamePattern("File_##FILENAME##_GENERATED");
 
 			/**
 			*	Macro used to export a symbol if the generated code is injected in a dynamic library.
@@ -77,6 +157,48 @@ namespace kodgen
 			*/
 			std::string		_internalSymbolMacroName		= "";
 
+			/**
+			*	@brief Compile a pattern in which ##FILENAME## tags are replaced.
+			*
+			*	@param pattern The pattern to compile.
+			*
+			*	@return The compiled pattern.
+			*/
+			static CompiledPattern	compileFileNamePattern(std::string pattern)						noexcept;
+
+			/**
+			*	@brief Compile a pattern in which ##CLASSNAME## and ##CLASSFULLNAME## tags are replaced.
+			*
+			*	@param pattern The pattern to compile.
+			*
+			*	@return The compiled pattern.
+			*/
+			static CompiledPattern	compileClassNamePattern(std::string pattern)					noexcept;
+
+			/**
+			*	@brief Append the name of a file without its extension to a string, as filename().stem() would return it.
+			*
+			*	@param file		Path to the file.
+			*	@param out_str	String to append the name to.
+			*/
+			static void				appendFileStem(fs::path const&	file,
+												   std::string&		out_str)						noexcept;
+
+			/**
+			*	@brief Append the expansion of a compiled pattern to a string.
+			*
+			*	@param pattern			The pattern to expand.
+			*	@param targetFile		File whose name replaces ##FILENAME## tags. Can be nullptr if the pattern has no such tag.
+			*	@param className		Replacement of ##CLASSNAME## tags.
+			*	@param classFullName	Replacement of ##CLASSFULLNAME## tags, in which :: are replaced by _.
+			*	@param out_str			String to append the expansion to.
+			*/
+			static void				expandPattern(CompiledPattern const&	pattern,
+												  fs::path const*			targetFile,
+												  std::string_view			className,
+												  std::string_view			classFullName,
+												  std::string&				out_str)				noexcept;
+
 		protected:
 			/**
 			*	@brief	Modifies a macro name if necessary to make it a valid C++ macro name.
@@ -88,6 +210,18 @@ namespace kodgen
 			*/
 			static bool		sanitizeMacroName(std::string&	inout_macroName)						noexcept;
 
+			/**
+			*	@brief	Modifies the end of a string if necessary to make it a valid C++ macro name.
+			*			All invalid characters are replaced by the underscore character '_'.
+			* 
+			*	@param inout_str	String ending with the macro name to sanitize.
+			*	@param startIndex	Index of the first character of the macro name in the string.
+			* 
+			*	@return true if the macro was modified my the method, else false.
+			*/
+			static bool		sanitizeMacroName(std::string&	inout_str,
+											  size_t		startIndex)								noexcept;
+
 			/**
 			*	@brief Replace all occurences of tag by replacement in the provided string.
 			* 
@@ -215,6 +349,15 @@ namespace kodgen
 			*/
 			fs::path			getGeneratedHeaderFileName(fs::path const& targetFile)							const	noexcept;
 
+			/**
+			*	@brief Append the header file name generated for the given file to a string, without any intermediate allocation.
+			* 
+			*	@param targetFile		Full path to the target file.
+			*	@param out_fileName		String to append the generated header file name to.
+			*/
+			void				expandGeneratedHeaderFileName(fs::path const&	targetFile,
+															  std::string&		out_fileName)					const	noexcept;
+
 			/**
 			*	@brief Getter for _generatedSourceFileNamePattern.
 			*
@@ -232,6 +375,15 @@ namespace kodgen
 			*/
 			fs::path			getGeneratedSourceFileName(fs::path const& targetFile)							const	noexcept;
 
+			/**
+			*	@brief Append the source file name generated for the given file to a string, without any intermediate allocation.
+			* 
+			*	@param targetFile		Full path to the target file.
+			*	@param out_fileName		String to append the generated source file name to.
+			*/
+			void				expandGeneratedSourceFileName(fs::path const&	targetFile,
+															  std::string&		out_fileName)					const	noexcept;
+
 			/**
 			*	@brief Getter for _classFooterMacroPattern.
 			*
@@ -249,6 +401,17 @@ namespace kodgen
 			*/
 			virtual std::string	getClassFooterMacro(StructClassInfo const& structClassInfo)						const	noexcept;
 
+			/**
+			*	@brief Append the class footer macro of a class to a string, without any intermediate allocation.
+			* 
+			*	@param className		Name of the class.
+			*	@param classFullName	Full name of the class, without template parameters. :: are replaced by _.
+			*	@param out_macro		String to append the class footer macro name to.
+			*/
+			void				expandClassFooterMacro(std::string_view	className,
+													   std::string_view	classFullName,
+													   std::string&		out_macro)								const	noexcept;
+
 			/**
 			*	@brief Getter for _headerFileFooterMacroPattern.
 			*
@@ -266,6 +429,15 @@ namespace kodgen
 			*/
 			virtual std::string	getHeaderFileFooterMacro(fs::path const& targetFile)							const	noexcept;
 
+			/**
+			*	@brief Append the header file footer macro of the given file to a string, without any intermediate allocation.
+			* 
+			*	@param targetFile	Full path to the target file.
+			*	@param out_macro	String to append the generated header file footer macro name to.
+			*/
+			void				expandHeaderFileFooterMacro(fs::path const&	targetFile,
+															std::string&	out_macro)							const	noexcept;
+
 			/**
 			*	@brief Getter for the field _exportSymbolMacroName.
 			* 
@@ -279,5 +451,12 @@ namespace kodgen
 			*	@return _internalSymbolMacroName.
 			*/
 			std::string const&	getInternalSymbolMacroName()	const	noexcept;
+
+			/**
+			*	@brief Compute a fingerprint of the output directory, all file/macro name patterns and symbol macro names.
+			*
+			*	@return The fingerprint of these settings.
+			*/
+			virtual uint64		computeFingerprint()			const	noexcept override;
 	};
 }
\ No newline at end of file
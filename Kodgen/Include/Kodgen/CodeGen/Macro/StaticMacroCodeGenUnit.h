@@ -0,0 +1,129 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <tuple>
+#include <array>
+#include <utility>		//std::index_sequence
+#include <type_traits>
+#include <chrono>		//std::chrono::steady_clock
+
+#include "Kodgen/CodeGen/CodeGenHelpers.h"
+#include "Kodgen/CodeGen/Macro/MacroCodeGenUnit.h"
+#include "Kodgen/CodeGen/Macro/MacroCodeGenModule.h"
+
+namespace kodgen
+{
+	/**
+	*	MacroCodeGenUnit owning its modules, whose types are known at compile time.
+	*	The entity traversal and the dispatch to the modules and code locations are resolved at compile time:
+	*	no std::function, std::bind or virtual visitor call is made for each entity. Property code generators are registered
+	*	at runtime by their module, so they are still called through their virtual PropertyCodeGen::generateCodeForEntity.
+	*	Generators run in the same order and generate exactly the same code as with a MacroCodeGenUnit.
+	*
+	*	Module types must be copy-constructible, and their copies must register their own property code generators.
+	*
+	*	CodeGenEnv type: MacroCodeGenEnv
+	*/
+	template <typename... MacroCodeGenModuleTypes>
+	class StaticMacroCodeGenUnit final : public MacroCodeGenUnit
+	{
+		static_assert(sizeof...(MacroCodeGenModuleTypes) > 0u, "StaticMacroCodeGenUnit must have at least one module.");
+		static_assert((std::is_base_of_v<MacroCodeGenModule, MacroCodeGenModuleTypes> && ...), "StaticMacroCodeGenUnit modules must be derived classes of kodgen::MacroCodeGenModule.");
+		static_assert((std::is_copy_constructible_v<MacroCodeGenModuleTypes> && ...), "StaticMacroCodeGenUnit modules must be copy-constructible.");
+
+		private:
+			using ModuleGenerationMethod = ETraversalBehaviour (StaticMacroCodeGenUnit::*)(MacroCodeGenEnv&) noexcept;
+
+			/** Modules owned by this unit. */
+			std::tuple<MacroCodeGenModuleTypes...>	_modules;
+
+			/**
+			*	@brief Register all owned modules to the base unit, so that iteration counts, fingerprints and generation orders account for them.
+			*/
+			template <size_t... ModuleIndices>
+			void												registerModules(std::index_sequence<ModuleIndices...>)			noexcept;
+
+			/**
+			*	@brief Get the generation method of each module, by module index.
+			* 
+			*	@return The generation method of each module.
+			*/
+			template <size_t... ModuleIndices>
+			static constexpr std::array<ModuleGenerationMethod,
+										sizeof...(ModuleIndices)>	getModuleGenerationMethods(std::index_sequence<ModuleIndices...>)	noexcept;
+
+			/**
+			*	@brief Find the index of an owned module.
+			* 
+			*	@param codeGenerator The code generator to look for.
+			* 
+			*	@return The index of the module in _modules, or the number of modules if codeGenerator is not an owned module.
+			*/
+			template <size_t... ModuleIndices>
+			size_t												findModuleIndex(ICodeGenerator const*	codeGenerator,
+																				std::index_sequence<ModuleIndices...>)	const	noexcept;
+
+			/**
+			*	@brief Generate code for all entities of the parsed file with a single module.
+			* 
+			*	@param env Generation environment structure.
+			* 
+			*	@return The result of the entity traversal.
+			*/
+			template <size_t ModuleIndex>
+			ETraversalBehaviour									generateCodeWithModule(MacroCodeGenEnv& env)					noexcept;
+
+			/**
+			*	@brief Generate code for all the entity/property pairs of the parsed file a property code generator runs on.
+			* 
+			*	@param propertyCodeGen	The property code generator to run.
+			*	@param propertyIndex	Index of all the properties of the parsed file. Unused, and possibly not built,
+			*							if the generator is not dispatched by property name.
+			*	@param env				Generation environment structure.
+			* 
+			*	@return ETraversalBehaviour::AbortWithFailure if the generation failed, else ETraversalBehaviour::Recurse.
+			*/
+			ETraversalBehaviour									generateCodeWithPropertyCodeGen(PropertyCodeGen&		propertyCodeGen,
+																								PropertyIndex const&	propertyIndex,
+																								MacroCodeGenEnv&		env)	noexcept;
+
+		public:
+			StaticMacroCodeGenUnit()											noexcept;
+			StaticMacroCodeGenUnit(StaticMacroCodeGenUnit const& other)			noexcept;
+			StaticMacroCodeGenUnit(StaticMacroCodeGenUnit&&)					= delete;
+
+			/**
+			*	@brief	Generate code based on the provided parsing result.
+			*			Same as CodeGenUnit::generateCode, with all the per-entity calls resolved at compile time.
+			*			CodeGenManager::run calls this method through the static type of the unit.
+			* 
+			*	@param parsingResult Result of a file parsing used to generate code.
+			* 
+			*	@return true if the code generation completed successfully without error, else false.
+			*/
+			bool			generateCode(FileParsingResult const& parsingResult)	noexcept;
+
+			//Modules are known at compile time, so no module can be added or removed at runtime.
+			void			addModule(MacroCodeGenModule&)							noexcept = delete;
+			bool			removeModule(CodeGenModule const&)						noexcept = delete;
+
+			/**
+			*	@brief Getter for an owned module.
+			* 
+			*	@return The owned module of the provided type.
+			*/
+			template <typename ModuleType>
+			ModuleType&		getModule()												noexcept;
+
+			StaticMacroCodeGenUnit& operator=(StaticMacroCodeGenUnit const&)	= delete;
+			StaticMacroCodeGenUnit& operator=(StaticMacroCodeGenUnit&&)			= delete;
+	};
+
+	#include "Kodgen/CodeGen/Macro/StaticMacroCodeGenUnit.inl"
+}
\ No newline at end of file
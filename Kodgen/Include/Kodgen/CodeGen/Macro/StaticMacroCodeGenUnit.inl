@@ -0,0 +1,193 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename... MacroCodeGenModuleTypes>
+StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::StaticMacroCodeGenUnit() noexcept
+{
+	registerModules(std::index_sequence_for<MacroCodeGenModuleTypes...>());
+}
+
+template <typename... MacroCodeGenModuleTypes>
+StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::StaticMacroCodeGenUnit(StaticMacroCodeGenUnit const& other) noexcept:
+	MacroCodeGenUnit(),
+	_modules{other._modules}
+{
+	//Don't copy the base unit since it would clone the modules of other instead of registering the copied ones
+	settings					= other.settings;
+	logger						= other.logger;
+	generatedFileWriter			= other.generatedFileWriter;
+	shouldTouchUnchangedFiles	= other.shouldTouchUnchangedFiles;
+
+	registerModules(std::index_sequence_for<MacroCodeGenModuleTypes...>());
+}
+
+template <typename... MacroCodeGenModuleTypes>
+template <size_t... ModuleIndices>
+void StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::registerModules(std::index_sequence<ModuleIndices...>) noexcept
+{
+	(MacroCodeGenUnit::addModule(std::get<ModuleIndices>(_modules)), ...);
+}
+
+template <typename... MacroCodeGenModuleTypes>
+template <size_t... ModuleIndices>
+constexpr std::array<typename StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::ModuleGenerationMethod, sizeof...(ModuleIndices)> StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::getModuleGenerationMethods(std::index_sequence<ModuleIndices...>) noexcept
+{
+	return { { &StaticMacroCodeGenUnit::generateCodeWithModule<ModuleIndices>... } };
+}
+
+template <typename... MacroCodeGenModuleTypes>
+template <size_t... ModuleIndices>
+size_t StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::findModuleIndex(ICodeGenerator const* codeGenerator, std::index_sequence<ModuleIndices...>) const noexcept
+{
+	size_t moduleIndex = sizeof...(ModuleIndices);
+
+	((codeGenerator == static_cast<ICodeGenerator const*>(&std::get<ModuleIndices>(_modules)) && (moduleIndex = ModuleIndices, true)) || ...);
+
+	return moduleIndex;
+}
+
+template <typename... MacroCodeGenModuleTypes>
+template <size_t ModuleIndex>
+ETraversalBehaviour StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::generateCodeWithModule(MacroCodeGenEnv& env) noexcept
+{
+	using ModuleType = std::tuple_element_t<ModuleIndex, std::tuple<MacroCodeGenModuleTypes...>>;
+
+	ModuleType& module = std::get<ModuleIndex>(_modules);
+
+	auto visitor = [this, &module, &env](EntityInfo const& entity)
+	{
+		ETraversalBehaviour result = CodeGenHelpers::leastPrioritizedTraversalBehaviour;
+
+		auto generate = [&result, &module](EntityInfo const& entity, MacroCodeGenEnv& env, std::string& inout_result)
+		{
+			//Qualified call so that the module method is not called through the virtual table
+			result = CodeGenHelpers::combineTraversalBehaviours(result, module.ModuleType::generateCodeForEntity(entity, env, inout_result));
+		};
+
+		generateCodeForEntityAtLocations(entity, env, generate);
+
+		return result;
+	};
+
+	return foreachEntity(*env.getFileParsingResult(), visitor);
+}
+
+template <typename... MacroCodeGenModuleTypes>
+ETraversalBehaviour StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::generateCodeWithPropertyCodeGen(PropertyCodeGen& propertyCodeGen, PropertyIndex const& propertyIndex, MacroCodeGenEnv& env) noexcept
+{
+	auto visitor = [this, &propertyCodeGen, &env](EntityInfo const& entity, Property const& property, uint8 propertyIndex)
+	{
+		bool result = true;
+
+		auto generate = [&result, &propertyCodeGen, &property, propertyIndex](EntityInfo const& entity, MacroCodeGenEnv& env, std::string& inout_result)
+		{
+			result &= propertyCodeGen.generateCodeForEntity(entity, property, propertyIndex, env, inout_result);
+		};
+
+		generateCodeForEntityAtLocations(entity, env, generate);
+
+		return result;
+	};
+
+	//Generators overriding shouldGenerateCodeForEntity might run on other properties, so they traverse all entities
+	return propertyCodeGen.isDispatchedByPropertyName() ?
+			foreachPropertyOccurrence(propertyCodeGen, propertyIndex, visitor) :
+			foreachPropertyOccurrence(propertyCodeGen, *env.getFileParsingResult(), visitor);
+}
+
+template <typename... MacroCodeGenModuleTypes>
+bool StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::generateCode(FileParsingResult const& parsingResult) noexcept
+{
+	constexpr std::array<ModuleGenerationMethod, sizeof...(MacroCodeGenModuleTypes)> moduleGenerationMethods = getModuleGenerationMethods(std::index_sequence_for<MacroCodeGenModuleTypes...>());
+
+	MacroCodeGenEnv env;
+
+	writeDuration = 0.0f;
+
+	//Pre-generation step
+	bool result = MacroCodeGenUnit::preGenerateCode(parsingResult, env);
+
+	//Generation step (per generator/entity pair), runs only if the pre-generation step succeeded
+	if (result)
+	{
+		std::vector<ICodeGenerator*>	codeGenerators		= getSortedCodeGenerators();
+		PropertyIndex					propertyIndex;
+		bool							isPropertyIndexBuilt	= false;
+
+		//Call initialGenerateCode on all code generators first
+		for (ICodeGenerator* codeGenerator : codeGenerators)
+		{
+			auto generate = [codeGenerator](MacroCodeGenEnv& env, std::string& inout_result)
+			{
+				codeGenerator->initialGenerateCode(env, inout_result);
+			};
+
+			generateCodeAtLocations(env, generate);
+		}
+
+		//Run each generator on the entities in generation order
+		for (ICodeGenerator* codeGenerator : codeGenerators)
+		{
+			ETraversalBehaviour	traversalResult;
+			size_t				moduleIndex = findModuleIndex(codeGenerator, std::index_sequence_for<MacroCodeGenModuleTypes...>());
+
+			if (moduleIndex < moduleGenerationMethods.size())
+			{
+				traversalResult = (this->*moduleGenerationMethods[moduleIndex])(env);
+			}
+			else
+			{
+				//Generators which are not modules are property code generators registered by the modules
+				PropertyCodeGen& propertyCodeGen = static_cast<PropertyCodeGen&>(*codeGenerator);
+
+				if (!isPropertyIndexBuilt && propertyCodeGen.isDispatchedByPropertyName())
+				{
+					buildPropertyIndex(parsingResult, propertyIndex);
+					isPropertyIndexBuilt = true;
+				}
+
+				traversalResult = generateCodeWithPropertyCodeGen(propertyCodeGen, propertyIndex, env);
+			}
+
+			if (traversalResult == ETraversalBehaviour::AbortWithFailure || traversalResult == ETraversalBehaviour::AbortWithSuccess)
+			{
+				result &= traversalResult != ETraversalBehaviour::AbortWithFailure;
+				break;
+			}
+		}
+
+		if (result)
+		{
+			//Final call to generate code with a nullptr entity
+			for (ICodeGenerator* codeGenerator : codeGenerators)
+			{
+				auto generate = [codeGenerator](MacroCodeGenEnv& env, std::string& inout_result)
+				{
+					codeGenerator->finalGenerateCode(env, inout_result);
+				};
+
+				generateCodeAtLocations(env, generate);
+			}
+
+			//Post-generation step, runs only if all previous steps succeeded
+			auto writeStart = std::chrono::steady_clock::now();
+
+			result &= MacroCodeGenUnit::postGenerateCode(env);
+
+			writeDuration = std::chrono::duration<float>(std::chrono::steady_clock::now() - writeStart).count();
+		}
+	}
+
+	return result;
+}
+
+template <typename... MacroCodeGenModuleTypes>
+template <typename ModuleType>
+ModuleType& StaticMacroCodeGenUnit<MacroCodeGenModuleTypes...>::getModule() noexcept
+{
+	return std::get<ModuleType>(_modules);
+}
\ No newline at end of file
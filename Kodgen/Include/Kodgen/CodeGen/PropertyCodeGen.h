@@ -8,6 +8,7 @@
 #pragma once
 
 #include <string>
+#include <type_traits>	//std::true_type, std::bool_constant, std::void_t
 
 #include "Kodgen/Config.h"
 #include "Kodgen/CodeGen/CodeGenEnv.h"
@@ -17,8 +18,15 @@
 
 namespace kodgen
 {
+	//Forward declaration
+	class CodeGenUnit;
+	class CodeGenModule;
+
 	class PropertyCodeGen : public ICodeGenerator
 	{
+		friend CodeGenUnit;
+		friend CodeGenModule;
+
 		private:
 			struct AdditionalData
 			{
@@ -32,6 +40,13 @@ namespace kodgen
 			/** Mask defining the type of entities this generator can run on. */
 			EEntityType	_eligibleEntityMask = EEntityType::Undefined;
 
+			/**
+			*	Can the CodeGenUnit run this generator on the properties named after it only, rather than on all the properties of all entities?
+			*	Set when the generator is registered by a CodeGenModule: false if its type overrides shouldGenerateCodeForEntity,
+			*	since the override might accept properties with another name.
+			*/
+			bool		_isDispatchedByPropertyName = true;
+
 			/**
 			*	@brief	Call the visitor method once for each entity/property pair.
 			*			The forwarded data is a PropertyCodeGen::AdditionalData const*.
@@ -51,6 +66,26 @@ namespace kodgen
 																							  CodeGenEnv&,
 																							  void const*)>		visitor)	noexcept final override;
 
+			/**
+			*	@brief	Call the visitor method on a single entity/property pair this generator should generate code for.
+			*			Used by the CodeGenUnit to dispatch the properties it indexed by name, without traversing all entities.
+			*			The forwarded data is a PropertyCodeGen::AdditionalData const*.
+			* 
+			*	@param entity			The entity provided to the visitor.
+			*	@param propertyIndex	Index of the property in the entity's propertyGroup.
+			*	@param env				The environment provided to the visitor.
+			*	@param visitor			The visitor to run.
+			* 
+			*	@return	AbortWithFailure if the visitor call returned AbortWithFailure, else Recurse.
+			*/
+			ETraversalBehaviour			callVisitorOnProperty(EntityInfo const&									entity,
+															  uint8												propertyIndex,
+															  CodeGenEnv&										env,
+															  std::function<ETraversalBehaviour(ICodeGenerator&,
+																								EntityInfo const&,
+																								CodeGenEnv&,
+																								void const*)>	visitor)		noexcept;
+
 			/**
 			*	@brief	Generate code for the provided entity/environment pair.
 			*			Internally call the PropertyCodeGen::generateCode public method by unwrapping the data content.
@@ -76,6 +111,16 @@ namespace kodgen
 			*/
 			bool						shouldIterateOnNestedEntities(EntityInfo const& entity)						const	noexcept;
 
+			/**
+			*	@brief	Determine whether this PropertyCodeGen reaches the entities nested in outer entities of the provided types,
+			*			that is if it iterates on the nested entities of all of them.
+			* 
+			*	@param outerEntityTypes Mask of the types of all the outer entities.
+			* 
+			*	@return true if the generator runs on the entities nested in such outer entities, else false.
+			*/
+			bool						canReachNestedEntities(EEntityType outerEntityTypes)						const	noexcept;
+
 		public:
 			/**
 			*	@param propertyName			Name of the property this property generator should generate code for.
@@ -102,7 +147,9 @@ namespace kodgen
 															  std::string&		inout_result)					noexcept = 0;
 
 			/**
-			*	@brief Check if this property should generate code for the provided entity/property pair.
+			*	@brief	Check if this property should generate code for the provided entity/property pair.
+			*			The CodeGenUnit only calls this method for the properties named after this generator,
+			*			unless the generator type overrides it: the method is then called for all properties of all eligible entities.
 			*
 			*	@param entity			Checked entity.
 			*	@param property			Checked property.
@@ -127,6 +174,26 @@ namespace kodgen
 			*	@return _propertyName.
 			*/
 			inline std::string const&	getPropertyName()												const	noexcept;
+
+			/**
+			*	@brief Getter for _isDispatchedByPropertyName field.
+			* 
+			*	@return _isDispatchedByPropertyName.
+			*/
+			inline bool					isDispatchedByPropertyName()									const	noexcept;
+
+		private:
+			/**
+			*	Check whether a property code generator type overrides shouldGenerateCodeForEntity.
+			*	Overrides the checking class can't access are considered overrides as well.
+			*/
+			template <typename PropertyCodeGenType, typename = void>
+			struct OverridesShouldGenerateCodeForEntity : std::true_type {};
+
+			template <typename PropertyCodeGenType>
+			struct OverridesShouldGenerateCodeForEntity<PropertyCodeGenType, std::void_t<decltype(&PropertyCodeGenType::shouldGenerateCodeForEntity)>> :
+				std::bool_constant<!std::is_same_v<decltype(&PropertyCodeGenType::shouldGenerateCodeForEntity), decltype(&PropertyCodeGen::shouldGenerateCodeForEntity)>>
+			{};
 	};
 
 	#include "Kodgen/CodeGen/PropertyCodeGen.inl"
@@ -13,4 +13,9 @@ inline EEntityType PropertyCodeGen::getEligibleEntityMask() const noexcept
 inline std::string const& PropertyCodeGen::getPropertyName() const noexcept
 {
 	return _propertyName;
+}
+
+inline bool PropertyCodeGen::isDispatchedByPropertyName() const noexcept
+{
+	return _isDispatchedByPropertyName;
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Append-only text buffer storing its content in a list of chunks.
+	*	Appended data never moves once written, so appending never copies the content already in the buffer.
+	*	Each chunk is twice as large as the previous one, so a buffer of n bytes is made of O(log n) chunks until chunks reach their maximum capacity.
+	*	Large strings and the chunks of appended buffers are adopted as is instead of being copied.
+	*/
+	class ChunkedBuffer
+	{
+		private:
+			/** Capacity of the first chunk of a buffer. */
+			static constexpr size_t const	_minChunkCapacity	= 256u;
+
+			/** Capacity chunks stop growing at. */
+			static constexpr size_t const	_maxChunkCapacity	= 64u * 1024u;
+
+			/** Size from which appended strings and chunks are adopted instead of being copied. */
+			static constexpr size_t const	_minAdoptedSize		= 4u * 1024u;
+
+			/** Chunks of the buffer, in order. Only the last chunk can be appended to. */
+			std::vector<std::string>		_chunks;
+
+			/**
+			*	@brief Append a chunk at the end of the buffer without copying it.
+			*
+			*	@param chunk The chunk to append. It is left empty.
+			*/
+			void adoptChunk(std::string&& chunk)							noexcept;
+
+		public:
+			/**
+			*	@brief Copy some data at the end of the buffer.
+			*
+			*	@param data Data to append.
+			*	@param size Size of the data to append.
+			*/
+			void								append(char const*	data,
+													   size_t		size)		noexcept;
+
+			/**
+			*	@brief Copy a string at the end of the buffer.
+			*
+			*	@param str String to append.
+			*/
+			void								append(std::string_view str)	noexcept;
+
+			/**
+			*	@brief	Append a string at the end of the buffer. Large strings become a chunk of the buffer instead of being copied.
+			*			The string is left empty, but keeps its capacity if it has been copied.
+			*
+			*	@param str String to append.
+			*/
+			void								append(std::string&& str)		noexcept;
+
+			/**
+			*	@brief	Append the content of another buffer at the end of this buffer. Large chunks are moved instead of being copied.
+			*
+			*	@param buffer Buffer to append. It is left empty.
+			*/
+			void								append(ChunkedBuffer&& buffer)	noexcept;
+
+			/**
+			*	@brief Remove all the content of the buffer.
+			*/
+			void								clear()							noexcept;
+
+			/**
+			*	@brief Getter for the total size of the buffer content.
+			*
+			*	@return The total size of the buffer content.
+			*/
+			size_t								size()					const	noexcept;
+
+			/**
+			*	@brief Check whether the buffer is empty.
+			*
+			*	@return true if the buffer has no content, else false.
+			*/
+			bool								empty()					const	noexcept;
+
+			/**
+			*	@brief	Getter for the chunks of the buffer, to write the buffer without flattening it.
+			*			Chunks can be empty.
+			*
+			*	@return The chunks of the buffer, in order.
+			*/
+			std::vector<std::string> const&		getChunks()				const	noexcept;
+
+			/**
+			*	@brief Compute the hash of the buffer content, which is the same as Helpers::computeHash of the flattened content.
+			*
+			*	@return The hash of the buffer content.
+			*/
+			uint64								computeHash()			const	noexcept;
+
+			/**
+			*	@brief Copy the whole content of the buffer into a single string.
+			*
+			*	@return The content of the buffer.
+			*/
+			std::string							toString()				const	noexcept;
+	};
+}
\ No newline at end of file
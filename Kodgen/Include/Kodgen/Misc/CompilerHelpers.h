@@ -74,12 +74,53 @@ namespace kodgen
 			*/
 			static std::string				normalizeCompilerExeName(std::string const& compilerName)	noexcept;
 
+			/**
+			*	@brief	Get the path to the file caching the native include directories of probed compilers.
+			*			Compilers are only spawned when they have no valid entry in this file.
+			*
+			*	@return The path to the cache file, or an empty path if no user cache directory is available.
+			*/
+			static fs::path					getCacheFilePath()											noexcept;
+
+			/**
+			*	@brief	Compute the key identifying a compiler installation in the cache file.
+			*			The key contains the resolved compiler executable path, its last write time and its size,
+			*			so that it changes whenever the compiler is updated or another compiler is picked from the PATH.
+			*
+			*	@param normalizedCompilerExeName Normalized name of the compiler executable.
+			*
+			*	@return The cache key of the compiler, or an empty string if the compiler executable could not be located.
+			*/
+			static std::string				getCacheKey(std::string const& normalizedCompilerExeName)	noexcept;
+
+			/**
+			*	@brief	Retrieve the cached native include directories of a compiler.
+			*			An entry is only valid if all its include directories still exist.
+			*
+			*	@param cacheKey					Cache key of the compiler.
+			*	@param out_includeDirectories	Cached native include directories of the compiler.
+			*
+			*	@return true if a valid entry was found for the compiler, else false.
+			*/
+			static bool						loadCachedIncludeDirectories(std::string const&			cacheKey,
+																		 std::vector<fs::path>&		out_includeDirectories)	noexcept;
+
+			/**
+			*	@brief Save the native include directories of a compiler in the cache file, replacing any previous entry for this compiler.
+			*
+			*	@param cacheKey				Cache key of the compiler.
+			*	@param includeDirectories	Native include directories of the compiler.
+			*/
+			static void						saveCachedIncludeDirectories(std::string const&				cacheKey,
+																		 std::vector<fs::path> const&	includeDirectories)	noexcept;
+
 		public:
 			CompilerHelpers()	= delete;
 			~CompilerHelpers()	= delete;
 
 			/**
-			*	@brief Check if the provided compiler is valid and supported on the running machine.
+			*	@brief	Check if the provided compiler is valid and supported on the running machine.
+			*			Compilers with a valid entry in the cache file are supported without being spawned.
 			*	
 			*	@param compiler Compiler we check the validity of.
 			*	
@@ -110,7 +151,8 @@ namespace kodgen
 			static bool						isGCC(std::string const& normalizedCompilerExeName)					noexcept;
 
 			/**
-			*	@brief Retrieve all native include directories of a given compiler on the executing computer.
+			*	@brief	Retrieve all native include directories of a given compiler on the executing computer.
+			*			Results are cached on disk so that the compiler is only spawned once per installation.
 			*
 			*	@param compiler Compiler we are looking the include directories of.
 			*	
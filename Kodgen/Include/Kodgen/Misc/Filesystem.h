@@ -18,6 +18,9 @@
 #endif
 
 #include <functional>
+#include <string>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
 
 namespace kodgen
 {
@@ -64,5 +67,27 @@ namespace kodgen
 			*/
 			static bool		isChildPath(fs::path const& child,
 										fs::path const& other)			noexcept;
+
+			/**
+			*	@brief	Compute a hash of the provided file content (64-bit FNV-1a).
+			*			The hash only depends on the file content, so it is stable between runs.
+			*
+			*	@param file Path to the file to hash.
+			*	
+			*	@return The hash of the file content, or 0 if the file could not be read.
+			*/
+			static uint64	computeFileHash(fs::path const& file)			noexcept;
+
+			/**
+			*	@brief	Replace the content of a file atomically: the content is written to a uniquely named temporary file
+			*			which then replaces the file, so that an interrupted write never leaves a truncated file.
+			*
+			*	@param file		Path to the file to write.
+			*	@param content	New content of the file.
+			*	
+			*	@return true if the file has been replaced, else false. On failure, the file is left untouched.
+			*/
+			static bool		writeFileAtomically(fs::path const&		file,
+												std::string const&	content)	noexcept;
 	};
 }
\ No newline at end of file
@@ -11,6 +11,8 @@
 
 #include <clang-c/Index.h>
 
+#include "Kodgen/Misc/FundamentalTypes.h"
+
 namespace kodgen
 {
 	class Helpers
@@ -45,6 +47,30 @@ namespace kodgen
 			*	@return "true" if the boolean is true, else "false".
 			*/
 			static inline std::string	toString(bool value)					noexcept;
+
+			/**
+			*	@brief Compute the 64-bit FNV-1a hash of some data, continuing from a previously computed hash.
+			*	
+			*	@param data	Pointer to the data to hash.
+			*	@param size	Size of the data in bytes.
+			*	@param hash	Hash to continue from. Use the default value to start a new hash.
+			*	
+			*	@return The resulting hash.
+			*/
+			static uint64				computeHash(void const*	data,
+													size_t		size,
+													uint64		hash = 14695981039346656037ull)	noexcept;
+
+			/**
+			*	@brief Compute the 64-bit FNV-1a hash of a string, continuing from a previously computed hash.
+			*	
+			*	@param data	String to hash.
+			*	@param hash	Hash to continue from. Use the default value to start a new hash.
+			*	
+			*	@return The resulting hash.
+			*/
+			static uint64				computeHash(std::string const&	data,
+													uint64				hash = 14695981039346656037ull)	noexcept;
 	};
 
 	#include "Kodgen/Misc/Helpers.inl"
@@ -9,10 +9,32 @@
 
 #include <string>
 
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
 namespace kodgen
 {
 	class System
 	{
+		private:
+			/**
+			*	@brief	Get the cgroup v2 directory of the running process.
+			*	
+			*	@return The cgroup directory of the process, or an empty path if the process doesn't run in a cgroup v2 hierarchy.
+			*/
+			static fs::path		getCgroupDirectory()								noexcept;
+
+			/**
+			*	@brief	Read a cgroup v2 limit of the running process, taking the limits of all ancestor cgroups into account.
+			*	
+			*	@param limitFilename	Name of the cgroup interface file containing the limit.
+			*	@param readLimit		Function reading the limit from the first line of an interface file, returning 0 if there is no limit.
+			*	
+			*	@return The lowest limit of the process cgroup and its ancestors, or 0 if there is no limit.
+			*/
+			static uint64		readCgroupLimit(char const*	limitFilename,
+												uint64		(*readLimit)(std::string const&))	noexcept;
+
 		public:
 			System()  = delete;
 			~System() = delete;
@@ -24,6 +46,74 @@ namespace kodgen
 			*	
 			*	@return The result of the given command.
 			*/
-			static std::string executeCommand(std::string const& cmd);
+			static std::string	executeCommand(std::string const& cmd);
+
+			/**
+			*	@brief Get the path to the executable of the running process.
+			*	
+			*	@return The path to the running executable, or an empty path if it could not be retrieved on this platform.
+			*/
+			static fs::path		getExecutablePath()			noexcept;
+
+			/**
+			*	@brief	Compute a fingerprint of the binary (executable or shared library) containing an address, without reading it:
+			*			its GNU build ID when it has one, else its path, size and last write time.
+			*	
+			*	@param address Address of any code or data of the binary. If nullptr, the executable of the running process is used.
+			*	
+			*	@return The fingerprint of the binary, or 0 if it could not be identified on this platform.
+			*/
+			static uint64		computeModuleFingerprint(void const* address)		noexcept;
+
+			/**
+			*	@brief Find an executable in the directories listed in the PATH environment variable.
+			*	
+			*	@param executableName Name of the executable to look for. On Windows, the .exe extension can be omitted.
+			*	
+			*	@return The path to the first matching executable, or an empty path if it could not be found.
+			*/
+			static fs::path		findExecutable(std::string const& executableName)	noexcept;
+
+			/**
+			*	@brief	Get the directory in which user-specific cache files should be stored.
+			*			It is $XDG_CACHE_HOME or $HOME/.cache on Unix systems and %LOCALAPPDATA% on Windows.
+			*	
+			*	@return The path to the user cache directory, or an empty path if it could not be determined.
+			*/
+			static fs::path		getUserCacheDirectory()								noexcept;
+
+			/**
+			*	@brief	Get the number of CPUs the running process is allowed to use by its cgroup v2 CPU quota (cpu.max),
+			*			rounded up to the next integer.
+			*	
+			*	@return The number of CPUs allowed by the quota, or 0 if there is no quota or it could not be retrieved on this platform.
+			*/
+			static uint32		getCpuQuota()										noexcept;
+
+			/**
+			*	@brief	Get the number of threads to use based on the provided thread count.
+			*			If 0 is provided, std::thread::hardware_concurrency is used, or 8 if std::thread::hardware_concurrency returns 0,
+			*			without exceeding the cgroup v2 CPU quota of the process if any.
+			*			For all other initial thread count values, the function returns immediately this number.
+			* 
+			*	@param initialThreadCount The number of threads to use.
+			* 
+			*	@return The number of threads to use.
+			*/
+			static uint32		getThreadCount(uint32 initialThreadCount)			noexcept;
+
+			/**
+			*	@brief Get the memory the running process is allowed to use by its cgroup v2 memory limit (memory.max).
+			*	
+			*	@return The memory limit in bytes, or 0 if there is no limit or it could not be retrieved on this platform.
+			*/
+			static uint64		getMemoryLimit()									noexcept;
+
+			/**
+			*	@brief Get the memory currently resident in RAM for the running process.
+			*	
+			*	@return The resident memory in bytes, or 0 if it could not be retrieved on this platform.
+			*/
+			static uint64		getResidentMemory()									noexcept;
 	};
 }
\ No newline at end of file
@@ -17,6 +17,8 @@
 #include "Kodgen/Parsing/ParsingResults/FileParsingResult.h"
 #include "Kodgen/Parsing/ParsingSettings.h"
 #include "Kodgen/Parsing/PropertyParser.h"
+#include "Kodgen/Parsing/TranslationUnitCache.h"
+#include "Kodgen/Parsing/UnsavedFileOverlay.h"
 #include "Kodgen/Misc/Filesystem.h"
 #include "Kodgen/Misc/ILogger.h"
 
@@ -25,6 +27,18 @@ namespace kodgen
 	class FileParser : public NamespaceParser
 	{
 		private:
+			struct InclusionCollection
+			{
+				/** Result the included files are added to. */
+				FileParsingResult*				result						= nullptr;
+
+				/** Translation unit the inclusions are collected from. */
+				CXTranslationUnit				translationUnit				= nullptr;
+
+				/** Directories whose included files get the content parsed by libclang hashed. Can be nullptr. */
+				std::vector<fs::path> const*	hashedIncludeDirectories	= nullptr;
+			};
+
 			/** Index used internally by libclang to process a translation unit. */
 			CXIndex								_clangIndex;
 
@@ -47,6 +61,19 @@ namespace kodgen
 														  CXCursor		parentCursor,
 														  CXClientData	clientData)						noexcept;
 
+			/**
+			*	@brief This method is called for each file included by the translation unit being parsed.
+			*
+			*	@param includedFile		The included file.
+			*	@param inclusionStack	Stack of source locations leading to the inclusion of includedFile.
+			*	@param includeLength	Length of the inclusion stack. 0 for the main file.
+			*	@param clientData		Pointer to a data provided by the client. Must contain an InclusionCollection*.
+			*/
+			static void					collectInclusion(CXFile				includedFile,
+														 CXSourceLocation*	inclusionStack,
+														 unsigned			includeLength,
+														 CXClientData		clientData)					noexcept;
+
 			/**
 			*	@brief Push a new clean context to prepare translation unit parsing.
 			*
@@ -135,7 +162,26 @@ namespace kodgen
 
 		public:
 			/** Logger used to issue logs from the FileParser. Can be nullptr. */
-			ILogger*			logger	= nullptr;
+			ILogger*								logger	= nullptr;
+
+			/**
+			*	Cache keeping translation units alive between parsings of the same files to reparse them incrementally.
+			*	Copies of this parser share the same cache. Can be nullptr, in which case translation units are disposed after each parsing.
+			*/
+			std::shared_ptr<TranslationUnitCache>	translationUnitCache;
+
+			/**
+			*	In-memory contents overriding the content of files on disk, for the parsed files and the files they include.
+			*	Copies of this parser share the same overlay. Can be nullptr, in which case all files are read from disk.
+			*/
+			std::shared_ptr<UnsavedFileOverlay>		unsavedFileOverlay;
+
+			/**
+			*	Directories whose included files get the hash of the content libclang parsed stored in FileParsingResult::includedFilesHashes,
+			*	so that a file rewritten during the parsing is detected later on. Contents are not hashed when a translationUnitCache is used,
+			*	since files of a precompiled preamble are not read by the parsing itself.
+			*/
+			std::vector<fs::path>					hashedIncludeDirectories;
 
 			FileParser()					noexcept;
 			FileParser(FileParser const&)	noexcept;
@@ -153,12 +199,27 @@ namespace kodgen
 			bool					parse(fs::path const&					toParseFile,
 										  FileParsingResult&				out_result)		noexcept;
 
+			/**
+			*	@brief	Parse a header with the current compilation arguments and save it as a precompiled header.
+			*			The precompiled header can then be used to parse files through ParsingSettings::setPrecompiledHeader.
+			*
+			*	@param headerFile				Path to the header to precompile.
+			*	@param precompiledHeaderFile	Path to the precompiled header to write.
+			*	@param out_includedFiles		Paths to all files included (directly or not) by the header.
+			*
+			*	@return true if the precompiled header has been written without error, else false.
+			*/
+			bool					buildPrecompiledHeader(fs::path const&			headerFile,
+														   fs::path const&			precompiledHeaderFile,
+														   std::vector<fs::path>&	out_includedFiles)		noexcept;
+
 			/**
 			*	@brief Getter for _settings field.
 			* 
 			*	@return _settings.
 			*/
-			inline ParsingSettings&	getSettings()											noexcept;
+			inline ParsingSettings&			getSettings()									noexcept;
+			inline ParsingSettings const&	getSettings()							const	noexcept;
 	};
 
 	#include "Kodgen/Parsing/FileParser.inl"
@@ -15,5 +15,13 @@ inline ParsingSettings& FileParser::getSettings() noexcept
 	//The _settings pointer should ALWAYS holds a reference (created at construction)
 	assert(_settings.use_count() != 0);
 
+	return *_settings;
+}
+
+inline ParsingSettings const& FileParser::getSettings() const noexcept
+{
+	//The _settings pointer should ALWAYS holds a reference (created at construction)
+	assert(_settings.use_count() != 0);
+
 	return *_settings;
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <vector>
+#include <memory>		//std::unique_ptr
+#include <atomic>
+#include <type_traits>	//std::is_base_of
+
+#include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+#include "Kodgen/CodeGen/CodeGenManagerSettings.h"
+#include "Kodgen/Parsing/FileParser.h"
+#include "Kodgen/Parsing/ParsingResults/FileParsingResult.h"
+#include "Kodgen/Threading/ThreadPool.h"
+
+namespace kodgen
+{
+	/**
+	*	Parse files on multiple threads without generating any code, for tools which only need parsing results.
+	*	Each parsing result is provided to a callback as soon as its file is parsed, and is released once the callback returns,
+	*	so the number of parsing results alive at once is bounded by the number of threads, not by the number of parsed files.
+	*/
+	class ParsingManager
+	{
+		private:
+			/** Thread pool used for files parsing. */
+			ThreadPool	_threadPool;
+
+		public:
+			/** Logger used to issue logs from the ParsingManager. */
+			ILogger*				logger		= nullptr;
+
+			/**
+			*	Settings selecting the files to parse, shared with the CodeGenManager.
+			*	Only the processed and ignored files and directories and the supported file extensions are used.
+			*/
+			CodeGenManagerSettings	settings;
+
+			/**
+			*	@brief Construct a ParsingManager that will work with the specified number of threads.
+			* 
+			*	@param threadCount	Number of threads to use for file parsing, in addition to the thread calling ParsingManager::run.
+			*						If 0 is provided, the number of concurrent threads supported by the implementation will be used (std::thread::hardware_concurrency(), and 8 if std::thread::hardware_concurrency() returns 0),
+			*						limited to the cgroup v2 CPU quota of the process if any.
+			*/
+			ParsingManager(uint32 threadCount = 0u)	noexcept;
+
+			/**
+			*	@brief	Parse all files selected by the settings, and provide the result of each file to a callback as soon as the file is parsed.
+			*			The callback is called by parsing threads, possibly for several files at once, so it must be thread-safe.
+			*			The parsing result is released when the callback returns: move it out to keep it.
+			* 
+			*	@param fileParser	Original file parser to use to parse files. A copy of this parser is used by each parsing thread.
+			*	@param onFileParsed	Callable taking the FileParsingResult& of a parsed file.
+			* 
+			*	@return true if all files have been parsed without error, else false.
+			*/
+			template <typename FileParserType, typename Callable>
+			bool run(FileParserType&	fileParser,
+					 Callable&&			onFileParsed)	noexcept;
+	};
+
+	#include "Kodgen/Parsing/ParsingManager.inl"
+}
\ No newline at end of file
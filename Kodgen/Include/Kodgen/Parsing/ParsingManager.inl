@@ -0,0 +1,55 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename FileParserType, typename Callable>
+bool ParsingManager::run(FileParserType& fileParser, Callable&& onFileParsed) noexcept
+{
+	//Check FileParser validity
+	static_assert(std::is_base_of_v<FileParser, FileParserType>, "fileParser type must be a derived class of kodgen::FileParser.");
+	static_assert(std::is_copy_constructible_v<FileParserType>, "The provided file parser must be copy-constructible.");
+
+	//Only paths are collected beforehand, parsing results are never accumulated
+	std::vector<fs::path> filesToParse;
+
+	settings.foreachFileToProcess([&filesToParse](fs::path const& file)
+	{
+		filesToParse.push_back(file);
+	}, logger);
+
+	if (filesToParse.empty())
+	{
+		return true;
+	}
+
+	//Initialize the parsing settings to setup parser compilation arguments.
+	fileParser.getSettings().init(logger);
+
+	//Each thread reuses its own parser between files. The calling thread parses files as well, using the first parser.
+	std::vector<std::unique_ptr<FileParserType>>	threadFileParsers(_threadPool.getWorkerCount() + 1u);
+	std::atomic<bool>								isSuccessful = true;
+
+	_threadPool.parallelFor(filesToParse.size(), [&](size_t fileIndex)
+	{
+		std::unique_ptr<FileParserType>& threadFileParser = threadFileParsers[_threadPool.getCurrentWorkerIndex() + 1];
+
+		if (threadFileParser == nullptr)
+		{
+			threadFileParser = std::make_unique<FileParserType>(fileParser);
+		}
+
+		FileParsingResult parsingResult;
+
+		if (!threadFileParser->parse(filesToParse[fileIndex], parsingResult))
+		{
+			isSuccessful.store(false, std::memory_order_relaxed);
+		}
+
+		onFileParsed(parsingResult);
+	});
+
+	return isSuccessful.load(std::memory_order_relaxed);
+}
\ No newline at end of file
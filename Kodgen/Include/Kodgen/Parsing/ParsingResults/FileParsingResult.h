@@ -8,6 +8,7 @@
 #pragma once
 
 #include <vector>
+#include <unordered_map>
 #include <cassert>
 
 #include "Kodgen/Parsing/ParsingError.h"
@@ -51,6 +52,18 @@ namespace kodgen
 			/** Structure containing the whole struct/class hierarchy linked to parsed structs/classes. */
 			StructClassTree					structClassTree;
 
+			/** Paths to all files included (directly or not) by the parsed file. */
+			std::vector<fs::path>			includedFiles;
+
+			/** Hash of the content libclang parsed for the included files located in FileParser::hashedIncludeDirectories. */
+			std::unordered_map<fs::path, uint64, PathHash>	includedFilesHashes;
+
+			/** Time spent (in seconds) by libclang to parse the file into a translation unit. */
+			float							translationUnitParsingDuration	= 0.0f;
+
+			/** Time spent (in seconds) extracting entities from the translation unit of the file. */
+			float							entityExtractionDuration		= 0.0f;
+
 			/**
 			*	@brief Call a visitor function on each entity of the provided type(s) contained in a file.
 			* 
@@ -55,6 +55,9 @@ namespace kodgen
 
 			std::vector<char const*>				_compilationArguments;
 
+			/** Path to the precompiled header used to parse files, if any. */
+			std::string								_precompiledHeaderPath;
+
 			/**
 			*	@brief Try to convert an integer to a ECppVersion enum value.
 			* 
@@ -133,6 +136,25 @@ namespace kodgen
 			void	loadProjectIncludeDirectories(toml::value const&	parsingSettings,
 												  ILogger*				logger)				noexcept;
 
+			/**
+			*	@brief Load the shouldUsePrecompiledHeader setting from toml.
+			*
+			*	@param parsingSettings	Toml content.
+			*	@param logger			Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void	loadShouldUsePrecompiledHeader(toml::value const&	parsingSettings,
+												   ILogger*				logger)				noexcept;
+
+			/**
+			*	@brief	Load the precompiledHeaderIncludes setting from toml.
+			*			Loaded includes completely replace previous precompiledHeaderIncludes if any.
+			*
+			*	@param parsingSettings	Toml content.
+			*	@param logger			Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void	loadPrecompiledHeaderIncludes(toml::value const&	parsingSettings,
+												  ILogger*				logger)				noexcept;
+
 		protected:
 			virtual bool loadSettingsValues(toml::value const&	tomlData,
 											ILogger*			logger)		noexcept override;
@@ -187,6 +209,19 @@ namespace kodgen
 			*/
 			bool									shouldLogDiagnostic				= false;
 
+			/**
+			*	Should files be parsed with a precompiled header containing the includes shared by most parsed files?
+			*	The precompiled header is built in the state directory of the CodeGenManager and reused between runs as long as its inputs don't change.
+			*	Included headers must not depend on macros defined before their inclusion since they are parsed first.
+			*/
+			bool									shouldUsePrecompiledHeader		= false;
+
+			/**
+			*	Headers to include in the precompiled header, as they would be written between the <> of an #include directive.
+			*	If empty, the <> includes shared by at least half of the processed files are used.
+			*/
+			std::unordered_set<std::string>			precompiledHeaderIncludes;
+
 			virtual ~ParsingSettings() = default;
 
 			/**
@@ -241,6 +276,14 @@ namespace kodgen
 			*/
 			std::vector<char const*> const&					getCompilationArguments()							const	noexcept;
 
+			/**
+			*	@brief	Set the precompiled header included before each parsed file.
+			*			The precompiled header is reset by init, so it must be set after each init call.
+			*
+			*	@param precompiledHeaderPath Path to the precompiled header, or an empty path to parse files without precompiled header.
+			*/
+			void											setPrecompiledHeader(fs::path const& precompiledHeaderPath)	noexcept;
+
 			/**
 			*	@brief	Setter for _compilerExeName field.
 			*			This will also check that the compiler is indeed available on the running computer.
@@ -250,5 +293,13 @@ namespace kodgen
 			*	@return true if the compiler is valid on the running computer, else false.
 			*/
 			bool											setCompilerExeName(std::string const& compilerExeName)		noexcept;
+
+			/**
+			*	@brief	Compute a fingerprint of all the settings affecting parsing results.
+			*			Two settings instances with the same fingerprint produce the same parsing results on the same files.
+			*	
+			*	@return The fingerprint of these settings.
+			*/
+			uint64											computeFingerprint()								const	noexcept;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+
+#include <clang-c/Index.h>
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Translation units kept alive between parsings of the same files, so that a file parsed again is incrementally
+	*	reparsed by libclang instead of being parsed from scratch. Translation units are parsed with a precompiled preamble,
+	*	making the reparsing of a file whose includes didn't change much cheaper.
+	*	Each cached translation unit keeps its whole AST in memory, so the least recently used translation units
+	*	are disposed when more translation units than the capacity of the cache are alive.
+	*/
+	class TranslationUnitCache
+	{
+		private:
+			struct CachedTranslationUnit
+			{
+				/** Index owning the translation unit. */
+				CXIndex				index			= nullptr;
+
+				/** The cached translation unit. */
+				CXTranslationUnit	translationUnit	= nullptr;
+
+				/** Fingerprint of the compilation arguments and options the translation unit has been parsed with. */
+				uint64				fingerprint		= 0u;
+
+				/** Value of the use counter of the cache when the translation unit was last released. */
+				uint64				lastUse			= 0u;
+			};
+
+			/** Maximum number of translation units alive at once, being used or not. */
+			uint32																	_capacity;
+
+			/** Counter incremented each time a translation unit is released, ordering the uses of translation units. */
+			uint64																	_useCounter = 0u;
+
+			/** Mutex used to synchronize accesses to the cached translation units. */
+			std::mutex																_mutex;
+
+			/** Translation units which are not being used, by parsed file. */
+			std::unordered_map<fs::path, CachedTranslationUnit, PathHash>			_translationUnits;
+
+			/** Translation units being used, by translation unit. */
+			std::unordered_map<CXTranslationUnit, CachedTranslationUnit>			_acquiredTranslationUnits;
+
+			/**
+			*	@brief	Compute the fingerprint of compilation arguments and parsing options.
+			*			Precompiled headers are rebuilt in place, so their last write time is part of the fingerprint.
+			*
+			*	@param compilationArguments	Compilation arguments to compute the fingerprint of.
+			*	@param parsingOptions		Options used to parse a new translation unit.
+			*
+			*	@return The fingerprint of the compilation arguments and parsing options.
+			*/
+			static uint64	computeFingerprint(std::vector<char const*> const&	compilationArguments,
+											   unsigned							parsingOptions)			noexcept;
+
+			/**
+			*	@brief Dispose a translation unit and its index.
+			*
+			*	@param cachedTranslationUnit The translation unit to dispose.
+			*/
+			static void		dispose(CachedTranslationUnit& cachedTranslationUnit)						noexcept;
+
+		public:
+			/**
+			*	@param capacity Maximum number of translation units alive at once, being used or not.
+			*/
+			TranslationUnitCache(uint32 capacity = 32u)			noexcept;
+			TranslationUnitCache(TranslationUnitCache const&)	= delete;
+			TranslationUnitCache(TranslationUnitCache&&)		= delete;
+			~TranslationUnitCache()								noexcept;
+
+			/**
+			*	@brief	Get an up-to-date translation unit for a file, reparsing the cached one if it has been parsed with the same
+			*			compilation arguments, or parsing a new one otherwise.
+			*			The translation unit must be given back through release once it is not used anymore.
+			*
+			*	@param file					Path to the file to parse.
+			*	@param compilationArguments	Arguments used to parse the file.
+			*	@param parsingOptions		Options used to parse a new translation unit, combined with the precompiled preamble options.
+			*	@param unsavedFiles			In-memory contents overriding files on disk. Can be nullptr if unsavedFilesCount is 0.
+			*	@param unsavedFilesCount	Number of unsaved files.
+			*
+			*	@return The translation unit of the file, or nullptr if it could not be parsed.
+			*/
+			CXTranslationUnit	acquire(fs::path const&					file,
+										std::vector<char const*> const&	compilationArguments,
+										unsigned						parsingOptions,
+										CXUnsavedFile*					unsavedFiles		= nullptr,
+										unsigned						unsavedFilesCount	= 0u)	noexcept;
+
+			/**
+			*	@brief	Give back a translation unit previously returned by acquire so that it can be reparsed later.
+			*			The least recently used translation units which are not being used are disposed if the cache exceeds its capacity.
+			*
+			*	@param file				Path to the file the translation unit has been acquired for.
+			*	@param translationUnit	The translation unit to give back.
+			*/
+			void				release(fs::path const&		file,
+										CXTranslationUnit	translationUnit)						noexcept;
+
+			/**
+			*	@brief Dispose the cached translation units which are not being used, except the translation units of some files.
+			*
+			*	@param files Files to keep the translation unit of.
+			*/
+			void				retain(std::vector<fs::path> const& files)							noexcept;
+
+			/**
+			*	@brief Dispose all cached translation units which are not being used.
+			*/
+			void				clear()																noexcept;
+
+			/**
+			*	@brief Getter for the number of cached translation units which are not being used.
+			*
+			*	@return The number of cached translation units which are not being used.
+			*/
+			size_t				getCachedTranslationUnitsCount()									noexcept;
+
+			/**
+			*	@brief Getter for _capacity field.
+			*
+			*	@return _capacity.
+			*/
+			uint32				getCapacity()												const	noexcept;
+
+			TranslationUnitCache& operator=(TranslationUnitCache const&)	= delete;
+			TranslationUnitCache& operator=(TranslationUnitCache&&)			= delete;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>	//std::shared_ptr
+#include <unordered_map>
+#include <shared_mutex>
+
+#include <clang-c/Index.h>
+
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	/**
+	*	In-memory contents overriding the content of files on disk during parsing, for the parsed file as well as for any included file.
+	*	Files don't need to exist on disk, so the overlay can be used to parse editor buffers or synthetic headers.
+	*	Contents are shared, never copied: a content stays alive as long as a parsing using it is running, even if it is replaced or removed meanwhile.
+	*	All methods can be called from multiple threads at once.
+	*/
+	class UnsavedFileOverlay
+	{
+		public:
+			/**
+			*	Consistent view of the overlay at a given time, which can be provided to libclang.
+			*/
+			class Snapshot
+			{
+				friend UnsavedFileOverlay;
+
+				private:
+					/** Path of each file, referenced by _unsavedFiles. */
+					std::vector<std::shared_ptr<std::string const>>	_filenames;
+
+					/** Content of each file, referenced by _unsavedFiles. */
+					std::vector<std::shared_ptr<std::string const>>	_contents;
+
+					/** Unsaved files to provide to libclang. */
+					std::vector<CXUnsavedFile>						_unsavedFiles;
+
+				public:
+					/**
+					*	@brief Getter for the unsaved files to provide to libclang.
+					*
+					*	@return Pointer to the first unsaved file, or nullptr if the snapshot is empty.
+					*/
+					CXUnsavedFile*	getUnsavedFiles()			noexcept;
+
+					/**
+					*	@brief Getter for the number of unsaved files.
+					*
+					*	@return The number of unsaved files.
+					*/
+					unsigned		getUnsavedFilesCount()	const	noexcept;
+
+					/**
+					*	@brief Check whether the content of a file was overridden when the snapshot was taken.
+					*
+					*	@param normalizedFile Path to the file, normalized by UnsavedFileOverlay::normalizePath.
+					*
+					*	@return true if the snapshot contains the file, else false.
+					*/
+					bool			contains(fs::path const& normalizedFile)	const	noexcept;
+			};
+
+		private:
+			struct Entry
+			{
+				/** Normalized path of the file, as provided to libclang. */
+				std::shared_ptr<std::string const>	filename;
+
+				/** Content of the file. */
+				std::shared_ptr<std::string const>	content;
+			};
+
+			/** Mutex used to synchronize accesses to _entries. */
+			mutable std::shared_mutex						_mutex;
+
+			/** Content of each overlaid file, by normalized path. */
+			std::unordered_map<fs::path, Entry, PathHash>	_entries;
+
+		public:
+			/**
+			*	@brief	Normalize a path so that different paths to the same file refer to the same overlay entry.
+			*			Paths are made absolute, and symbolic links are resolved for the part of the path which exists on disk.
+			*
+			*	@param path The path to normalize.
+			*
+			*	@return The normalized path.
+			*/
+			static fs::path						normalizePath(fs::path const& path)						noexcept;
+
+			/**
+			*	@brief Override the content of a file, replacing any previous content.
+			*
+			*	@param file		Path to the file.
+			*	@param content	Content of the file. It is shared, not copied.
+			*/
+			void								setContent(fs::path const&						file,
+														   std::shared_ptr<std::string const>	content)	noexcept;
+
+			/**
+			*	@brief Override the content of a file, replacing any previous content.
+			*
+			*	@param file		Path to the file.
+			*	@param content	Content of the file. Move a string in to avoid any copy.
+			*/
+			void								setContent(fs::path const&	file,
+														   std::string		content)						noexcept;
+
+			/**
+			*	@brief Stop overriding the content of a file.
+			*
+			*	@param file Path to the file.
+			*
+			*	@return true if the content of the file was overridden, else false.
+			*/
+			bool								removeContent(fs::path const& file)						noexcept;
+
+			/**
+			*	@brief Stop overriding the content of all files.
+			*/
+			void								clear()													noexcept;
+
+			/**
+			*	@brief Get the content overriding a file.
+			*
+			*	@param file Path to the file.
+			*
+			*	@return The content of the file, or nullptr if its content is not overridden.
+			*/
+			std::shared_ptr<std::string const>	getContent(fs::path const& file)				const	noexcept;
+
+			/**
+			*	@brief Check whether the overlay is empty.
+			*
+			*	@return true if no file content is overridden, else false.
+			*/
+			bool								isEmpty()										const	noexcept;
+
+			/**
+			*	@brief Take a snapshot of the overlay to provide to libclang.
+			*
+			*	@return The snapshot.
+			*/
+			Snapshot							takeSnapshot()									const	noexcept;
+	};
+}
\ No newline at end of file
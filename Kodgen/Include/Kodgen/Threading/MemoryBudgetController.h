@@ -0,0 +1,129 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Limit the number of memory-hungry tasks running at once so that the memory of the process stays under a budget.
+	*	The memory used by a task is estimated by sampling the resident memory of the process each time a task is admitted
+	*	or completes, relative to the last sample taken while no task was running, so memory kept after tasks complete
+	*	is not attributed to later tasks. The number of admitted tasks is adapted to the headroom left by the memory which
+	*	is not used by running tasks: it decreases as the memory of the process grows, and increases again when memory
+	*	is released. At least one task is always admitted.
+	*/
+	class MemoryBudgetController
+	{
+		public:
+			/** Function returning the memory currently used by the process, in bytes. */
+			using MemorySampler = uint64 (*)();
+
+			/**
+			*	Admission of a task for the lifetime of the object: acquire on construction, release on destruction.
+			*	Does nothing if it is constructed without controller.
+			*/
+			class Admission
+			{
+				private:
+					/** Controller the task is admitted by, or nullptr. */
+					MemoryBudgetController*	_controller;
+
+				public:
+					/**
+					*	@brief Block the calling thread until the controller admits a new task.
+					*	
+					*	@param controller Controller admitting the task. If nullptr, the task is never blocked.
+					*/
+					explicit Admission(MemoryBudgetController* controller)	noexcept;
+					Admission(Admission const&)								= delete;
+					Admission(Admission&&)									= delete;
+					~Admission()											noexcept;
+
+					Admission& operator=(Admission const&)	= delete;
+					Admission& operator=(Admission&&)		= delete;
+			};
+
+		private:
+			/** Mutex used to synchronize accesses to all the other fields. */
+			mutable std::mutex		_mutex;
+
+			/** Condition used to notify tasks waiting to be admitted. */
+			std::condition_variable	_admissionCondition;
+
+			/** Function sampling the memory of the process. */
+			MemorySampler			_memorySampler;
+
+			/** Memory (in bytes) the process should stay under. */
+			uint64					_memoryBudget;
+
+			/** Memory (in bytes) used by the process the last time no task was running. */
+			uint64					_baselineMemory;
+
+			/** Estimated memory (in bytes) used by a single running task. 0 until the first sample with a running task. */
+			uint64					_taskMemoryEstimate	= 0u;
+
+			/** Maximum number of tasks admitted at once, whatever the memory headroom. */
+			uint32					_maxAdmittedCount;
+
+			/** Number of tasks currently admitted. */
+			uint32					_admittedCount		= 0u;
+
+			/** Number of tasks which can be admitted at once with the current memory estimate. */
+			uint32					_admittedLimit;
+
+			/**
+			*	@brief	Sample the memory of the process to refine the memory estimate of a task, and update the admitted limit.
+			*			Must be called with _mutex locked.
+			*/
+			void	sampleMemory()	noexcept;
+
+		public:
+			/**
+			*	@param memoryBudget		Memory (in bytes) the process should stay under.
+			*	@param maxAdmittedCount	Maximum number of tasks admitted at once, whatever the memory headroom. Must be at least 1.
+			*	@param memorySampler	Function sampling the memory of the process.
+			*/
+			MemoryBudgetController(uint64			memoryBudget,
+								   uint32			maxAdmittedCount,
+								   MemorySampler	memorySampler)					noexcept;
+			MemoryBudgetController(MemoryBudgetController const&)					= delete;
+			MemoryBudgetController(MemoryBudgetController&&)						= delete;
+
+			/**
+			*	@brief Block the calling thread until a new task can run within the memory budget, and admit it.
+			*/
+			void	acquire()														noexcept;
+
+			/**
+			*	@brief Notify that a task admitted through acquire completed, admitting waiting tasks if the memory headroom allows it.
+			*/
+			void	release()														noexcept;
+
+			/**
+			*	@brief Getter for the number of tasks which can currently be admitted at once.
+			*	
+			*	@return The number of tasks which can currently be admitted at once.
+			*/
+			uint32	getAdmittedLimit()										const	noexcept;
+
+			/**
+			*	@brief Getter for the estimated memory used by a single running task.
+			*	
+			*	@return The estimated memory (in bytes) used by a single running task, or 0 if no running task has been sampled yet.
+			*/
+			uint64	getTaskMemoryEstimate()									const	noexcept;
+
+			MemoryBudgetController& operator=(MemoryBudgetController const&)	= delete;
+			MemoryBudgetController& operator=(MemoryBudgetController&&)			= delete;
+	};
+}
\ No newline at end of file
@@ -37,9 +37,8 @@ namespace kodgen
 				 std::function<ReturnType(TaskBase*)>&&		task,
 				 std::vector<std::shared_ptr<TaskBase>>&&	deps = {})	noexcept;
 
-			virtual bool				isReadyToExecute()	const	noexcept override;
-			virtual void				execute()					noexcept override;
-			virtual bool				hasFinished()		const	noexcept override;
+			virtual void				execute()				noexcept override;
+			virtual bool				hasFinished()	const	noexcept override;
 	};
 
 	#include "Kodgen/Threading/Task.inl"
@@ -10,16 +10,52 @@
 #include <vector>
 #include <string>
 #include <memory>	//std::shared_ptr
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 namespace kodgen
 {
 	class TaskBase
 	{
 		friend class TaskHelper;
+		friend class ThreadPool;
 
 		private:
 			/** Name of the task. */
-			std::string	_name;
+			std::string								_name;
+
+			/** Number of dependencies which have not completed yet. The task is ready to execute when it reaches 0. */
+			std::atomic_uint						_remainingDependenciesCount;
+
+			/** Tasks depending on this task. They are notified when this task completes. */
+			std::vector<std::shared_ptr<TaskBase>>	_dependents;
+
+			/** Set to true once this task has executed and notified its dependents. */
+			bool									_isCompleted	= false;
+
+			/** Mutex used to synchronize _dependents and _isCompleted accesses. */
+			std::mutex								_dependentsMutex;
+
+			/** Condition used to notify threads waiting for this task to complete. */
+			std::condition_variable					_completionCondition;
+
+			/**
+			*	@brief	Register a task which must be notified when this task completes.
+			*			If this task has already completed, the dependent is not registered.
+			*	
+			*	@param dependent The task depending on this task.
+			*
+			*	@return true if the dependent has been registered, else false.
+			*/
+			bool									addDependent(std::shared_ptr<TaskBase> const& dependent)	noexcept;
+
+			/**
+			*	@brief Mark this task as completed and retrieve all registered dependents.
+			*	
+			*	@return The tasks which were waiting for this task to complete.
+			*/
+			std::vector<std::shared_ptr<TaskBase>>	complete()													noexcept;
 
 		protected:
 			/** Dependent tasks which must terminate before this task is executed. */
@@ -29,8 +65,8 @@ namespace kodgen
 			TaskBase()														= delete;
 			TaskBase(char const*								name,
 					 std::vector<std::shared_ptr<TaskBase>>&&	deps = {})	noexcept;
-			TaskBase(TaskBase const&)										= default;
-			TaskBase(TaskBase&&)											= default;
+			TaskBase(TaskBase const&)										= delete;
+			TaskBase(TaskBase&&)											= delete;
 			virtual ~TaskBase()												= default;
 
 			/**
@@ -39,7 +75,7 @@ namespace kodgen
 			*	
 			*	@return true if this task is ready to execute, else false.
 			*/
-			virtual bool		isReadyToExecute()	const	noexcept = 0;
+			virtual bool		isReadyToExecute()	const	noexcept;
 
 			/**
 			*	@brief Execute the underlying task.
@@ -53,6 +89,12 @@ namespace kodgen
 			*/
 			virtual bool		hasFinished()		const	noexcept = 0;
 
+			/**
+			*	@brief	Block the calling thread until this task has been executed by a thread pool and its dependents notified.
+			*			Must not be called from a task which doesn't depend on this task, since it would block a worker.
+			*/
+			void				wait()						noexcept;
+
 			/**
 			*	@brief Getter for _name field.
 			* 
@@ -60,7 +102,7 @@ namespace kodgen
 			*/
 			std::string const&	getName()			const	noexcept;
 
-			TaskBase& operator=(TaskBase const&)	= default;
-			TaskBase& operator=(TaskBase&&)			= default;
+			TaskBase& operator=(TaskBase const&)	= delete;
+			TaskBase& operator=(TaskBase&&)			= delete;
 	};
 }
\ No newline at end of file
@@ -33,6 +33,7 @@ namespace kodgen
 			/**
 			*	@brief	Retrieve the result from a TaskBase dependency.
 			*			If the provided return type doesn't match the task dependency result type, the program will crash.
+			*			Dependencies are released once the task has executed, so this must be called during the task execution.
 			*
 			*	@param task				The executing task.
 			*	@param dependencyIndex	Index of the dependency to retrieve the result of.
@@ -0,0 +1,61 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <memory>	//std::shared_ptr
+
+#include "Kodgen/Threading/TaskBase.h"
+
+namespace kodgen
+{
+	/**
+	*	Double-ended queue of ready-to-execute tasks.
+	*	The owner of the queue pushes and pops tasks from the back while other threads steal from the front.
+	*/
+	class TaskQueue
+	{
+		private:
+			/** Tasks contained in this queue. */
+			std::deque<std::shared_ptr<TaskBase>>	_tasks;
+
+			/** Mutex used to synchronize _tasks accesses. */
+			std::mutex								_mutex;
+
+		public:
+			/**
+			*	@brief Add a task at the back of the queue.
+			*	
+			*	@param task The task to add.
+			*/
+			void									pushBack(std::shared_ptr<TaskBase> task)	noexcept;
+
+			/**
+			*	@brief Remove the task at the back of the queue.
+			*	
+			*	@return The removed task if the queue was not empty, else an empty shared_ptr.
+			*/
+			std::shared_ptr<TaskBase>				popBack()									noexcept;
+
+			/**
+			*	@brief Remove the task at the front of the queue.
+			*	
+			*	@return The removed task if the queue was not empty, else an empty shared_ptr.
+			*/
+			std::shared_ptr<TaskBase>				popFront()									noexcept;
+
+			/**
+			*	@brief Remove all tasks from the queue.
+			*	
+			*	@return The removed tasks.
+			*/
+			std::vector<std::shared_ptr<TaskBase>>	clear()										noexcept;
+	};
+}
\ No newline at end of file
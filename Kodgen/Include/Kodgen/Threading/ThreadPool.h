@@ -8,7 +8,6 @@
 #pragma once
 
 #include <string>
-#include <list>
 #include <vector>
 #include <thread>
 #include <condition_variable>
@@ -16,9 +15,11 @@
 #include <atomic>		//std::atomic_uint
 #include <functional>	//std::bind
 #include <memory>		//std::shared_ptr
-#include <type_traits>	//std::invoke_result
+#include <type_traits>	//std::invoke_result, std::remove_reference_t
+#include <algorithm>		//std::min
 
 #include "Kodgen/Threading/Task.h"
+#include "Kodgen/Threading/TaskQueue.h"
 #include "Kodgen/Threading/ETerminationMode.h"
 #include "Kodgen/Misc/FundamentalTypes.h"
 
@@ -27,46 +28,116 @@ namespace kodgen
 	class ThreadPool
 	{
 		private:
+			/** Pool the current thread is a worker of, nullptr if the current thread is not a worker. */
+			static thread_local ThreadPool*				_currentPool;
+
+			/** Index of the current thread in the workers of _currentPool. */
+			static thread_local uint32					_currentWorkerIndex;
+
 			/** Are workers allowed to process queued tasks? */
-			bool									_isRunning	= true;
+			std::atomic_bool							_isRunning	= true;
 
 			/** Collection of all workers in this pool. */
-			std::vector<std::thread>				_workers;
+			std::vector<std::thread>					_workers;
+
+			/**
+			*	Ready-to-execute tasks of each worker, indexed like _workers.
+			*	Tasks made ready by a worker are pushed to its own queue, idle workers steal from the others.
+			*/
+			std::vector<std::unique_ptr<TaskQueue>>		_workerQueues;
 
-			/** List of all tasks. */
-			std::list<std::shared_ptr<TaskBase>>	_tasks;
+			/** Ready-to-execute tasks submitted from threads which are not workers of this pool. */
+			TaskQueue									_submittedTasks;
 
 			/** Set to true when the ThreadPool destructor has been called. */
-			bool									_destructorCalled	= false;
+			std::atomic_bool							_destructorCalled	= false;
 
 			/** Condition used to notify workers there are tasks to proceed. */
-			std::condition_variable					_taskCondition;
+			std::condition_variable						_taskCondition;
+
+			/** Condition used to notify threads waiting in joinWorkers that the pool may be idle. */
+			std::condition_variable						_idleCondition;
 
-			/** Mutex used with taskCondition. */
-			std::mutex								_taskMutex;
+			/** Mutex used with taskCondition and idleCondition. */
+			std::mutex									_taskMutex;
+
+			/** Number of threads currently waiting on _idleCondition. */
+			std::atomic_uint							_joiningThreads;
 
 			/** Number of workers currently running a task. */
-			std::atomic_uint						_workingWorkers;
+			std::atomic_uint							_workingWorkers;
+
+			/** Number of workers currently waiting on _taskCondition. */
+			std::atomic_uint							_sleepingWorkers;
+
+			/** Number of tasks queued in _workerQueues and _submittedTasks. */
+			std::atomic_uint							_readyTasksCount;
+
+			/** Number of submitted tasks which have not completed yet. */
+			std::atomic_uint							_unfinishedTasksCount;
 
 			/**
 			*	@brief Routine run by workers.
+			*
+			*	@param workerIndex Index of the worker running the routine.
 			*/
-			void						workerRoutine()				noexcept;
+			void						workerRoutine(uint32 workerIndex)					noexcept;
 
 			/**
 			*	@brief	Retrieve a task which is ready to execute.
-			*			This method doesn't lock the task mutex so make sure _tasks is safe to access BEFORE the method is called.
+			*			The worker's own queue is checked first, then submitted tasks, then other workers' queues.
+			*
+			*	@param workerIndex Index of the worker retrieving a task.
 			*	
 			*	@return A valid shared_ptr pointing to a ready-to-execute task if any, else an empty shared_ptr.
 			*/
-			std::shared_ptr<TaskBase>	getTask()					noexcept;
+			std::shared_ptr<TaskBase>	getTask(uint32 workerIndex)							noexcept;
+
+			/**
+			*	@brief	Register a newly created task to its dependencies.
+			*			The task is queued right away if it has no pending dependency.
+			*
+			*	@param task The newly created task.
+			*/
+			void						registerTask(std::shared_ptr<TaskBase> const& task)	noexcept;
+
+			/**
+			*	@brief Queue a ready-to-execute task and wake up a sleeping worker if any.
+			*
+			*	@param task The task to queue.
+			*/
+			void						pushReadyTask(std::shared_ptr<TaskBase> task)		noexcept;
+
+			/**
+			*	@brief Notify dependents of an executed task, queuing those which don't have pending dependencies anymore.
+			*
+			*	@param task The task which has just been executed.
+			*/
+			void						completeTask(std::shared_ptr<TaskBase> const& task)	noexcept;
+
+			/**
+			*	@brief Lock the task mutex before notifying a condition so that a thread about to wait on it can't miss the notification.
+			*
+			*	@param condition	Condition to notify, used with _taskMutex.
+			*	@param notifyAll	true to wake up all waiting threads, false to wake up a single thread.
+			*/
+			void						notify(std::condition_variable&	condition,
+											   bool						notifyAll)			noexcept;
+
+			/**
+			*	@brief	Check whether the pool is idle, i.e. no task is being executed and no task can be executed anymore.
+			*			Tasks can't be executed if the pool is not running.
+			*
+			*	@return true if the pool is idle, else false.
+			*/
+			bool						isIdle()									const	noexcept;
 
 			/**
 			*	@brief Check whether a worker should keep running or terminate.
 			*	
 			*	@return true if the worker should continue to poll new tasks, else false.
 			*/
-			bool						shouldKeepRunning()	const	noexcept;
+			bool						shouldKeepRunning()							const	noexcept;
 
 		public:
 			/** Termination mode to apply when this Thread pool will be destroyed. */
@@ -93,10 +164,33 @@ namespace kodgen
 												   std::vector<std::shared_ptr<TaskBase>>&& deps = {})	noexcept;
 
 			/**
-			*	@brief Join all workers.
+			*	@brief	Call a callable once for each index in [0, count[, spreading the calls over the workers of this pool.
+			*			The calling thread runs calls as well, so the method can be called from a worker of this pool:
+			*			it completes even if no other worker is available.
+			*			Calls are not ordered, so the callable must not depend on the order of the indices.
+			*
+			*	@param count	Number of calls.
+			*	@param callable	Callable taking the size_t index of the call.
+			*/
+			template <typename Callable>
+			void						parallelFor(size_t		count,
+													Callable&&	callable)									noexcept;
+
+			/**
+			*	@brief	Join all workers.
+			*			If the pool is not being destroyed, block until all submitted tasks have completed
+			*			(or until no task is executing if the pool is not running).
 			*/
 			void						joinWorkers()													noexcept;
 
+			/**
+			*	@brief	Block until all the provided tasks have completed, no matter whether other tasks are still pending.
+			*			Must not be called from a worker of this pool.
+			*
+			*	@param tasks Tasks to wait for. They must have been submitted to this pool.
+			*/
+			void						waitForTasks(std::vector<std::shared_ptr<TaskBase>> const& tasks)	noexcept;
+
 			/**
 			*	@brief Allow or disallow workers to process tasks.
 			* 
@@ -104,6 +198,20 @@ namespace kodgen
 			*/
 			void						setIsRunning(bool isRunning)									noexcept;
 
+			/**
+			*	@brief Getter for the number of workers of this pool.
+			*
+			*	@return The number of workers.
+			*/
+			uint32						getWorkerCount()										const	noexcept;
+
+			/**
+			*	@brief Get the index of the calling thread in the workers of this pool.
+			*
+			*	@return The index of the calling worker, in [0, getWorkerCount()[, or -1 if the calling thread is not a worker of this pool.
+			*/
+			int32						getCurrentWorkerIndex()									const	noexcept;
+
 			ThreadPool& operator=(ThreadPool const&)	= delete;
 			ThreadPool& operator=(ThreadPool&&)			= delete;
 	};
@@ -11,16 +11,77 @@ std::shared_ptr<TaskBase> ThreadPool::submitTask(std::string const& taskName, Ca
 	//Return type of the submitted task
 	using ReturnType = typename std::invoke_result_t<Callable, TaskBase*>;
 
-	std::vector<std::shared_ptr<TaskBase>> depsCopy = deps;
-
 	std::shared_ptr<Task<ReturnType>> newTask =
 		std::make_shared<Task<ReturnType>>(taskName.data(), std::forward<Callable>(callable), std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps));
 
-	_taskMutex.lock();
-	_tasks.emplace_back(newTask);
-	_taskMutex.unlock();
-
-	_taskCondition.notify_one();
+	registerTask(newTask);
 
 	return newTask;
+}
+
+template <typename Callable>
+void ThreadPool::parallelFor(size_t count, Callable&& callable) noexcept
+{
+	struct ParallelForState
+	{
+		/** Number of calls. */
+		size_t					count;
+
+		/** Index of the next call to run. */
+		std::atomic<size_t>		nextIndex;
+
+		/** Number of calls which have not completed yet. */
+		std::atomic<size_t>		remainingCount;
+
+		/** Mutex used with completedCondition. */
+		std::mutex				mutex;
+
+		/** Condition used to notify the calling thread that all calls have completed. */
+		std::condition_variable	completedCondition;
+	};
+
+	if (count == 0u)
+	{
+		return;
+	}
+
+	std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+	state->count			= count;
+	state->nextIndex		= 0u;
+	state->remainingCount	= count;
+
+	//The callable is only used by a thread which claimed an index, so it outlives its uses since the calling thread waits for all calls
+	auto runCalls = [](ParallelForState& state, std::remove_reference_t<Callable>& callable)
+	{
+		for (size_t index = state.nextIndex.fetch_add(1u); index < state.count; index = state.nextIndex.fetch_add(1u))
+		{
+			callable(index);
+
+			if (state.remainingCount.fetch_sub(1u) == 1u)
+			{
+				std::lock_guard lock(state.mutex);
+
+				state.completedCondition.notify_all();
+			}
+		}
+	};
+
+	std::remove_reference_t<Callable>* callablePointer = &callable;
+
+	//Helpers which start after all indices have been claimed return right away
+	size_t helpersCount = std::min<size_t>(count - 1u, _workers.size());
+
+	for (size_t i = 0u; i < helpersCount; i++)
+	{
+		submitTask("Parallel for", [state, callablePointer, runCalls](TaskBase*)
+		{
+			runCalls(*state, *callablePointer);
+		});
+	}
+
+	runCalls(*state, callable);
+
+	std::unique_lock lock(state->mutex);
+
+	state->completedCondition.wait(lock, [&state]() { return state->remainingCount.load() == 0u; });
 }
\ No newline at end of file
@@ -1,99 +1,444 @@
 #include "Kodgen/CodeGen/CodeGenManager.h"
 
+#include <fstream>
+#include <sstream>		//std::stringstream
+#include <algorithm>	//std::sort
+#include <iterator>	//std::istreambuf_iterator
+#include <unordered_set>
+
 #include "Kodgen/CodeGen/GeneratedFile.h"
 #include "Kodgen/Parsing/ParsingSettings.h"	//ParsingSettings::parsingMacro
+#include "Kodgen/Misc/Helpers.h"
+#include "Kodgen/Misc/System.h"
 
 using namespace kodgen;
 
+CodeGenManager::PipelineState::PipelineState(size_t fileCount) noexcept:
+	completedIterationsCount(fileCount, 0u),
+	pendingFilesCount(fileCount, 0u),
+	waitingFiles(fileCount)
+{
+	//Merged results only clear it
+	genResult.completed = true;
+}
+
 CodeGenManager::CodeGenManager(uint32 threadCount) noexcept:
 	_threadPool(getThreadCount(threadCount), ETerminationMode::FinishAll)
 {
 }
 
-std::set<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenUnit const& codeGenUnit, CodeGenResult& out_genResult, bool forceRegenerateAll) noexcept
+std::set<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenUnit const& codeGenUnit, GenerationManifest* manifest, IncludeDependencyGraph* dependencyGraph, CodeGenResult& out_genResult, bool forceRegenerateAll) noexcept
+{
+	std::set<fs::path>	result;
+	auto				start					= std::chrono::steady_clock::now();
+	float				upToDateCheckDuration	= 0.0f;
+
+	settings.foreachFileToProcess([&](fs::path const& file)
+	{
+		auto checkStart = std::chrono::steady_clock::now();
+
+		if (!isFileUpToDate(codeGenUnit, file, manifest, dependencyGraph) || forceRegenerateAll)
+		{
+			result.emplace(file);
+		}
+		else
+		{
+			out_genResult.upToDateFiles.push_back(file);
+		}
+
+		upToDateCheckDuration += std::chrono::duration<float>(std::chrono::steady_clock::now() - checkStart).count();
+	}, logger);
+
+	//Files are checked while the directories are scanned, so the scan is what remains
+	out_genResult.upToDateCheckDuration	+= upToDateCheckDuration;
+	out_genResult.directoryScanDuration	+= std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() - upToDateCheckDuration;
+
+	return result;
+}
+
+bool CodeGenManager::isFileUpToDate(CodeGenUnit const& codeGenUnit, fs::path const& file, GenerationManifest* manifest, IncludeDependencyGraph* dependencyGraph) noexcept
+{
+	bool isUpToDate;
+
+	if (manifest != nullptr)
+	{
+		//Always check the manifest first so that it keeps the content hash of outdated files
+		bool isContentUpToDate = manifest->checkUpToDate(file);
+
+		isUpToDate = codeGenUnit.hasGeneratedFiles(file) && isContentUpToDate;
+	}
+	else
+	{
+		isUpToDate = codeGenUnit.isUpToDate(file);
+	}
+
+	return isUpToDate && (dependencyGraph == nullptr || !dependencyGraph->haveDependenciesChanged(file));
+}
+
+uint64 CodeGenManager::computeGenerationFingerprint(ParsingSettings const& parsingSettings, CodeGenUnit const& codeGenUnit) noexcept
+{
+	//Rebuilding the generator or the Kodgen library it loads might change the generated code, so identify both binaries too
+	uint64 fingerprints[] =
+	{
+		parsingSettings.computeFingerprint(),
+		codeGenUnit.computeFingerprint(),
+		System::computeModuleFingerprint(nullptr),
+		System::computeModuleFingerprint(reinterpret_cast<void const*>(&CodeGenManager::computeGenerationFingerprint))
+	};
+
+	return Helpers::computeHash(fingerprints, sizeof(fingerprints));
+}
+
+uint32 CodeGenManager::getThreadCount(uint32 initialThreadCount) const noexcept
+{
+	return System::getThreadCount(initialThreadCount);
+}
+
+std::unique_ptr<MemoryBudgetController> CodeGenManager::createMemoryBudgetController() const noexcept
+{
+	constexpr uint64 const mebibyte = 1024u * 1024u;
+
+	uint64 memoryBudget = settings.memoryBudget * mebibyte;
+
+	if (memoryBudget == 0u)
+	{
+		//Keep some headroom below the limit, since going over it gets the process killed
+		memoryBudget = System::getMemoryLimit() / 10u * 9u;
+	}
+
+	if (memoryBudget == 0u || System::getResidentMemory() == 0u)
+	{
+		return nullptr;
+	}
+
+	if (logger != nullptr)
+	{
+		logger->log("Limit the number of files parsed at once to stay under " + std::to_string(memoryBudget / mebibyte) + "MiB.");
+	}
+
+	return std::make_unique<MemoryBudgetController>(memoryBudget, _threadPool.getWorkerCount(), &System::getResidentMemory);
+}
+
+void CodeGenManager::refreshGeneratedIncludesHashes(CachedFileParsingResult& inout_cachedParsingResult, std::vector<fs::path> const& outputDirectories) noexcept
 {
-	std::set<fs::path> result;
+	FileParsingResult& parsingResult = inout_cachedParsingResult.parsingResult;
+
+	inout_cachedParsingResult.generatedIncludesHashes.clear();
+	inout_cachedParsingResult.hasUnknownGeneratedInclude = false;
 
-	//Iterate over all "toParseFiles"
-	for (fs::path path : settings.getToProcessFiles())
+	for (fs::path const& includedFile : parsingResult.includedFiles)
 	{
-		if (fs::exists(path) && !fs::is_directory(path))
+		for (fs::path const& outputDirectory : outputDirectories)
 		{
-			if (!codeGenUnit.isUpToDate(path) || forceRegenerateAll)
+			if (FilesystemHelpers::isChildPath(includedFile, outputDirectory))
 			{
-				result.emplace(path);
+				auto it = parsingResult.includedFilesHashes.find(includedFile);
+
+				//Hashing the file now would miss a rewrite which happened while the file was parsed
+				if (it != parsingResult.includedFilesHashes.cend())
+				{
+					inout_cachedParsingResult.generatedIncludesHashes.emplace(includedFile, it->second);
+				}
+				else
+				{
+					inout_cachedParsingResult.hasUnknownGeneratedInclude = true;
+				}
+
+				break;
 			}
-			else
+		}
+	}
+}
+
+void CodeGenManager::updateIncludedFiles(FileParsingResult const& parsingResult, std::vector<fs::path> const& outputDirectories, ProcessedFile& inout_processedFile) noexcept
+{
+	inout_processedFile.includedFiles.clear();
+
+	for (fs::path const& includedFile : parsingResult.includedFiles)
+	{
+		bool isGeneratedFile = false;
+
+		for (fs::path const& outputDirectory : outputDirectories)
+		{
+			if (FilesystemHelpers::isChildPath(includedFile, outputDirectory))
 			{
-				out_genResult.upToDateFiles.push_back(path);
+				isGeneratedFile = true;
+				break;
 			}
 		}
-		else if (logger != nullptr)
+
+		if (!isGeneratedFile)
+		{
+			inout_processedFile.includedFiles.push_back(includedFile);
+		}
+	}
+}
+
+bool CodeGenManager::hasGeneratedIncludeChanged(CachedFileParsingResult const& cachedParsingResult) noexcept
+{
+	if (cachedParsingResult.hasUnknownGeneratedInclude)
+	{
+		return true;
+	}
+
+	for (auto const& [includedFile, hash] : cachedParsingResult.generatedIncludesHashes)
+	{
+		if (FilesystemHelpers::computeFileHash(includedFile) != hash)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+std::vector<size_t> CodeGenManager::getProcessedIncludes(FileParsingResult const& parsingResult, std::unordered_map<fs::path, size_t, PathHash> const& processedFileIndices) noexcept
+{
+	std::vector<size_t> result;
+
+	//Included files are unknown if the parsing failed, so wait for all files to be safe
+	if (!parsingResult.errors.empty())
+	{
+		result.reserve(processedFileIndices.size());
+
+		for (auto const& [file, index] : processedFileIndices)
+		{
+			result.push_back(index);
+		}
+	}
+	else
+	{
+		for (fs::path const& includedFile : parsingResult.includedFiles)
+		{
+			auto it = processedFileIndices.find(includedFile);
+
+			if (it != processedFileIndices.cend())
+			{
+				result.push_back(it->second);
+			}
+		}
+	}
+
+	return result;
+}
+
+std::vector<size_t> CodeGenManager::completeIteration(PipelineState& inout_pipelineState, size_t fileIndex, uint8 iterationCount, std::vector<size_t> const& processedIncludes) noexcept
+{
+	std::vector<size_t>	result;
+	std::lock_guard		lock(inout_pipelineState.mutex);
+
+	uint8					completedIterationsCount	= ++inout_pipelineState.completedIterationsCount[fileIndex];
+	std::vector<size_t>&	waitingFiles				= inout_pipelineState.waitingFiles[fileIndex];
+
+	//Notify files which were waiting for this file to complete their own current iteration
+	for (auto it = waitingFiles.begin(); it != waitingFiles.end();)
+	{
+		if (completedIterationsCount >= inout_pipelineState.completedIterationsCount[*it])
+		{
+			if (--inout_pipelineState.pendingFilesCount[*it] == 0u)
+			{
+				result.push_back(*it);
+			}
+
+			it = waitingFiles.erase(it);
+		}
+		else
+		{
+			it++;
+		}
+	}
+
+	if (completedIterationsCount < iterationCount)
+	{
+		//Wait for included files lagging behind, since their generated files could still be rewritten
+		for (size_t includedFileIndex : processedIncludes)
+		{
+			if (includedFileIndex != fileIndex && inout_pipelineState.completedIterationsCount[includedFileIndex] < completedIterationsCount)
+			{
+				inout_pipelineState.pendingFilesCount[fileIndex]++;
+				inout_pipelineState.waitingFiles[includedFileIndex].push_back(fileIndex);
+			}
+		}
+
+		if (inout_pipelineState.pendingFilesCount[fileIndex] == 0u)
+		{
+			result.push_back(fileIndex);
+		}
+	}
+
+	return result;
+}
+
+bool CodeGenManager::mightContainEntities(fs::path const& file, ParsingSettings const& parsingSettings, UnsavedFileOverlay const* unsavedFileOverlay) noexcept
+{
+	//Nested entities (fields, methods, enum values) are only parsed if their outer entity is parsed
+	if (parsingSettings.shouldParseAllNamespaces || parsingSettings.shouldParseAllClasses || parsingSettings.shouldParseAllStructs ||
+		parsingSettings.shouldParseAllVariables || parsingSettings.shouldParseAllFunctions || parsingSettings.shouldParseAllEnums)
+	{
+		return true;
+	}
+
+	std::shared_ptr<std::string const> content = (unsavedFileOverlay != nullptr) ? unsavedFileOverlay->getContent(file) : nullptr;
+
+	if (content == nullptr)
+	{
+		std::ifstream stream(file, std::ios::in | std::ios::binary);
+
+		if (!stream.is_open())
+		{
+			//Let the parser report the error
+			return true;
+		}
+
+		content = std::make_shared<std::string const>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	}
+
+	PropertyParsingSettings const& propertySettings = parsingSettings.propertyParsingSettings;
+
+	for (std::string const* macroName : {	&propertySettings.namespaceMacroName, &propertySettings.classMacroName,
+											&propertySettings.structMacroName, &propertySettings.variableMacroName,
+											&propertySettings.fieldMacroName, &propertySettings.functionMacroName,
+											&propertySettings.methodMacroName, &propertySettings.enumMacroName,
+											&propertySettings.enumValueMacroName })
+	{
+		if (!macroName->empty() && content->find(*macroName) != std::string::npos)
 		{
-			//Add FileGenerationFile invalid path
-			logger->log("File " + path.string() + " doesn't exist or is not a file. Skip.", ILogger::ELogSeverity::Warning);
+			return true;
 		}
 	}
 
-	//Iterate over all "toParseDirectories"
-	for (fs::path pathToIncludedDir : settings.getToProcessDirectories())
+	return false;
+}
+
+std::vector<std::string> CodeGenManager::detectCommonIncludes(std::set<fs::path> const& files) noexcept
+{
+	std::unordered_map<std::string, size_t> includeCounts;
+
+	for (fs::path const& file : files)
 	{
-		if (fs::exists(pathToIncludedDir) && fs::is_directory(pathToIncludedDir))
+		std::ifstream			stream(file);
+		std::string				line;
+		std::set<std::string>	fileIncludes;
+
+		while (std::getline(stream, line))
 		{
-			for (fs::recursive_directory_iterator directoryIt = fs::recursive_directory_iterator(pathToIncludedDir, fs::directory_options::follow_directory_symlink); directoryIt != fs::recursive_directory_iterator(); directoryIt++)
+			//Look for lines formatted as: # include <header>, with optional whitespaces
+			size_t position = line.find_first_not_of(" \t");
+
+			if (position == std::string::npos || line[position] != '#')
+			{
+				continue;
+			}
+
+			position = line.find_first_not_of(" \t", position + 1u);
+
+			if (position == std::string::npos || line.compare(position, 7u, "include") != 0)
+			{
+				continue;
+			}
+
+			position = line.find_first_not_of(" \t", position + 7u);
+
+			if (position != std::string::npos && line[position] == '<')
 			{
-				fs::directory_entry entry = *directoryIt;
+				size_t end = line.find('>', position);
 
-				//Just to make sure the entry hasn't been deleted since beginning of directory iteration
-				if (entry.exists())
+				if (end != std::string::npos)
 				{
-					if (entry.is_regular_file())
-					{
-						if (settings.isSupportedFileExtension(entry.path().extension()) && !settings.isIgnoredFile(entry.path()))
-						{
-							if (!codeGenUnit.isUpToDate(entry.path()) || forceRegenerateAll)
-							{
-								result.emplace(entry.path());
-							}
-							else
-							{
-								out_genResult.upToDateFiles.push_back(entry.path());
-							}
-						}
-					}
-					else if (entry.is_directory() && settings.isIgnoredDirectory(entry.path()))
-					{
-						//Don't iterate on ignored directory content
-						directoryIt.disable_recursion_pending();
-					}
+					fileIncludes.emplace(line.substr(position + 1u, end - position - 1u));
 				}
 			}
 		}
-		else if (logger != nullptr)
+
+		for (std::string const& include : fileIncludes)
 		{
-			//Add FileGenerationFile invalid path
-			logger->log("Directory " + pathToIncludedDir.string() + " is not a directory or doesn't exist. Skip.", ILogger::ELogSeverity::Warning);
+			includeCounts[include]++;
 		}
 	}
 
+	std::vector<std::string> result;
+
+	for (auto const& [include, count] : includeCounts)
+	{
+		if (count >= 2u && count * 2u >= files.size())
+		{
+			result.push_back(include);
+		}
+	}
+
+	std::sort(result.begin(), result.end());
+
 	return result;
 }
 
-uint32 CodeGenManager::getThreadCount(uint32 initialThreadCount) const noexcept
+void CodeGenManager::preparePrecompiledHeader(FileParser& fileParser, std::set<fs::path> const& files, fs::path const& stateDirectory) const noexcept
 {
-	if (initialThreadCount == 0)
+	ParsingSettings&			parsingSettings = fileParser.getSettings();
+	std::vector<std::string>	includes(parsingSettings.precompiledHeaderIncludes.cbegin(), parsingSettings.precompiledHeaderIncludes.cend());
+
+	if (includes.empty())
+	{
+		includes = detectCommonIncludes(files);
+	}
+	else
+	{
+		std::sort(includes.begin(), includes.end());
+	}
+
+	if (includes.empty())
+	{
+		return;
+	}
+
+	//The precompiled header must be rebuilt if the compilation arguments or the libclang version change, so write them in the header
+	uint64 argumentsHash = Helpers::computeHash(Helpers::getString(clang_getClangVersion()));
+
+	for (char const* argument : parsingSettings.getCompilationArguments())
+	{
+		argumentsHash = Helpers::computeHash(std::string(argument), argumentsHash);
+	}
+
+	std::stringstream headerContent;
+	headerContent << "//Generated by Kodgen, do not modify.\n//Compilation arguments hash: " << std::hex << argumentsHash << "\n";
+
+	for (std::string const& include : includes)
 	{
-		//Use hardware_concurrency if possible
-		initialThreadCount = std::thread::hardware_concurrency();
+		headerContent << "#include <" << include << ">\n";
+	}
+
+	fs::path				headerPath				= stateDirectory / "KodgenPrecompiledHeader.h";
+	fs::path				precompiledHeaderPath	= stateDirectory / "KodgenPrecompiledHeader.pch";
+	fs::path				dependencyGraphPath		= stateDirectory / "KodgenPrecompiledHeaderDependencies.txt";
+	IncludeDependencyGraph	dependencyGraph;
+	std::stringstream		previousHeaderContent;
+
+	previousHeaderContent << std::ifstream(headerPath).rdbuf();
+
+	//libclang rejects a precompiled header as soon as the last write time of any of its inputs changes, so don't compare contents
+	bool canReuse = fs::exists(precompiledHeaderPath) && previousHeaderContent.str() == headerContent.str() &&
+					dependencyGraph.loadFromFile(dependencyGraphPath) && !dependencyGraph.haveDependenciesChanged(headerPath, false);
 
-		//If hardware_concurrency hints to 0, use 8 threads
-		if (initialThreadCount == 0)
+	if (!canReuse)
+	{
+		std::vector<fs::path> includedFiles;
+
+		std::ofstream(headerPath, std::ios::out | std::ios::trunc) << headerContent.str();
+
+		if (!fileParser.buildPrecompiledHeader(headerPath, precompiledHeaderPath, includedFiles))
 		{
-			initialThreadCount = 8u;
+			if (logger != nullptr)
+			{
+				logger->log("Could not build the precompiled header " + precompiledHeaderPath.string() + ". Parse files without precompiled header.", ILogger::ELogSeverity::Warning);
+			}
+
+			return;
 		}
+
+		dependencyGraph.updateDependencies(headerPath, includedFiles);
+		dependencyGraph.saveToFile(dependencyGraphPath);
 	}
 
-	return initialThreadCount;
+	parsingSettings.setPrecompiledHeader(precompiledHeaderPath);
 }
 
 void CodeGenManager::generateMacrosFile(ParsingSettings const& parsingSettings, fs::path const& outputDirectory) const noexcept
@@ -150,4 +495,149 @@ bool CodeGenManager::checkGenerationSetup(FileParser const& /* fileParser */, Co
 	}
 	
 	return codeGenUnit.checkSettings();
+}
+
+bool CodeGenManager::checkOutputDirectories(std::vector<fs::path> const& outputDirectories) const noexcept
+{
+	for (size_t i = 0u; i < outputDirectories.size(); i++)
+	{
+		for (size_t j = i + 1u; j < outputDirectories.size(); j++)
+		{
+			//Generation units would overwrite the manifest, include dependencies and macros file of each other
+			if (outputDirectories[i].lexically_normal() == outputDirectories[j].lexically_normal())
+			{
+				if (logger != nullptr)
+				{
+					logger->log("Output directory " + outputDirectories[i].string() + " is used by several generation units, each generation unit must have its own output directory.", ILogger::ELogSeverity::Error);
+				}
+
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool CodeGenManager::flushGeneratedFiles(GeneratedFileWriter& writer, std::vector<fs::path> const& processedFiles, std::vector<ProcessedFile>& inout_processedFilesStates) const noexcept
+{
+	std::vector<fs::path> failedFiles = writer.flush();
+
+	if (failedFiles.empty())
+	{
+		return true;
+	}
+
+	std::unordered_set<fs::path, PathHash> failedFilesSet;
+
+	for (fs::path const& failedFile : failedFiles)
+	{
+		failedFilesSet.insert(failedFile.lexically_normal());
+
+		if (logger != nullptr)
+		{
+			logger->log("Could not write the code generated for " + failedFile.string() + ".", ILogger::ELogSeverity::Error);
+		}
+	}
+
+	//The writer is shared by all generation units, so the file is failed for all of them
+	for (size_t i = 0u; i < processedFiles.size(); i++)
+	{
+		if (failedFilesSet.count(processedFiles[i].lexically_normal()) != 0u)
+		{
+			for (FileGeneration& generation : inout_processedFilesStates[i].generations)
+			{
+				if (generation.shouldGenerate)
+				{
+					generation.isGenerationSuccessful = false;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+fs::path CodeGenManager::getStateDirectory(fs::path const& outputDirectory) const noexcept
+{
+	fs::path const& stateDirectory = settings.getStateDirectory();
+
+	if (stateDirectory.empty())
+	{
+		return outputDirectory;
+	}
+
+	//Generation units must not share their files, so each one gets a subdirectory named after its output directory
+	std::ostringstream unitDirectoryName;
+	unitDirectoryName << outputDirectory.filename().string() << "-" << std::hex << Helpers::computeHash(outputDirectory.string());
+
+	fs::path		unitStateDirectory = stateDirectory / unitDirectoryName.str();
+	std::error_code	error;
+
+	fs::create_directories(unitStateDirectory, error);
+
+	if (error && logger != nullptr)
+	{
+		logger->log("Could not create the state directory " + unitStateDirectory.string() + ".", ILogger::ELogSeverity::Warning);
+	}
+
+	return unitStateDirectory;
+}
+
+void CodeGenManager::saveGenerationUnitState(GenerationUnitState& inout_unitState, size_t codeGenUnitIndex, fs::path const& stateDirectory, std::vector<fs::path> const& processedFiles, std::vector<ProcessedFile> const& processedFilesStates) const noexcept
+{
+	if (settings.shouldUseGenerationManifest)
+	{
+		fs::path manifestPath = stateDirectory / GenerationManifest::filename;
+
+		//Files whose generation failed must be processed again by the next run
+		for (size_t i = 0u; i < processedFiles.size(); i++)
+		{
+			FileGeneration const& generation = processedFilesStates[i].generations[codeGenUnitIndex];
+
+			if (generation.shouldGenerate)
+			{
+				if (generation.isGenerationSuccessful)
+				{
+					inout_unitState.manifest.markGenerated(processedFiles[i]);
+				}
+				else
+				{
+					inout_unitState.manifest.markOutdated(processedFiles[i]);
+				}
+			}
+		}
+
+		if (!inout_unitState.manifest.saveToFile(manifestPath) && logger != nullptr)
+		{
+			logger->log("Could not save the generation manifest to " + manifestPath.string() + ".", ILogger::ELogSeverity::Warning);
+		}
+	}
+
+	if (settings.shouldTrackIncludeDependencies)
+	{
+		fs::path dependencyGraphPath = stateDirectory / IncludeDependencyGraph::filename;
+
+		for (size_t i = 0u; i < processedFiles.size(); i++)
+		{
+			FileGeneration const& generation = processedFilesStates[i].generations[codeGenUnitIndex];
+
+			if (generation.shouldGenerate)
+			{
+				if (generation.isGenerationSuccessful)
+				{
+					inout_unitState.dependencyGraph.updateDependencies(processedFiles[i], processedFilesStates[i].includedFiles);
+				}
+				else
+				{
+					inout_unitState.dependencyGraph.removeDependencies(processedFiles[i]);
+				}
+			}
+		}
+
+		if (!inout_unitState.dependencyGraph.saveToFile(dependencyGraphPath) && logger != nullptr)
+		{
+			logger->log("Could not save include dependencies to " + dependencyGraphPath.string() + ".", ILogger::ELogSeverity::Warning);
+		}
+	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Kodgen/Misc/TomlUtility.h"
 #include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/Helpers.h"
 
 using namespace kodgen;
 
@@ -40,6 +41,19 @@ bool CodeGenManagerSettings::loadSettingsValues(toml::value const& tomlData, ILo
 		loadToProcessDirectories(tomlGeneratorSettings, logger);
 		loadIgnoredFiles(tomlGeneratorSettings, logger);
 		loadIgnoredDirectories(tomlGeneratorSettings, logger);
+		loadShouldReuseParsingResults(tomlGeneratorSettings, logger);
+		loadShouldPipelineIterations(tomlGeneratorSettings, logger);
+		loadShouldProcessLongestFilesFirst(tomlGeneratorSettings, logger);
+		loadShouldUseGenerationManifest(tomlGeneratorSettings, logger);
+		loadShouldTrackIncludeDependencies(tomlGeneratorSettings, logger);
+		loadShouldSkipFilesWithoutAnnotations(tomlGeneratorSettings, logger);
+		loadShouldReuseWorkerInstances(tomlGeneratorSettings, logger);
+		loadShouldWriteFilesAsynchronously(tomlGeneratorSettings, logger);
+		loadGeneratedFilesQueueDepth(tomlGeneratorSettings, logger);
+		loadShouldSplitLargeFiles(tomlGeneratorSettings, logger);
+		loadMinEntitiesPerShard(tomlGeneratorSettings, logger);
+		loadMemoryBudget(tomlGeneratorSettings, logger);
+		loadStateDirectory(tomlGeneratorSettings, logger);
 
 		return true;
 	}
@@ -178,6 +192,57 @@ bool CodeGenManagerSettings::isIgnoredDirectory(fs::path const& directory) noexc
 	return _ignoredDirectories.find(fs::exists(directory) ? FilesystemHelpers::sanitizePath(directory) : directory) != _ignoredDirectories.end();
 }
 
+void CodeGenManagerSettings::foreachFileToProcess(std::function<void(fs::path const&)> const& visitor, ILogger* logger) noexcept
+{
+	//Iterate over all "toParseFiles"
+	for (fs::path const& path : getToProcessFiles())
+	{
+		if (fs::exists(path) && !fs::is_directory(path))
+		{
+			visitor(path);
+		}
+		else if (logger != nullptr)
+		{
+			//Add FileGenerationFile invalid path
+			logger->log("File " + path.string() + " doesn't exist or is not a file. Skip.", ILogger::ELogSeverity::Warning);
+		}
+	}
+
+	//Iterate over all "toParseDirectories"
+	for (fs::path const& pathToIncludedDir : getToProcessDirectories())
+	{
+		if (fs::exists(pathToIncludedDir) && fs::is_directory(pathToIncludedDir))
+		{
+			for (fs::recursive_directory_iterator directoryIt = fs::recursive_directory_iterator(pathToIncludedDir, fs::directory_options::follow_directory_symlink); directoryIt != fs::recursive_directory_iterator(); directoryIt++)
+			{
+				fs::directory_entry entry = *directoryIt;
+
+				//Just to make sure the entry hasn't been deleted since beginning of directory iteration
+				if (entry.exists())
+				{
+					if (entry.is_regular_file())
+					{
+						if (isSupportedFileExtension(entry.path().extension()) && !isIgnoredFile(entry.path()))
+						{
+							visitor(entry.path());
+						}
+					}
+					else if (entry.is_directory() && isIgnoredDirectory(entry.path()))
+					{
+						//Don't iterate on ignored directory content
+						directoryIt.disable_recursion_pending();
+					}
+				}
+			}
+		}
+		else if (logger != nullptr)
+		{
+			//Add FileGenerationFile invalid path
+			logger->log("Directory " + pathToIncludedDir.string() + " is not a directory or doesn't exist. Skip.", ILogger::ELogSeverity::Warning);
+		}
+	}
+}
+
 void CodeGenManagerSettings::loadSupportedFileExtensions(toml::value const& generationSettings, ILogger* logger) noexcept
 {
 	//Clear supported extensions before loading
@@ -322,6 +387,124 @@ void CodeGenManagerSettings::loadIgnoredDirectories(toml::value const& generatio
 	}
 }
 
+void CodeGenManagerSettings::loadShouldReuseParsingResults(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldReuseParsingResults", shouldReuseParsingResults, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldReuseParsingResults: " + Helpers::toString(shouldReuseParsingResults));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldPipelineIterations(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldPipelineIterations", shouldPipelineIterations, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldPipelineIterations: " + Helpers::toString(shouldPipelineIterations));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldProcessLongestFilesFirst(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldProcessLongestFilesFirst", shouldProcessLongestFilesFirst, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldProcessLongestFilesFirst: " + Helpers::toString(shouldProcessLongestFilesFirst));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldUseGenerationManifest(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldUseGenerationManifest", shouldUseGenerationManifest, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldUseGenerationManifest: " + Helpers::toString(shouldUseGenerationManifest));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldTrackIncludeDependencies(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldTrackIncludeDependencies", shouldTrackIncludeDependencies, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldTrackIncludeDependencies: " + Helpers::toString(shouldTrackIncludeDependencies));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldSkipFilesWithoutAnnotations(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldSkipFilesWithoutAnnotations", shouldSkipFilesWithoutAnnotations, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldSkipFilesWithoutAnnotations: " + Helpers::toString(shouldSkipFilesWithoutAnnotations));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldReuseWorkerInstances(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldReuseWorkerInstances", shouldReuseWorkerInstances, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldReuseWorkerInstances: " + Helpers::toString(shouldReuseWorkerInstances));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldWriteFilesAsynchronously(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldWriteFilesAsynchronously", shouldWriteFilesAsynchronously, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldWriteFilesAsynchronously: " + Helpers::toString(shouldWriteFilesAsynchronously));
+	}
+}
+
+void CodeGenManagerSettings::loadGeneratedFilesQueueDepth(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "generatedFilesQueueDepth", generatedFilesQueueDepth, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load generatedFilesQueueDepth: " + std::to_string(generatedFilesQueueDepth));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldSplitLargeFiles(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldSplitLargeFiles", shouldSplitLargeFiles, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldSplitLargeFiles: " + Helpers::toString(shouldSplitLargeFiles));
+	}
+}
+
+void CodeGenManagerSettings::loadMinEntitiesPerShard(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "minEntitiesPerShard", minEntitiesPerShard, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load minEntitiesPerShard: " + std::to_string(minEntitiesPerShard));
+	}
+}
+
+void CodeGenManagerSettings::loadMemoryBudget(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "memoryBudget", memoryBudget, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load memoryBudget: " + std::to_string(memoryBudget));
+	}
+}
+
+void CodeGenManagerSettings::loadStateDirectory(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	std::string loadedStateDirectory;
+
+	if (TomlUtility::updateSetting(generationSettings, "stateDirectory", loadedStateDirectory, logger))
+	{
+		bool success = setStateDirectory(loadedStateDirectory);
+
+		if (logger != nullptr)
+		{
+			if (success)
+			{
+				logger->log("[TOML] Load state directory: " + getStateDirectory().string());
+			}
+			else
+			{
+				logger->log("[TOML] Failed to load stateDirectory, file or invalid path: " + loadedStateDirectory);
+			}
+		}
+	}
+}
+
 std::unordered_set<fs::path, PathHash> const& CodeGenManagerSettings::getToProcessFiles() const noexcept
 {
 	return _toProcessFiles;
@@ -345,4 +528,46 @@ std::unordered_set<fs::path, PathHash> const& CodeGenManagerSettings::getIgnored
 std::unordered_set<std::string> const& CodeGenManagerSettings::getSupportedExtensions() const noexcept
 {
 	return _supportedFileExtensions;
+}
+
+bool CodeGenManagerSettings::setStateDirectory(fs::path stateDirectory) noexcept
+{
+	if (stateDirectory.empty())
+	{
+		_stateDirectory.clear();
+
+		return true;
+	}
+
+	stateDirectory.make_preferred();
+
+	if (fs::exists(stateDirectory))
+	{
+		//The path must not point to a file
+		if (!fs::is_directory(stateDirectory))
+		{
+			return false;
+		}
+
+		_stateDirectory = FilesystemHelpers::sanitizePath(stateDirectory);
+	}
+	else //the directory will be created when needed
+	{
+		std::error_code error;
+		stateDirectory = fs::absolute(stateDirectory, error);
+
+		if (error)
+		{
+			return false;
+		}
+
+		_stateDirectory = stateDirectory;
+	}
+
+	return true;
+}
+
+fs::path const& CodeGenManagerSettings::getStateDirectory() const noexcept
+{
+	return _stateDirectory;
 }
\ No newline at end of file
@@ -18,13 +18,24 @@ int32 CodeGenModule::getGenerationOrder() const noexcept
 	return (*it)->getIterationCount();
 }
 
+bool CodeGenModule::requiresIterationBarrier() const noexcept
+{
+	return std::any_of(_propertyCodeGenerators.cbegin(), _propertyCodeGenerators.cend(),
+					   [](PropertyCodeGen* const& propertyCodeGen)
+					   {
+						   return propertyCodeGen->requiresIterationBarrier();
+					   });
+}
+
 ETraversalBehaviour CodeGenModule::generateCodeForEntity(EntityInfo const& entity, CodeGenEnv& env, std::string& inout_result, void const* /* data */) noexcept
 {
 	return generateCodeForEntity(entity, env, inout_result);
 }
 
-void CodeGenModule::addPropertyCodeGen(PropertyCodeGen& propertyCodeGen) noexcept
+void CodeGenModule::registerPropertyCodeGen(PropertyCodeGen& propertyCodeGen, bool isDispatchedByPropertyName) noexcept
 {
+	propertyCodeGen._isDispatchedByPropertyName = isDispatchedByPropertyName;
+
 	_propertyCodeGenerators.push_back(&propertyCodeGen);
 }
 
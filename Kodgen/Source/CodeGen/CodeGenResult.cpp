@@ -5,7 +5,14 @@ using namespace kodgen;
 void CodeGenResult::mergeResult(CodeGenResult&& otherResult) noexcept
 {
 	parsedFiles.insert(parsedFiles.cend(), std::make_move_iterator(otherResult.parsedFiles.cbegin()), std::make_move_iterator(otherResult.parsedFiles.cend()));
+	skippedFiles.insert(skippedFiles.cend(), std::make_move_iterator(otherResult.skippedFiles.cbegin()), std::make_move_iterator(otherResult.skippedFiles.cend()));
 	upToDateFiles.insert(upToDateFiles.cend(), std::make_move_iterator(otherResult.upToDateFiles.cbegin()), std::make_move_iterator(otherResult.upToDateFiles.cend()));
+	fileTimings.insert(fileTimings.cend(), std::make_move_iterator(otherResult.fileTimings.begin()), std::make_move_iterator(otherResult.fileTimings.end()));
+
+	directoryScanDuration			+= otherResult.directoryScanDuration;
+	upToDateCheckDuration			+= otherResult.upToDateCheckDuration;
+	settingsInitDuration			+= otherResult.settingsInitDuration;
+	macrosFileGenerationDuration	+= otherResult.macrosFileGenerationDuration;
 
 	completed &= otherResult.completed;
 }
\ No newline at end of file
@@ -0,0 +1,325 @@
+#include "Kodgen/CodeGen/CodeGenServer.h"
+
+#include <cstring>	//std::memset, std::strncpy, std::strerror
+#include <cerrno>
+
+#if !_WIN32
+#include <sys/socket.h>
+#include <sys/time.h>	//timeval
+#include <sys/un.h>		//sockaddr_un
+#include <unistd.h>		//close
+#endif
+
+using namespace kodgen;
+
+#if !_WIN32
+namespace
+{
+	/**
+	*	@brief Fill the address of a local socket file.
+	*
+	*	@param socketPath	Path to the socket file.
+	*	@param out_address	Address to fill.
+	*
+	*	@return false if the path is too long to be a socket address, else true.
+	*/
+	bool makeSocketAddress(fs::path const& socketPath, sockaddr_un& out_address) noexcept
+	{
+		std::string path = socketPath.string();
+
+		if (path.size() >= sizeof(out_address.sun_path))
+		{
+			return false;
+		}
+
+		std::memset(&out_address, 0, sizeof(out_address));
+		out_address.sun_family = AF_UNIX;
+		std::strncpy(out_address.sun_path, path.c_str(), sizeof(out_address.sun_path) - 1u);
+
+		return true;
+	}
+
+	/**
+	*	@brief Send a whole string through a socket.
+	*
+	*	@param socket	Socket to send the string through.
+	*	@param data		String to send.
+	*
+	*	@return true if the whole string has been sent, else false.
+	*/
+	bool sendAll(int socket, std::string const& data) noexcept
+	{
+#ifdef MSG_NOSIGNAL
+		constexpr int const flags = MSG_NOSIGNAL;	//Don't get killed by SIGPIPE if the peer closed the connection
+#else
+		constexpr int const flags = 0;
+#endif
+
+		size_t sentSize = 0u;
+
+		while (sentSize < data.size())
+		{
+			ssize_t result = send(socket, data.data() + sentSize, data.size() - sentSize, flags);
+
+			if (result <= 0)
+			{
+				return false;
+			}
+
+			sentSize += static_cast<size_t>(result);
+		}
+
+		return true;
+	}
+}
+#endif
+
+CodeGenServer::CodeGenServer(CodeGenManager& codeGenManager) noexcept:
+	_codeGenManager{codeGenManager}
+{
+}
+
+CodeGenServer::~CodeGenServer() noexcept
+{
+	stopListening();
+}
+
+bool CodeGenServer::startListening(fs::path const& socketPath) noexcept
+{
+#if _WIN32
+	(void)socketPath;
+
+	if (logger != nullptr)
+	{
+		logger->log("The code generation server is not supported on this platform.", ILogger::ELogSeverity::Error);
+	}
+
+	return false;
+#else
+	sockaddr_un address;
+
+	if (!makeSocketAddress(socketPath, address))
+	{
+		if (logger != nullptr)
+		{
+			logger->log("Socket path " + socketPath.string() + " is too long.", ILogger::ELogSeverity::Error);
+		}
+
+		return false;
+	}
+
+	//Don't take the place of a running server
+	std::string response;
+	std::error_code error;
+
+	if (fs::exists(socketPath, error))
+	{
+		if (sendRequest(socketPath, "", response))
+		{
+			if (logger != nullptr)
+			{
+				logger->log("A code generation server is already listening to " + socketPath.string() + ".", ILogger::ELogSeverity::Error);
+			}
+
+			return false;
+		}
+
+		//Socket file left by a server which didn't stop properly
+		fs::remove(socketPath, error);
+	}
+
+	_listeningSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (_listeningSocket == -1 ||
+		bind(_listeningSocket, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 ||
+		listen(_listeningSocket, SOMAXCONN) != 0)
+	{
+		if (logger != nullptr)
+		{
+			logger->log("Could not listen to " + socketPath.string() + ": " + std::strerror(errno), ILogger::ELogSeverity::Error);
+		}
+
+		stopListening();
+
+		return false;
+	}
+
+	_socketPath = socketPath;
+
+	if (logger != nullptr)
+	{
+		logger->log("Code generation server listening to " + socketPath.string() + ".");
+	}
+
+	return true;
+#endif
+}
+
+void CodeGenServer::stopListening() noexcept
+{
+#if !_WIN32
+	if (_listeningSocket != -1)
+	{
+		close(_listeningSocket);
+		_listeningSocket = -1;
+	}
+
+	if (!_socketPath.empty())
+	{
+		std::error_code error;
+		fs::remove(_socketPath, error);
+
+		_socketPath.clear();
+	}
+#endif
+}
+
+bool CodeGenServer::receiveRequest(int& out_clientSocket, std::string& out_request) noexcept
+{
+	out_clientSocket = -1;
+	out_request.clear();
+
+#if _WIN32
+	return false;
+#else
+	constexpr size_t const maxRequestSize = 4096u;
+
+	int clientSocket = accept(_listeningSocket, nullptr, nullptr);
+
+	if (clientSocket == -1)
+	{
+		//Interrupted or aborted connections don't prevent from receiving the next requests
+		return errno == EINTR || errno == ECONNABORTED;
+	}
+
+	//Don't let an idle client block the server
+	timeval timeout{5, 0};
+	setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+	char buffer[256];
+
+	while (out_request.find('\n') == std::string::npos && out_request.size() < maxRequestSize)
+	{
+		ssize_t receivedSize = recv(clientSocket, buffer, sizeof(buffer), 0);
+
+		if (receivedSize <= 0)
+		{
+			break;
+		}
+
+		out_request.append(buffer, static_cast<size_t>(receivedSize));
+	}
+
+	size_t lineEnd = out_request.find_first_of("\r\n");
+
+	if (lineEnd == std::string::npos)
+	{
+		//Connections closed without sending a request only check that a server is running
+		close(clientSocket);
+
+		return true;
+	}
+
+	out_request.resize(lineEnd);
+	out_clientSocket = clientSocket;
+
+	return true;
+#endif
+}
+
+void CodeGenServer::sendResponse(int clientSocket, std::string const& response) noexcept
+{
+#if _WIN32
+	(void)clientSocket;
+	(void)response;
+#else
+	sendAll(clientSocket, response);
+
+	close(clientSocket);
+#endif
+}
+
+std::string CodeGenServer::formatResponse(CodeGenResult const& genResult) noexcept
+{
+	std::string response = (genResult.completed ? "completed " : "failed ") + std::to_string(genResult.duration) + "\n";
+
+	for (fs::path const& parsedFile : genResult.parsedFiles)
+	{
+		response += "parsed " + parsedFile.string() + "\n";
+	}
+
+	for (fs::path const& skippedFile : genResult.skippedFiles)
+	{
+		response += "skipped " + skippedFile.string() + "\n";
+	}
+
+	return response;
+}
+
+void CodeGenServer::retainProcessedFiles(TranslationUnitCache& translationUnitCache, UnsavedFileOverlay const* unsavedFileOverlay, CodeGenResult const& genResult) noexcept
+{
+	std::vector<fs::path> processedFiles;
+
+	for (std::vector<fs::path> const* files : { &genResult.parsedFiles, &genResult.skippedFiles, &genResult.upToDateFiles })
+	{
+		for (fs::path const& file : *files)
+		{
+			processedFiles.push_back(file);
+
+			if (unsavedFileOverlay != nullptr)
+			{
+				processedFiles.push_back(UnsavedFileOverlay::normalizePath(file));
+			}
+		}
+	}
+
+	translationUnitCache.retain(processedFiles);
+}
+
+bool CodeGenServer::sendRequest(fs::path const& socketPath, std::string const& request, std::string& out_response) noexcept
+{
+	out_response.clear();
+
+#if _WIN32
+	(void)socketPath;
+	(void)request;
+
+	return false;
+#else
+	sockaddr_un address;
+
+	if (!makeSocketAddress(socketPath, address))
+	{
+		return false;
+	}
+
+	int serverSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (serverSocket == -1)
+	{
+		return false;
+	}
+
+	bool isSuccess = connect(serverSocket, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) == 0;
+
+	//An empty request closes the connection without sending anything
+	if (isSuccess && !request.empty())
+	{
+		isSuccess = sendAll(serverSocket, request + "\n");
+
+		char	buffer[4096];
+		ssize_t	receivedSize;
+
+		while (isSuccess && (receivedSize = recv(serverSocket, buffer, sizeof(buffer), 0)) > 0)
+		{
+			out_response.append(buffer, static_cast<size_t>(receivedSize));
+		}
+
+		isSuccess = isSuccess && !out_response.empty();
+	}
+
+	close(serverSocket);
+
+	return isSuccess;
+#endif
+}
\ No newline at end of file
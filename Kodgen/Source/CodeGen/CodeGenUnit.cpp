@@ -1,9 +1,12 @@
 #include "Kodgen/CodeGen/CodeGenUnit.h"
 
 #include <algorithm>
+#include <typeinfo>
+#include <chrono>	//std::chrono::steady_clock
 
 #include "Kodgen/CodeGen/CodeGenHelpers.h"
 #include "Kodgen/CodeGen/PropertyCodeGen.h"
+#include "Kodgen/Misc/Helpers.h"
 
 #define HANDLE_NESTED_ENTITY_ITERATION_RESULT(result)																\
 	if (result == ETraversalBehaviour::Break)																		\
@@ -17,10 +20,69 @@
 
 using namespace kodgen;
 
+namespace
+{
+	/**
+	*	@brief Append entities of the same kind and the same outer entity to the shard entities of a file.
+	* 
+	*	@param entities			Entities to append.
+	*	@param outerEntityTypes	Mask of the types of all the outer entities of the entities.
+	*	@param out_entities		Collection to fill.
+	*/
+	template <typename EntityType>
+	void collectSiblingShardEntities(std::vector<EntityType> const& entities, EEntityType outerEntityTypes, std::vector<CodeGenUnit::ShardEntity>& out_entities) noexcept
+	{
+		size_t siblingEntitiesEnd = out_entities.size() + entities.size();
+
+		for (EntityType const& entity : entities)
+		{
+			out_entities.push_back(CodeGenUnit::ShardEntity{ &entity, outerEntityTypes, out_entities.size() + 1u, siblingEntitiesEnd });
+		}
+	}
+
+	/**
+	*	@brief Append the entities of a file or a namespace to the shard entities of a file, in traversal order.
+	* 
+	*	@param scope			FileParsingResult or NamespaceInfo containing the entities.
+	*	@param outerEntityTypes	Mask of the types of all the outer entities of the entities.
+	*	@param out_entities		Collection to fill.
+	*/
+	template <typename ScopeType>
+	void collectShardEntitiesInScope(ScopeType const& scope, EEntityType outerEntityTypes, std::vector<CodeGenUnit::ShardEntity>& out_entities) noexcept
+	{
+		size_t firstNamespaceIndex = out_entities.size();
+
+		//Nested entities of namespaces are shard entities themselves, following their namespace
+		for (NamespaceInfo const& namespace_ : scope.namespaces)
+		{
+			size_t namespaceIndex = out_entities.size();
+
+			out_entities.push_back(CodeGenUnit::ShardEntity{ &namespace_, outerEntityTypes, 0u, 0u });
+
+			collectShardEntitiesInScope(namespace_, outerEntityTypes | namespace_.entityType, out_entities);
+
+			out_entities[namespaceIndex].nestedEntitiesEnd = out_entities.size();
+		}
+
+		for (size_t i = firstNamespaceIndex; i < out_entities.size(); i = out_entities[i].nestedEntitiesEnd)
+		{
+			out_entities[i].siblingEntitiesEnd = out_entities.size();
+		}
+
+		collectSiblingShardEntities(scope.structs, outerEntityTypes, out_entities);
+		collectSiblingShardEntities(scope.classes, outerEntityTypes, out_entities);
+		collectSiblingShardEntities(scope.enums, outerEntityTypes, out_entities);
+		collectSiblingShardEntities(scope.variables, outerEntityTypes, out_entities);
+		collectSiblingShardEntities(scope.functions, outerEntityTypes, out_entities);
+	}
+}
+
 CodeGenUnit::CodeGenUnit(CodeGenUnit const& other) noexcept:
 	_isCopy{true},
 	settings{other.settings},
-	logger{other.logger}
+	logger{other.logger},
+	generatedFileWriter{other.generatedFileWriter},
+	shouldTouchUnchangedFiles{other.shouldTouchUnchangedFiles}
 {
 	//Replace each module by a new clone of themself so that
 	//each CodeGenUnit instance owns their own modules
@@ -101,8 +163,14 @@ bool CodeGenUnit::isFileNewerThan(fs::path const& file, fs::path const& referenc
 	return fs::last_write_time(file) > fs::last_write_time(referenceFile);
 }
 
+void CodeGenUnit::reset() noexcept
+{
+}
+
 bool CodeGenUnit::generateCode(FileParsingResult const& parsingResult) noexcept
 {
+	writeDuration = 0.0f;
+
 	//TODO: Should probably use std::unique_ptr here instead of a raw pointer to be exception-safe
 	CodeGenEnv* env = createCodeGenEnv();
 	
@@ -134,7 +202,11 @@ bool CodeGenUnit::generateCode(FileParsingResult const& parsingResult) noexcept
 				//Post-generation step, runs only if all previous steps succeeded
 				if (result)
 				{
+					auto writeStart = std::chrono::steady_clock::now();
+
 					result &= postGenerateCode(*env);
+
+					writeDuration = std::chrono::duration<float>(std::chrono::steady_clock::now() - writeStart).count();
 				}
 			}
 		}
@@ -145,6 +217,208 @@ bool CodeGenUnit::generateCode(FileParsingResult const& parsingResult) noexcept
 	return result;
 }
 
+bool CodeGenUnit::canGenerateCodeInShards() const noexcept
+{
+	return false;
+}
+
+bool CodeGenUnit::generateShardCode(FileParsingResult const& parsingResult, std::vector<ShardEntity> const& shardEntities, size_t first, size_t last) noexcept
+{
+	assert(first <= last && last <= shardEntities.size());
+
+	CodeGenEnv* env = createCodeGenEnv();
+
+	assert(env != nullptr);
+
+	bool result = preGenerateCode(parsingResult, *env);
+
+	if (result)
+	{
+		std::vector<ICodeGenerator*> const& codeGenerators = getSortedCodeGenerators();
+
+		_shardTraversals.clear();
+		_shardTraversals.reserve(codeGenerators.size());
+
+		//Code generators initialize their per-file state in their initial code, which is then dropped by the merging unit
+		initialGenerateCodeInternal(codeGenerators, *env);
+		completeShardStep();
+
+		std::unordered_map<ICodeGenerator const*, PropertyCodeGen*>	propertyCodeGenerators;
+		PropertyIndex												propertyIndex;
+
+		for (CodeGenModule* codeGenModule : _generationModules)
+		{
+			for (PropertyCodeGen* propertyCodeGen : codeGenModule->getPropertyCodeGenerators())
+			{
+				//Other generators traverse all entities
+				if (propertyCodeGen->isDispatchedByPropertyName())
+				{
+					propertyCodeGenerators.emplace(propertyCodeGen, propertyCodeGen);
+				}
+			}
+		}
+
+		if (!propertyCodeGenerators.empty())
+		{
+			buildPropertyIndex(shardEntities, first, last, propertyIndex);
+		}
+
+		auto visitor = std::bind(&CodeGenUnit::generateCodeForEntityInternal, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+
+		for (size_t codeGeneratorIndex = 0u; result && codeGeneratorIndex < codeGenerators.size(); codeGeneratorIndex++)
+		{
+			ICodeGenerator*	codeGenerator	= codeGenerators[codeGeneratorIndex];
+			ShardTraversal&	traversal		= _shardTraversals.emplace_back();
+			auto			it				= propertyCodeGenerators.find(codeGenerator);
+
+			if (it != propertyCodeGenerators.end())
+			{
+				result &= foreachPropertyCodeGenEntityPair(*it->second, propertyIndex, *env, visitor) != ETraversalBehaviour::AbortWithFailure;
+			}
+			else
+			{
+				traversal.isTraversed = true;
+
+				//Skip entities exactly as CodeGenUnit::foreachCodeGenEntityPair would, as if the range started the file
+				for (size_t i = first; result && i < last; i = traversal.visits.back().nextEntityIndex)
+				{
+					ShardEntity const&	shardEntity			= shardEntities[i];
+					size_t				generatedCodeSize	= getGeneratedCodeSize();
+					ETraversalBehaviour	traversalResult		= foreachCodeGenEntityPairInShardEntity(*codeGenerator, shardEntity, *env, visitor);
+					size_t				nextEntityIndex		= i + 1u;
+
+					if (traversalResult == ETraversalBehaviour::AbortWithFailure || traversalResult == ETraversalBehaviour::AbortWithSuccess)
+					{
+						result = false;
+					}
+					else if (traversalResult == ETraversalBehaviour::Break)
+					{
+						nextEntityIndex = shardEntity.siblingEntitiesEnd;
+					}
+					else if (traversalResult != ETraversalBehaviour::Recurse)
+					{
+						nextEntityIndex = shardEntity.nestedEntitiesEnd;
+					}
+
+					traversal.visits.push_back(ShardVisit{ i, nextEntityIndex, getGeneratedCodeSize() != generatedCodeSize });
+				}
+			}
+
+			completeShardStep();
+		}
+	}
+
+	delete env;
+
+	return result;
+}
+
+bool CodeGenUnit::canMergeShardCode(std::vector<ShardEntity> const& shardEntities, std::vector<CodeGenUnit*> const& shardUnits) noexcept
+{
+	if (shardUnits.empty())
+	{
+		return false;
+	}
+
+	size_t codeGeneratorsCount = shardUnits.front()->_shardTraversals.size();
+
+	for (CodeGenUnit const* shardUnit : shardUnits)
+	{
+		if (shardUnit->_shardTraversals.size() != codeGeneratorsCount)
+		{
+			return false;
+		}
+	}
+
+	for (size_t codeGeneratorIndex = 0u; codeGeneratorIndex < codeGeneratorsCount; codeGeneratorIndex++)
+	{
+		if (!shardUnits.front()->_shardTraversals[codeGeneratorIndex].isTraversed)
+		{
+			continue;
+		}
+
+		//Replay the whole file traversal from the entities skipped by each visited entity
+		size_t nextEntityIndex = 0u;
+
+		for (CodeGenUnit const* shardUnit : shardUnits)
+		{
+			for (ShardVisit const& visit : shardUnit->_shardTraversals[codeGeneratorIndex].visits)
+			{
+				if (visit.entityIndex > nextEntityIndex)
+				{
+					//The whole file traversal visits an entity the shard skipped
+					return false;
+				}
+				else if (visit.entityIndex == nextEntityIndex)
+				{
+					nextEntityIndex = visit.nextEntityIndex;
+				}
+				else if (visit.hasGeneratedCode)
+				{
+					//The shard generated code for an entity the whole file traversal skips
+					return false;
+				}
+			}
+		}
+
+		if (nextEntityIndex < shardEntities.size())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool CodeGenUnit::generateCodeFromShards(FileParsingResult const& parsingResult, std::vector<CodeGenUnit*> const& shardUnits) noexcept
+{
+	writeDuration = 0.0f;
+
+	CodeGenEnv* env = createCodeGenEnv();
+
+	assert(env != nullptr);
+
+	bool result = preGenerateCode(parsingResult, *env);
+
+	if (result)
+	{
+		std::vector<ICodeGenerator*> const& codeGenerators = getSortedCodeGenerators();
+
+		//Same steps as CodeGenUnit::generateCode, the traversal being replaced by the merge of the shards
+		initialGenerateCodeInternal(codeGenerators, *env);
+
+		mergeShardCode(shardUnits);
+
+		finalGenerateCodeInternal(codeGenerators, *env);
+
+		auto writeStart = std::chrono::steady_clock::now();
+
+		result &= postGenerateCode(*env);
+
+		writeDuration = std::chrono::duration<float>(std::chrono::steady_clock::now() - writeStart).count();
+	}
+
+	delete env;
+
+	return result;
+}
+
+void CodeGenUnit::completeShardStep() noexcept
+{
+	//Default implementation does nothing
+}
+
+void CodeGenUnit::mergeShardCode(std::vector<CodeGenUnit*> const& /* shardUnits */) noexcept
+{
+	//Default implementation does nothing
+}
+
+size_t CodeGenUnit::getGeneratedCodeSize() const noexcept
+{
+	//Default implementation doesn't generate code
+	return 0u;
+}
+
 bool CodeGenUnit::initialGenerateCodeInternal(std::vector<ICodeGenerator*> const& codeGenerators, CodeGenEnv& env) noexcept
 {
 	bool result = true;
@@ -252,9 +526,45 @@ ETraversalBehaviour CodeGenUnit::foreachCodeGenEntityPair(std::function<ETravers
 
 	ETraversalBehaviour result;
 
+	//Property code generators only run on the properties named after them,
+	//so they are dispatched through a property index rather than a traversal of all entities
+	std::unordered_map<ICodeGenerator const*, PropertyCodeGen*>	propertyCodeGenerators;
+	PropertyIndex												propertyIndex;
+
+	for (CodeGenModule* codeGenModule : _generationModules)
+	{
+		for (PropertyCodeGen* propertyCodeGen : codeGenModule->getPropertyCodeGenerators())
+		{
+			//Generators overriding shouldGenerateCodeForEntity might run on other properties, so they traverse all entities
+			if (propertyCodeGen->isDispatchedByPropertyName())
+			{
+				propertyCodeGenerators.emplace(propertyCodeGen, propertyCodeGen);
+			}
+		}
+	}
+
+	if (!propertyCodeGenerators.empty())
+	{
+		buildPropertyIndex(*env.getFileParsingResult(), propertyIndex);
+	}
+
 	//Call visitor on all code generators
 	for (ICodeGenerator* codeGenerator : getSortedCodeGenerators())
 	{
+		auto it = propertyCodeGenerators.find(codeGenerator);
+
+		if (it != propertyCodeGenerators.end())
+		{
+			result = foreachPropertyCodeGenEntityPair(*it->second, propertyIndex, env, visitor);
+
+			if (result == ETraversalBehaviour::AbortWithFailure || result == ETraversalBehaviour::AbortWithSuccess)
+			{
+				return result;
+			}
+
+			continue;
+		}
+
 		for (NamespaceInfo const& namespace_ : env.getFileParsingResult()->namespaces)
 		{
 			result = foreachCodeGenEntityPairInNamespace(*codeGenerator, namespace_, env, visitor);
@@ -436,6 +746,192 @@ ETraversalBehaviour CodeGenUnit::foreachCodeGenEntityPairInEnum(ICodeGenerator&
 	return ETraversalBehaviour::Recurse;
 }
 
+ETraversalBehaviour CodeGenUnit::foreachCodeGenEntityPairInShardEntity(ICodeGenerator& codeGenerator, ShardEntity const& shardEntity, CodeGenEnv& env,
+																	   std::function<ETraversalBehaviour(ICodeGenerator&, EntityInfo const&, CodeGenEnv&, void const*)> visitor) noexcept
+{
+	assert(visitor != nullptr);
+
+	switch (shardEntity.entity->entityType)
+	{
+		case EEntityType::Struct:
+			[[fallthrough]];
+		case EEntityType::Class:
+			return foreachCodeGenEntityPairInStruct(codeGenerator, static_cast<StructClassInfo const&>(*shardEntity.entity), env, visitor);
+
+		case EEntityType::Enum:
+			return foreachCodeGenEntityPairInEnum(codeGenerator, static_cast<EnumInfo const&>(*shardEntity.entity), env, visitor);
+
+		default:
+			//Nested entities of namespaces are shard entities themselves
+			return codeGenerator.callVisitorOnEntity(*shardEntity.entity, env, visitor);
+	}
+}
+
+void CodeGenUnit::collectShardEntities(FileParsingResult const& parsingResult, std::vector<ShardEntity>& out_entities) noexcept
+{
+	collectShardEntitiesInScope(parsingResult, EEntityType::Undefined, out_entities);
+}
+
+void CodeGenUnit::indexProperties(EntityInfo const& entity, EEntityType outerEntityTypes, PropertyIndex& out_index) noexcept
+{
+	for (uint8 i = 0; i < entity.properties.size(); i++)
+	{
+		out_index[entity.properties[i].name].push_back(PropertyOccurrence{ &entity, i, outerEntityTypes });
+	}
+}
+
+void CodeGenUnit::indexPropertiesInNamespace(NamespaceInfo const& namespace_, EEntityType outerEntityTypes, PropertyIndex& out_index) noexcept
+{
+	indexProperties(namespace_, outerEntityTypes, out_index);
+
+	outerEntityTypes = outerEntityTypes | namespace_.entityType;
+
+	for (NamespaceInfo const& nestedNamespace : namespace_.namespaces)
+	{
+		indexPropertiesInNamespace(nestedNamespace, outerEntityTypes, out_index);
+	}
+
+	for (StructClassInfo const& struct_ : namespace_.structs)
+	{
+		indexPropertiesInStruct(struct_, outerEntityTypes, out_index);
+	}
+
+	for (StructClassInfo const& class_ : namespace_.classes)
+	{
+		indexPropertiesInStruct(class_, outerEntityTypes, out_index);
+	}
+
+	for (EnumInfo const& enum_ : namespace_.enums)
+	{
+		indexPropertiesInEnum(enum_, outerEntityTypes, out_index);
+	}
+
+	for (VariableInfo const& variable : namespace_.variables)
+	{
+		indexProperties(variable, outerEntityTypes, out_index);
+	}
+
+	for (FunctionInfo const& function : namespace_.functions)
+	{
+		indexProperties(function, outerEntityTypes, out_index);
+	}
+}
+
+void CodeGenUnit::indexPropertiesInStruct(StructClassInfo const& struct_, EEntityType outerEntityTypes, PropertyIndex& out_index) noexcept
+{
+	indexProperties(struct_, outerEntityTypes, out_index);
+
+	outerEntityTypes = outerEntityTypes | struct_.entityType;
+
+	for (std::shared_ptr<NestedStructClassInfo> const& nestedStruct : struct_.nestedStructs)
+	{
+		indexPropertiesInStruct(*nestedStruct, outerEntityTypes, out_index);
+	}
+
+	for (std::shared_ptr<NestedStructClassInfo> const& nestedClass : struct_.nestedClasses)
+	{
+		indexPropertiesInStruct(*nestedClass, outerEntityTypes, out_index);
+	}
+
+	for (NestedEnumInfo const& nestedEnum : struct_.nestedEnums)
+	{
+		indexPropertiesInEnum(nestedEnum, outerEntityTypes, out_index);
+	}
+
+	for (FieldInfo const& field : struct_.fields)
+	{
+		indexProperties(field, outerEntityTypes, out_index);
+	}
+
+	for (MethodInfo const& method : struct_.methods)
+	{
+		indexProperties(method, outerEntityTypes, out_index);
+	}
+}
+
+void CodeGenUnit::indexPropertiesInEnum(EnumInfo const& enum_, EEntityType outerEntityTypes, PropertyIndex& out_index) noexcept
+{
+	indexProperties(enum_, outerEntityTypes, out_index);
+
+	outerEntityTypes = outerEntityTypes | enum_.entityType;
+
+	for (EnumValueInfo const& enumValue : enum_.enumValues)
+	{
+		indexProperties(enumValue, outerEntityTypes, out_index);
+	}
+}
+
+void CodeGenUnit::buildPropertyIndex(FileParsingResult const& parsingResult, PropertyIndex& out_index) noexcept
+{
+	for (NamespaceInfo const& namespace_ : parsingResult.namespaces)
+	{
+		indexPropertiesInNamespace(namespace_, EEntityType::Undefined, out_index);
+	}
+
+	for (StructClassInfo const& struct_ : parsingResult.structs)
+	{
+		indexPropertiesInStruct(struct_, EEntityType::Undefined, out_index);
+	}
+
+	for (StructClassInfo const& class_ : parsingResult.classes)
+	{
+		indexPropertiesInStruct(class_, EEntityType::Undefined, out_index);
+	}
+
+	for (EnumInfo const& enum_ : parsingResult.enums)
+	{
+		indexPropertiesInEnum(enum_, EEntityType::Undefined, out_index);
+	}
+
+	for (VariableInfo const& variable : parsingResult.variables)
+	{
+		indexProperties(variable, EEntityType::Undefined, out_index);
+	}
+
+	for (FunctionInfo const& function : parsingResult.functions)
+	{
+		indexProperties(function, EEntityType::Undefined, out_index);
+	}
+}
+
+void CodeGenUnit::buildPropertyIndex(std::vector<ShardEntity> const& shardEntities, size_t first, size_t last, PropertyIndex& out_index) noexcept
+{
+	for (size_t i = first; i < last; i++)
+	{
+		EntityInfo const& entity = *shardEntities[i].entity;
+
+		switch (entity.entityType)
+		{
+			case EEntityType::Struct:
+				[[fallthrough]];
+			case EEntityType::Class:
+				indexPropertiesInStruct(static_cast<StructClassInfo const&>(entity), shardEntities[i].outerEntityTypes, out_index);
+				break;
+
+			case EEntityType::Enum:
+				indexPropertiesInEnum(static_cast<EnumInfo const&>(entity), shardEntities[i].outerEntityTypes, out_index);
+				break;
+
+			default:
+				indexProperties(entity, shardEntities[i].outerEntityTypes, out_index);
+				break;
+		}
+	}
+}
+
+ETraversalBehaviour CodeGenUnit::foreachPropertyCodeGenEntityPair(PropertyCodeGen& propertyCodeGen, PropertyIndex const& propertyIndex, CodeGenEnv& env,
+																  std::function<ETraversalBehaviour(ICodeGenerator&, EntityInfo const&, CodeGenEnv&, void const*)> visitor) noexcept
+{
+	assert(visitor != nullptr);
+
+	auto propertyVisitor = [&propertyCodeGen, &env, &visitor](EntityInfo const& entity, Property const& /* property */, uint8 propertyIndex)
+	{
+		return propertyCodeGen.callVisitorOnProperty(entity, propertyIndex, env, visitor) != ETraversalBehaviour::AbortWithFailure;
+	};
+
+	return foreachPropertyOccurrence(propertyCodeGen, propertyIndex, propertyVisitor);
+}
+
 void CodeGenUnit::clearGenerationModules() noexcept
 {
 	if (_isCopy)
@@ -470,6 +966,28 @@ bool CodeGenUnit::removeModule(CodeGenModule const& generationModule) noexcept
 	return false;
 }
 
+bool CodeGenUnit::hasGeneratedFiles(fs::path const& sourceFile) const noexcept
+{
+	return isUpToDate(sourceFile);
+}
+
+uint64 CodeGenUnit::computeFingerprint() const noexcept
+{
+	uint64 fingerprint = (settings != nullptr) ? settings->computeFingerprint() : Helpers::computeHash(nullptr, 0u);
+
+	for (ICodeGenerator const* codeGenerator : getSortedCodeGenerators())
+	{
+		int32 generationOrder	= codeGenerator->getGenerationOrder();
+		uint8 iterationCount	= codeGenerator->getIterationCount();
+
+		fingerprint = Helpers::computeHash(std::string(typeid(*codeGenerator).name()), fingerprint);
+		fingerprint = Helpers::computeHash(&generationOrder, sizeof(generationOrder), fingerprint);
+		fingerprint = Helpers::computeHash(&iterationCount, sizeof(iterationCount), fingerprint);
+	}
+
+	return fingerprint;
+}
+
 CodeGenUnitSettings const* CodeGenUnit::getSettings() const noexcept
 {
 	return settings;
@@ -493,6 +1011,20 @@ uint8 CodeGenUnit::getIterationCount() const noexcept
 	}
 }
 
+bool CodeGenUnit::requiresIterationBarrier() const noexcept
+{
+	return std::any_of(_generationModules.cbegin(), _generationModules.cend(),
+					   [](CodeGenModule* const& module)
+					   {
+						   return module->requiresIterationBarrier();
+					   });
+}
+
+float CodeGenUnit::getWriteDuration() const noexcept
+{
+	return writeDuration;
+}
+
 std::vector<CodeGenModule*>	const& CodeGenUnit::getRegisteredCodeGenModules() const noexcept
 {
 	return _generationModules;
@@ -502,6 +1034,8 @@ CodeGenUnit& CodeGenUnit::operator=(CodeGenUnit const& other) noexcept
 {
 	settings = other.settings;
 	logger = other.logger;
+	generatedFileWriter = other.generatedFileWriter;
+	shouldTouchUnchangedFiles = other.shouldTouchUnchangedFiles;
 
 	//Correctly release memory if the instance is already a copy
 	if (_isCopy)
@@ -0,0 +1,108 @@
+#include "Kodgen/CodeGen/FileDurationHistory.h"
+
+#include <fstream>
+#include <sstream>		//std::ostringstream
+#include <string>
+#include <algorithm>	//std::stable_sort
+
+using namespace kodgen;
+
+bool FileDurationHistory::loadFromFile(fs::path const& historyFile) noexcept
+{
+	std::ifstream stream(historyFile);
+
+	_entries.clear();
+
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	//Each line is formatted as: parsingDuration generationDuration path
+	Entry		entry;
+	std::string	path;
+
+	while (stream >> entry.parsingDuration >> entry.generationDuration)
+	{
+		//Skip the separator before the path, which may contain spaces
+		stream.get();
+
+		if (std::getline(stream, path) && !path.empty())
+		{
+			_entries.insert_or_assign(fs::path(path), entry);
+		}
+	}
+
+	return true;
+}
+
+bool FileDurationHistory::saveToFile(fs::path const& historyFile) const noexcept
+{
+	std::ostringstream stream;
+
+	for (auto const& [file, entry] : _entries)
+	{
+		if (fs::exists(file))
+		{
+			stream << entry.parsingDuration << " " << entry.generationDuration << " " << file.string() << "\n";
+		}
+	}
+
+	//An interrupted run must not leave a truncated history behind
+	return FilesystemHelpers::writeFileAtomically(historyFile, stream.str());
+}
+
+void FileDurationHistory::updateEntry(fs::path const& file, Entry const& entry) noexcept
+{
+	_entries.insert_or_assign(file, entry);
+}
+
+std::vector<fs::path> FileDurationHistory::sortByDecreasingCost(std::vector<fs::path> const& files) const noexcept
+{
+	std::vector<std::pair<float, fs::path>>	costs;
+	std::vector<uintmax_t>					fileSizes;
+	float									recordedDuration	= 0.0f;
+	uintmax_t								recordedSize		= 0u;
+	std::error_code							error;
+
+	costs.reserve(files.size());
+	fileSizes.reserve(files.size());
+
+	for (fs::path const& file : files)
+	{
+		uintmax_t fileSize = fs::file_size(file, error);
+
+		fileSizes.push_back((error) ? 0u : fileSize);
+
+		auto it = _entries.find(file);
+
+		if (it != _entries.cend())
+		{
+			recordedDuration	+= it->second.parsingDuration + it->second.generationDuration;
+			recordedSize		+= fileSizes.back();
+		}
+	}
+
+	//Convert sizes to durations so that recorded and unseen files can be compared
+	float durationPerByte = (recordedSize != 0u && recordedDuration > 0.0f) ? recordedDuration / recordedSize : 1.0f;
+
+	for (size_t i = 0u; i < files.size(); i++)
+	{
+		auto it = _entries.find(files[i]);
+
+		costs.emplace_back((it != _entries.cend()) ? it->second.parsingDuration + it->second.generationDuration : fileSizes[i] * durationPerByte, files[i]);
+	}
+
+	//Stable so that files with the same cost keep their original order
+	std::stable_sort(costs.begin(), costs.end(), [](auto const& lhs, auto const& rhs) { return lhs.first > rhs.first; });
+
+	std::vector<fs::path> result;
+	result.reserve(costs.size());
+
+	for (auto& [cost, file] : costs)
+	{
+		result.emplace_back(std::move(file));
+	}
+
+	return result;
+}
\ No newline at end of file
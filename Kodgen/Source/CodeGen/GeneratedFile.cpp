@@ -1,27 +1,205 @@
 #include "Kodgen/CodeGen/GeneratedFile.h"
 
+#include <vector>
+#include <algorithm>	//std::min
+#include <random>		//std::random_device
+
+#if _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>		//open
+#include <sys/uio.h>	//writev
+#include <unistd.h>		//close
+#include <climits>		//IOV_MAX
+#include <cerrno>
+#endif
+
+#include "Kodgen/CodeGen/GeneratedFileWriter.h"
+#include "Kodgen/Misc/Helpers.h"
+
 using namespace kodgen;
 
-GeneratedFile::GeneratedFile(fs::path&& generatedFilePath, fs::path const& sourceFilePath) noexcept:
+namespace
+{
+	/**
+	*	@brief Write the chunks of a buffer to a file, replacing its content.
+	*
+	*	@param path		Path to the file.
+	*	@param content	Content to write.
+	*
+	*	@return true if the whole content has been written, else false.
+	*/
+	bool writeChunks(fs::path const& path, ChunkedBuffer const& content) noexcept
+	{
+		std::vector<std::string> const& chunks = content.getChunks();
+
+#if _WIN32
+		//Files are written in binary mode so that their content is exactly the compared content
+		std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		for (std::string const& chunk : chunks)
+		{
+			stream.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+		}
+
+		stream.close();
+
+		return !stream.fail();
+#else
+		int file = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+		if (file == -1)
+		{
+			return false;
+		}
+
+		std::vector<iovec> buffers;
+		buffers.reserve(chunks.size());
+
+		for (std::string const& chunk : chunks)
+		{
+			if (!chunk.empty())
+			{
+				buffers.push_back(iovec{ const_cast<char*>(chunk.data()), chunk.size() });
+			}
+		}
+
+		//Write all chunks with as few system calls as possible, resuming after partial writes
+		size_t	bufferIndex	= 0u;
+		bool	isSuccess	= true;
+
+		while (isSuccess && bufferIndex < buffers.size())
+		{
+			ssize_t writtenSize = writev(file, buffers.data() + bufferIndex, static_cast<int>(std::min<size_t>(buffers.size() - bufferIndex, IOV_MAX)));
+
+			if (writtenSize < 0)
+			{
+				isSuccess = errno == EINTR;
+				continue;
+			}
+
+			//Skip fully written buffers, and advance in the partially written one
+			size_t remainingSize = static_cast<size_t>(writtenSize);
+
+			while (bufferIndex < buffers.size() && remainingSize >= buffers[bufferIndex].iov_len)
+			{
+				remainingSize -= buffers[bufferIndex].iov_len;
+				bufferIndex++;
+			}
+
+			if (remainingSize > 0u)
+			{
+				buffers[bufferIndex].iov_base = static_cast<char*>(buffers[bufferIndex].iov_base) + remainingSize;
+				buffers[bufferIndex].iov_len -= remainingSize;
+			}
+		}
+
+		return close(file) == 0 && isSuccess;
+#endif
+	}
+}
+
+GeneratedFile::GeneratedFile(fs::path&& generatedFilePath, fs::path const& sourceFilePath, GeneratedFileWriter* writer, bool shouldTouchIfUnchanged) noexcept:
 	_path{std::forward<fs::path>(generatedFilePath)},
 	_sourceFilePath{sourceFilePath},
-	_streamToFile(_path.string(), std::ios::out | std::ios::trunc)
+	_writer{writer},
+	_shouldTouchIfUnchanged{shouldTouchIfUnchanged}
 {
 }
 
 GeneratedFile::~GeneratedFile() noexcept
 {
-	_streamToFile.close();
+	if (!_isSaved)
+	{
+		save();
+	}
+}
+
+bool GeneratedFile::save() noexcept
+{
+	_isSaved = true;
+
+	if (_writer != nullptr)
+	{
+		_writer->submit(_path, _sourceFilePath, std::move(_content), _shouldTouchIfUnchanged);
+
+		return true;
+	}
+
+	return saveToFile(_path, _sourceFilePath, _content, _shouldTouchIfUnchanged);
+}
+
+bool GeneratedFile::isContentUnchanged(fs::path const& path, ChunkedBuffer const& content) noexcept
+{
+	std::error_code	error;
+	uintmax_t		fileSize = fs::file_size(path, error);
+
+	return !error && fileSize == content.size() && FilesystemHelpers::computeFileHash(path) == content.computeHash();
+}
+
+bool GeneratedFile::saveToFile(fs::path const& path, fs::path const& sourceFilePath, ChunkedBuffer const& content, bool shouldTouchIfUnchanged) noexcept
+{
+	std::error_code error;
+
+	if (isContentUnchanged(path, content))
+	{
+		//The source file changed without changing the generated code: its includers are rebuilt anyway,
+		//so mark the generated file as up-to-date rather than regenerating it on each run
+		if (shouldTouchIfUnchanged && !sourceFilePath.empty() && fs::last_write_time(path, error) <= fs::last_write_time(sourceFilePath, error) && !error)
+		{
+			fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+		}
+
+		return true;
+	}
+
+	//A unique name keeps concurrent generators writing the same file from writing to the same temporary file
+	fs::path temporaryPath = path;
+	temporaryPath += ".tmp" + std::to_string(std::random_device()());
+
+	bool isSaved = writeChunks(temporaryPath, content);
+
+	if (isSaved)
+	{
+		//The replaced file keeps its permissions
+		fs::file_status status = fs::status(path, error);
+
+		if (!error && fs::exists(status))
+		{
+			fs::permissions(temporaryPath, status.permissions(), error);
+		}
+
+		fs::rename(temporaryPath, path, error);
+		isSaved = !error;
+	}
+
+	if (!isSaved)
+	{
+		fs::remove(temporaryPath, error);
+
+		//Fallback to a direct write if the file could not be replaced
+		isSaved = writeChunks(path, content);
+	}
+
+	return isSaved;
 }
 
 void GeneratedFile::writeLine(std::string const& line) noexcept
 {
-	_streamToFile << line << "\n";
+	_content.append(line);
+	_content.append("\n", 1u);
 }
 
 void GeneratedFile::writeLine(std::string&& line) noexcept
 {
-	_streamToFile << std::forward<std::string>(line) << "\n";
+	_content.append(std::forward<std::string>(line));
+	_content.append("\n", 1u);
+}
+
+void GeneratedFile::writeLine(ChunkedBuffer&& line) noexcept
+{
+	_content.append(std::forward<ChunkedBuffer>(line));
+	_content.append("\n", 1u);
 }
 
 void GeneratedFile::writeLines(std::string const& line) noexcept
@@ -41,7 +219,15 @@ void GeneratedFile::expandWriteMacroLines(std::string const& line) noexcept
 
 void GeneratedFile::expandWriteMacroLines(std::string&& line) noexcept
 {
-	writeLine(std::forward<std::string>(line) + "\n");
+	writeLine(std::forward<std::string>(line));
+	_content.append("\n", 1u);
+}
+
+void GeneratedFile::writeMacro(std::string&& macroPrototype, ChunkedBuffer&& body) noexcept
+{
+	writeLine("#define " + std::forward<std::string>(macroPrototype) + "\t\\");
+	writeLine(std::forward<ChunkedBuffer>(body));
+	_content.append("\n", 1u);
 }
 
 void GeneratedFile::writeMacro(std::string&& macroName) noexcept
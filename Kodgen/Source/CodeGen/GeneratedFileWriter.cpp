@@ -0,0 +1,114 @@
+#include "Kodgen/CodeGen/GeneratedFileWriter.h"
+
+#include <cassert>
+#include <iterator>	//std::make_move_iterator
+
+#include "Kodgen/CodeGen/GeneratedFile.h"
+
+using namespace kodgen;
+
+GeneratedFileWriter::GeneratedFileWriter(size_t maxPendingFilesCount, uint32 writerThreadCount) noexcept:
+	_maxPendingFilesCount{maxPendingFilesCount}
+{
+	assert(maxPendingFilesCount > 0u);
+	assert(writerThreadCount > 0u);
+
+	_pendingFiles.reserve(maxPendingFilesCount);
+	_writerThreads.reserve(writerThreadCount);
+
+	for (uint32 i = 0u; i < writerThreadCount; i++)
+	{
+		_writerThreads.emplace_back(std::thread(&GeneratedFileWriter::writerRoutine, this));
+	}
+}
+
+GeneratedFileWriter::~GeneratedFileWriter() noexcept
+{
+	flush();
+
+	{
+		std::lock_guard lock(_mutex);
+
+		_isStopping = true;
+	}
+
+	_pendingCondition.notify_all();
+
+	for (std::thread& writerThread : _writerThreads)
+	{
+		if (writerThread.joinable())
+		{
+			writerThread.join();
+		}
+	}
+}
+
+void GeneratedFileWriter::writerRoutine() noexcept
+{
+	std::vector<PendingFile> files;
+
+	while (true)
+	{
+		{
+			std::unique_lock lock(_mutex);
+
+			_pendingCondition.wait(lock, [this]() { return _isStopping || !_pendingFiles.empty(); });
+
+			if (_pendingFiles.empty())
+			{
+				//Stopping and nothing left to write
+				return;
+			}
+
+			//Take all pending files at once to write them without locking in between
+			files.swap(_pendingFiles);
+			_writingFilesCount += files.size();
+		}
+
+		std::vector<fs::path> failedFiles;
+
+		for (PendingFile& file : files)
+		{
+			if (!GeneratedFile::saveToFile(file.path, file.sourceFilePath, file.content, file.shouldTouchIfUnchanged))
+			{
+				failedFiles.push_back(file.sourceFilePath.empty() ? std::move(file.path) : std::move(file.sourceFilePath));
+			}
+		}
+
+		{
+			std::lock_guard lock(_mutex);
+
+			_writingFilesCount -= files.size();
+			_failedFiles.insert(_failedFiles.end(), std::make_move_iterator(failedFiles.begin()), std::make_move_iterator(failedFiles.end()));
+		}
+
+		files.clear();
+
+		_writtenCondition.notify_all();
+	}
+}
+
+void GeneratedFileWriter::submit(fs::path path, fs::path sourceFilePath, ChunkedBuffer content, bool shouldTouchIfUnchanged) noexcept
+{
+	{
+		std::unique_lock lock(_mutex);
+
+		_writtenCondition.wait(lock, [this]() { return _pendingFiles.size() + _writingFilesCount < _maxPendingFilesCount; });
+
+		_pendingFiles.push_back(PendingFile{ std::move(path), std::move(sourceFilePath), std::move(content), shouldTouchIfUnchanged });
+	}
+
+	_pendingCondition.notify_one();
+}
+
+std::vector<fs::path> GeneratedFileWriter::flush() noexcept
+{
+	std::unique_lock lock(_mutex);
+
+	_writtenCondition.wait(lock, [this]() { return _pendingFiles.empty() && _writingFilesCount == 0u; });
+
+	std::vector<fs::path> failedFiles;
+	failedFiles.swap(_failedFiles);
+
+	return failedFiles;
+}
\ No newline at end of file
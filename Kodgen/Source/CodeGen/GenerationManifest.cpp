@@ -0,0 +1,132 @@
+#include "Kodgen/CodeGen/GenerationManifest.h"
+
+#include <fstream>
+#include <sstream>	//std::ostringstream
+#include <string>
+
+using namespace kodgen;
+
+bool GenerationManifest::loadFromFile(fs::path const& manifestFile) noexcept
+{
+	std::ifstream stream(manifestFile);
+
+	_fingerprint = 0u;
+	_generatedFileStates.clear();
+	_outdatedFileStates.clear();
+	_hasRefreshedStates = false;
+
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	//First line is the fingerprint, then each line is formatted as: hash lastWriteTime size path
+	FileState	state;
+	uint64		lastWriteTime;
+	std::string	path;
+
+	if (!(stream >> std::hex >> _fingerprint))
+	{
+		return false;
+	}
+
+	while (stream >> state.hash >> lastWriteTime >> state.size)
+	{
+		//Skip the separator before the path, which may contain spaces
+		stream.get();
+
+		if (std::getline(stream, path) && !path.empty())
+		{
+			state.lastWriteTime = static_cast<int64>(lastWriteTime);
+
+			_generatedFileStates.insert_or_assign(fs::path(path), state);
+		}
+	}
+
+	return true;
+}
+
+bool GenerationManifest::saveToFile(fs::path const& manifestFile) const noexcept
+{
+	std::ostringstream stream;
+
+	stream << std::hex << _fingerprint << "\n";
+
+	for (auto const& [file, state] : _generatedFileStates)
+	{
+		if (fs::exists(file))
+		{
+			stream << state.hash << " " << static_cast<uint64>(state.lastWriteTime) << " " << state.size << " " << file.string() << "\n";
+		}
+	}
+
+	//A crash while saving must not lose the whole manifest
+	return FilesystemHelpers::writeFileAtomically(manifestFile, stream.str());
+}
+
+void GenerationManifest::setFingerprint(uint64 fingerprint) noexcept
+{
+	if (_fingerprint != fingerprint)
+	{
+		_fingerprint = fingerprint;
+		_generatedFileStates.clear();
+	}
+}
+
+bool GenerationManifest::checkUpToDate(fs::path const& sourceFile) noexcept
+{
+	std::error_code		lastWriteTimeError;
+	std::error_code		sizeError;
+	FileState			state;
+	fs::file_time_type	lastWriteTime	= fs::last_write_time(sourceFile, lastWriteTimeError);
+	uintmax_t			size			= fs::file_size(sourceFile, sizeError);
+	bool				isStatValid		= !lastWriteTimeError && !sizeError;
+
+	state.lastWriteTime	= (isStatValid) ? static_cast<int64>(lastWriteTime.time_since_epoch().count()) : 0;
+	state.size			= (isStatValid) ? static_cast<uint64>(size) : 0u;
+
+	auto it = _generatedFileStates.find(sourceFile);
+
+	//Untouched files are not read at all
+	if (isStatValid && it != _generatedFileStates.end() && it->second.lastWriteTime == state.lastWriteTime && it->second.size == state.size)
+	{
+		return true;
+	}
+
+	state.hash = FilesystemHelpers::computeFileHash(sourceFile);
+
+	if (it != _generatedFileStates.end() && it->second.hash == state.hash)
+	{
+		//Touched but unchanged, so record the new last write time to avoid hashing the file again next time
+		it->second			= state;
+		_hasRefreshedStates	= true;
+
+		return true;
+	}
+
+	_outdatedFileStates.insert_or_assign(sourceFile, state);
+
+	return false;
+}
+
+bool GenerationManifest::hasRefreshedStates() const noexcept
+{
+	return _hasRefreshedStates;
+}
+
+void GenerationManifest::markGenerated(fs::path const& sourceFile) noexcept
+{
+	auto it = _outdatedFileStates.find(sourceFile);
+
+	if (it != _outdatedFileStates.cend())
+	{
+		_generatedFileStates.insert_or_assign(sourceFile, it->second);
+		_outdatedFileStates.erase(it);
+	}
+}
+
+void GenerationManifest::markOutdated(fs::path const& sourceFile) noexcept
+{
+	_generatedFileStates.erase(sourceFile);
+	_outdatedFileStates.erase(sourceFile);
+}
\ No newline at end of file
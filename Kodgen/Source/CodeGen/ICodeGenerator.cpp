@@ -10,4 +10,9 @@ int32 ICodeGenerator::getGenerationOrder() const noexcept
 uint8 ICodeGenerator::getIterationCount() const noexcept
 {
 	return 1u;
+}
+
+bool ICodeGenerator::requiresIterationBarrier() const noexcept
+{
+	return false;
 }
\ No newline at end of file
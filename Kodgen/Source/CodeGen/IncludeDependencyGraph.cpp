@@ -0,0 +1,158 @@
+#include "Kodgen/CodeGen/IncludeDependencyGraph.h"
+
+#include <fstream>
+#include <sstream>	//std::istringstream, std::ostringstream
+#include <string>
+
+using namespace kodgen;
+
+int64 IncludeDependencyGraph::getLastWriteTime(fs::path const& file) noexcept
+{
+	std::error_code		error;
+	fs::file_time_type	lastWriteTime = fs::last_write_time(file, error);
+
+	return (error) ? 0 : static_cast<int64>(lastWriteTime.time_since_epoch().count());
+}
+
+IncludeDependencyGraph::FileState const& IncludeDependencyGraph::getCurrentState(fs::path const& file, bool shouldHash) noexcept
+{
+	auto [it, isInserted] = _currentStates.try_emplace(file);
+
+	if (isInserted)
+	{
+		it->second.state.lastWriteTime = getLastWriteTime(file);
+	}
+
+	if (shouldHash && !it->second.isHashComputed)
+	{
+		it->second.state.hash		= FilesystemHelpers::computeFileHash(file);
+		it->second.isHashComputed	= true;
+	}
+
+	return it->second.state;
+}
+
+bool IncludeDependencyGraph::loadFromFile(fs::path const& graphFile) noexcept
+{
+	std::ifstream stream(graphFile);
+
+	_dependencies.clear();
+	_currentStates.clear();
+	_hasRefreshedStates = false;
+
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	//Each generated file is on its own line, followed by one line per included file formatted as: \tlastWriteTime hash path
+	std::vector<Dependency>*	dependencies = nullptr;
+	std::string					line;
+
+	while (std::getline(stream, line))
+	{
+		if (line.empty())
+		{
+			continue;
+		}
+		else if (line.front() != '\t')
+		{
+			dependencies = &_dependencies[fs::path(line)];
+			continue;
+		}
+
+		std::istringstream	lineStream(line);
+		Dependency			dependency;
+		std::string			path;
+
+		//A malformed file can't be trusted at all, so forget every dependency and let all files be regenerated
+		if (dependencies == nullptr ||
+			!(lineStream >> dependency.state.lastWriteTime >> dependency.state.hash) ||
+			lineStream.get() != ' ' ||
+			!std::getline(lineStream, path) ||
+			path.empty())
+		{
+			_dependencies.clear();
+
+			return false;
+		}
+
+		dependency.file = std::move(path);
+		dependencies->push_back(std::move(dependency));
+	}
+
+	return true;
+}
+
+bool IncludeDependencyGraph::saveToFile(fs::path const& graphFile) const noexcept
+{
+	std::ostringstream stream;
+
+	for (auto const& [file, dependencies] : _dependencies)
+	{
+		if (fs::exists(file))
+		{
+			stream << file.string() << "\n";
+
+			for (Dependency const& dependency : dependencies)
+			{
+				stream << "\t" << dependency.state.lastWriteTime << " " << dependency.state.hash << " " << dependency.file.string() << "\n";
+			}
+		}
+	}
+
+	//A crash while saving must not leave a truncated graph behind
+	return FilesystemHelpers::writeFileAtomically(graphFile, stream.str());
+}
+
+bool IncludeDependencyGraph::haveDependenciesChanged(fs::path const& file, bool shouldCompareContent) noexcept
+{
+	auto it = _dependencies.find(file);
+
+	if (it == _dependencies.cend())
+	{
+		return true;
+	}
+
+	for (Dependency& dependency : it->second)
+	{
+		//Only hash files which have been touched, so that unchanged dependencies cost a single stat
+		if (getCurrentState(dependency.file, false).lastWriteTime != dependency.state.lastWriteTime)
+		{
+			if (!shouldCompareContent || getCurrentState(dependency.file, true).hash != dependency.state.hash)
+			{
+				return true;
+			}
+
+			//Same content: remember the new last write time so that the file is not hashed again on next runs
+			dependency.state.lastWriteTime	= getCurrentState(dependency.file, false).lastWriteTime;
+			_hasRefreshedStates				= true;
+		}
+	}
+
+	return false;
+}
+
+void IncludeDependencyGraph::updateDependencies(fs::path const& file, std::vector<fs::path> const& includedFiles) noexcept
+{
+	std::vector<Dependency>& dependencies = _dependencies[file];
+
+	dependencies.clear();
+	dependencies.reserve(includedFiles.size());
+
+	//States are cached for the whole run, so included files shared by many files are hashed once
+	for (fs::path const& includedFile : includedFiles)
+	{
+		dependencies.push_back(Dependency{ includedFile, getCurrentState(includedFile, true) });
+	}
+}
+
+bool IncludeDependencyGraph::hasRefreshedStates() const noexcept
+{
+	return _hasRefreshedStates;
+}
+
+void IncludeDependencyGraph::removeDependencies(fs::path const& file) noexcept
+{
+	_dependencies.erase(file);
+}
\ No newline at end of file
@@ -102,9 +102,4 @@ bool MacroCodeGenModule::postGenerateCodeForEntity(EntityInfo const& /* entity *
 {
 	//Default implementation does nothing
 	return true;
-}
-
-void MacroCodeGenModule::addPropertyCodeGen(MacroPropertyCodeGen& propertyCodeGen) noexcept
-{
-	CodeGenModule::addPropertyCodeGen(propertyCodeGen);
 }
\ No newline at end of file
@@ -23,26 +23,7 @@ MacroCodeGenEnv* MacroCodeGenUnit::createCodeGenEnv() const noexcept
 
 void MacroCodeGenUnit::initialGenerateCode(CodeGenEnv& env, std::function<void(CodeGenEnv&, std::string&)> generate) noexcept
 {
-	MacroCodeGenEnv& macroEnv = static_cast<MacroCodeGenEnv&>(env);
-
-	//Generate code for each code location
-	for (int i = 0u; i < static_cast<int>(ECodeGenLocation::Count); i++)
-	{
-		macroEnv._codeGenLocation	= static_cast<ECodeGenLocation>(i);
-		macroEnv._separator			= _separators[i];
-
-		/**
-		*	No initial call when the CodeGenLocation is ClassFooter
-		*/
-		if (macroEnv._codeGenLocation == ECodeGenLocation::ClassFooter)
-		{
-			continue;
-		}
-		else
-		{
-			generate(macroEnv, _generatedCodePerLocation[i]);
-		}
-	}
+	generateCodeAtLocations(static_cast<MacroCodeGenEnv&>(env), generate);
 }
 
 void MacroCodeGenUnit::finalGenerateCode(CodeGenEnv& env, std::function<void(CodeGenEnv&, std::string&)> generate) noexcept
@@ -53,35 +34,7 @@ void MacroCodeGenUnit::finalGenerateCode(CodeGenEnv& env, std::function<void(Cod
 
 void MacroCodeGenUnit::generateCodeForEntity(EntityInfo const& entity, CodeGenEnv& env, std::function<void(EntityInfo const&, CodeGenEnv&, std::string&)> generate)	noexcept
 {
-	MacroCodeGenEnv& macroEnv = static_cast<MacroCodeGenEnv&>(env);
-
-	//Generate code for each code location
-	for (int i = 0u; i < static_cast<int>(ECodeGenLocation::Count); i++)
-	{
-		macroEnv._codeGenLocation	= static_cast<ECodeGenLocation>(i);
-		macroEnv._separator			= _separators[i];
-
-		/**
-		*	Forward ECodeGenLocation::ClassFooter generation only if the entity is a
-		*	struct, class, method or field
-		*/
-		if (macroEnv._codeGenLocation == ECodeGenLocation::ClassFooter)
-		{
-			if (!(entity.entityType == EEntityType::Struct || entity.entityType == EEntityType::Class ||
-				entity.entityType == EEntityType::Method || entity.entityType == EEntityType::Field))
-			{
-				continue;
-			}
-			else
-			{
-				generateEntityClassFooterCode(entity, macroEnv, generate);
-			}
-		}
-		else
-		{
-			generate(entity, macroEnv, _generatedCodePerLocation[i]);
-		}
-	}
+	generateCodeForEntityAtLocations(entity, static_cast<MacroCodeGenEnv&>(env), generate);
 }
 
 bool MacroCodeGenUnit::preGenerateCode(FileParsingResult const& parsingResult, CodeGenEnv& env) noexcept
@@ -93,31 +46,96 @@ bool MacroCodeGenUnit::preGenerateCode(FileParsingResult const& parsingResult, C
 		macroEnv._internalSymbolMacro = getSettings()->getInternalSymbolMacroName();
 
 		//Reset variables before the generation step begins
-		_classFooterGeneratedCode.clear();
+		reset();
+
+		return true;
+	}
+
+	return false;
+}
+
+void MacroCodeGenUnit::reset() noexcept
+{
+	_classFooterGeneratedCode.clear();
+	_shardGeneratedCode.clear();
+	_generatedCodeSize = 0u;
 
-		for (std::string& generatedCode : _generatedCodePerLocation)
+	for (ChunkedBuffer& generatedCode : _generatedCodePerLocation)
+	{
+		generatedCode.clear();
+	}
+}
+
+bool MacroCodeGenUnit::canGenerateCodeInShards() const noexcept
+{
+	return true;
+}
+
+void MacroCodeGenUnit::completeShardStep() noexcept
+{
+	_shardGeneratedCode.emplace_back(std::move(_generatedCodePerLocation));
+
+	for (ChunkedBuffer& generatedCode : _generatedCodePerLocation)
+	{
+		generatedCode.clear();
+	}
+}
+
+void MacroCodeGenUnit::mergeShardCode(std::vector<CodeGenUnit*> const& shardUnits) noexcept
+{
+	if (shardUnits.empty())
+	{
+		return;
+	}
+
+	size_t stepsCount = static_cast<MacroCodeGenUnit*>(shardUnits.front())->_shardGeneratedCode.size();
+
+	//The first step of each shard is its initial code, this unit generated its own
+	//Code generators run one after the other on all entities, so the code of a step in all shards comes before the next step
+	for (size_t step = 1u; step < stepsCount; step++)
+	{
+		for (CodeGenUnit* shardUnit : shardUnits)
 		{
-			generatedCode.clear();
+			MacroCodeGenUnit* macroShardUnit = static_cast<MacroCodeGenUnit*>(shardUnit);
+
+			assert(macroShardUnit->_shardGeneratedCode.size() == stepsCount);
+
+			for (size_t i = 0u; i < _generatedCodePerLocation.size(); i++)
+			{
+				_generatedCodePerLocation[i].append(std::move(macroShardUnit->_shardGeneratedCode[step][i]));
+			}
 		}
+	}
 
-		return true;
+	//A struct/class and its nested entities always belong to the same shard, so each class footer is generated by a single shard
+	for (CodeGenUnit* shardUnit : shardUnits)
+	{
+		MacroCodeGenUnit* macroShardUnit = static_cast<MacroCodeGenUnit*>(shardUnit);
+
+		for (auto& [struct_, classFooterGeneratedCode] : macroShardUnit->_classFooterGeneratedCode)
+		{
+			_classFooterGeneratedCode[struct_].append(std::move(classFooterGeneratedCode));
+		}
 	}
+}
 
-	return false;
+size_t MacroCodeGenUnit::getGeneratedCodeSize() const noexcept
+{
+	return _generatedCodeSize;
 }
 
 bool MacroCodeGenUnit::postGenerateCode(CodeGenEnv& env) noexcept
 {
 	//Create generated header & generated source files
-	generateHeaderFile(static_cast<MacroCodeGenEnv&>(env));
-	generateSourceFile(static_cast<MacroCodeGenEnv&>(env));
+	bool isHeaderFileSaved = generateHeaderFile(static_cast<MacroCodeGenEnv&>(env));
+	bool isSourceFileSaved = generateSourceFile(static_cast<MacroCodeGenEnv&>(env));
 
-	return true;
+	return isHeaderFileSaved && isSourceFileSaved;
 }
 
-void MacroCodeGenUnit::generateHeaderFile(MacroCodeGenEnv& env) noexcept
+bool MacroCodeGenUnit::generateHeaderFile(MacroCodeGenEnv& env) noexcept
 {
-	GeneratedFile generatedHeader(getGeneratedHeaderFilePath(env.getFileParsingResult()->parsedFile), env.getFileParsingResult()->parsedFile);
+	GeneratedFile generatedHeader(getGeneratedHeaderFilePath(env.getFileParsingResult()->parsedFile), env.getFileParsingResult()->parsedFile, generatedFileWriter, shouldTouchUnchangedFiles);
 
 	MacroCodeGenUnitSettings const* castSettings = getSettings();
 
@@ -141,18 +159,20 @@ void MacroCodeGenUnit::generateHeaderFile(MacroCodeGenEnv& env) noexcept
 														{
 															auto it = _classFooterGeneratedCode.find(struct_);
 
-															generatedHeader.writeMacro(castSettings->getClassFooterMacro(*struct_), (it != _classFooterGeneratedCode.end()) ? std::move(it->second) : std::string());
+															generatedHeader.writeMacro(castSettings->getClassFooterMacro(*struct_), (it != _classFooterGeneratedCode.end()) ? std::move(it->second) : ChunkedBuffer());
 														}
 													});
 
 	//Write header file footer code
 	generatedHeader.writeMacro(castSettings->getHeaderFileFooterMacro(env.getFileParsingResult()->parsedFile),
 							   std::move(_generatedCodePerLocation[static_cast<int>(ECodeGenLocation::HeaderFileFooter)]));
+
+	return generatedHeader.save();
 }
 
-void MacroCodeGenUnit::generateSourceFile(MacroCodeGenEnv& env) noexcept
+bool MacroCodeGenUnit::generateSourceFile(MacroCodeGenEnv& env) noexcept
 {
-	GeneratedFile generatedFile(getGeneratedSourceFilePath(env.getFileParsingResult()->parsedFile), env.getFileParsingResult()->parsedFile);
+	GeneratedFile generatedFile(getGeneratedSourceFilePath(env.getFileParsingResult()->parsedFile), env.getFileParsingResult()->parsedFile, generatedFileWriter, shouldTouchUnchangedFiles);
 
 	generatedFile.writeLine("#pragma once\n");
 
@@ -160,6 +180,8 @@ void MacroCodeGenUnit::generateSourceFile(MacroCodeGenEnv& env) noexcept
 	generatedFile.writeLine("#include \"" + FilesystemHelpers::normalizeSeparator(generatedFile.getSourceFilePath().lexically_relative(generatedFile.getPath().parent_path())).string() + "\"\n");
 
 	generatedFile.writeLine(std::move(_generatedCodePerLocation[static_cast<int>(ECodeGenLocation::SourceFileHeader)]));
+
+	return generatedFile.save();
 }
 
 bool MacroCodeGenUnit::isUpToDate(fs::path const& sourceFile) const noexcept
@@ -181,21 +203,19 @@ bool MacroCodeGenUnit::isUpToDate(fs::path const& sourceFile) const noexcept
 	return false;
 }
 
-void MacroCodeGenUnit::generateEntityClassFooterCode(EntityInfo const& entity, CodeGenEnv& env, std::function<void(EntityInfo const&, CodeGenEnv&, std::string&)> generate) noexcept
+bool MacroCodeGenUnit::hasGeneratedFiles(fs::path const& sourceFile) const noexcept
 {
-	if (entity.entityType == EEntityType::Struct || entity.entityType == EEntityType::Class)
-	{
-		//If the entity is a struct/class, append to the footer of the struct/class
-		generate(entity, env, _classFooterGeneratedCode[&reinterpret_cast<StructClassInfo const&>(entity)]);
-	}
-	else
+	fs::path generatedHeaderPath = getGeneratedHeaderFilePath(sourceFile);
+
+	//If the generated header doesn't exist, create it and return false
+	if (!fs::exists(generatedHeaderPath))
 	{
-		assert(entity.outerEntity != nullptr);
-		assert(entity.outerEntity->entityType == EEntityType::Struct || entity.outerEntity->entityType == EEntityType::Class);
+		GeneratedFile generatedHeader(fs::path(generatedHeaderPath), sourceFile);
 
-		//If the entity is NOT a struct/class, append to the footer of the outer struct/class
-		generate(entity, env, _classFooterGeneratedCode[reinterpret_cast<StructClassInfo const*>(entity.outerEntity)]);
+		return false;
 	}
+
+	return fs::exists(getGeneratedSourceFilePath(sourceFile));
 }
 
 fs::path MacroCodeGenUnit::getGeneratedHeaderFilePath(fs::path const& sourceFile) const noexcept
@@ -1,14 +1,152 @@
 #include "Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h"
 
 #include <algorithm>
-#include <locale>		//std::isalpha
+#include <locale>		//std::ctype
 #include <cctype>		//std::isdigit
+#include <cassert>
+#include <type_traits>	//std::is_same_v
 
 #include "Kodgen/InfoStructures/StructClassInfo.h"
 #include "Kodgen/Misc/TomlUtility.h"
+#include "Kodgen/Misc/Helpers.h"
 
 using namespace kodgen;
 
+MacroCodeGenUnitSettings::CompiledPattern::CompiledPattern(std::string pattern, std::initializer_list<std::pair<std::string_view, ESegmentKind>> tags) noexcept:
+	_pattern{std::move(pattern)}
+{
+	size_t textStart	= 0u;
+	size_t index		= 0u;
+
+	while (index < _pattern.size())
+	{
+		auto tag = std::find_if(tags.begin(), tags.end(), [this, index](std::pair<std::string_view, ESegmentKind> const& tag)
+								{
+									return _pattern.compare(index, tag.first.size(), tag.first) == 0;
+								});
+
+		if (tag != tags.end())
+		{
+			if (index > textStart)
+			{
+				_segments.push_back(Segment{ ESegmentKind::Text, textStart, index - textStart });
+			}
+
+			_segments.push_back(Segment{ tag->second, 0u, 0u });
+
+			index		+= tag->first.size();
+			textStart	= index;
+		}
+		else
+		{
+			index++;
+		}
+	}
+
+	if (_pattern.size() > textStart)
+	{
+		_segments.push_back(Segment{ ESegmentKind::Text, textStart, _pattern.size() - textStart });
+	}
+}
+
+std::string const& MacroCodeGenUnitSettings::CompiledPattern::getPattern() const noexcept
+{
+	return _pattern;
+}
+
+std::vector<MacroCodeGenUnitSettings::CompiledPattern::Segment> const& MacroCodeGenUnitSettings::CompiledPattern::getSegments() const noexcept
+{
+	return _segments;
+}
+
+std::string_view MacroCodeGenUnitSettings::CompiledPattern::getText(Segment const& segment) const noexcept
+{
+	return std::string_view(_pattern).substr(segment.offset, segment.size);
+}
+
+bool MacroCodeGenUnitSettings::CompiledPattern::hasSegment(ESegmentKind kind) const noexcept
+{
+	return std::any_of(_segments.cbegin(), _segments.cend(), [kind](Segment const& segment) { return segment.kind == kind; });
+}
+
+MacroCodeGenUnitSettings::CompiledPattern MacroCodeGenUnitSettings::compileFileNamePattern(std::string pattern) noexcept
+{
+	return CompiledPattern(std::move(pattern), { { filenameTag, CompiledPattern::ESegmentKind::FileName } });
+}
+
+MacroCodeGenUnitSettings::CompiledPattern MacroCodeGenUnitSettings::compileClassNamePattern(std::string pattern) noexcept
+{
+	return CompiledPattern(std::move(pattern), {	{ classNameTag, CompiledPattern::ESegmentKind::ClassName },
+													{ classFullNameTag, CompiledPattern::ESegmentKind::ClassFullName } });
+}
+
+void MacroCodeGenUnitSettings::appendFileStem(fs::path const& file, std::string& out_str) noexcept
+{
+	if constexpr (std::is_same_v<fs::path::value_type, char>)
+	{
+		std::string_view	path		= file.native();
+		size_t				separator	= path.find_last_of('/');
+		std::string_view	filename	= (separator == std::string_view::npos) ? path : path.substr(separator + 1u);
+		size_t				extension	= filename.find_last_of('.');
+
+		//Same rules as fs::path::stem: . and .. have no extension, and a leading dot doesn't start an extension
+		if (filename != "." && filename != ".." && extension != std::string_view::npos && extension != 0u)
+		{
+			filename = filename.substr(0u, extension);
+		}
+
+		out_str += filename;
+	}
+	else
+	{
+		//Native paths must be converted anyway
+		out_str += file.filename().stem().string();
+	}
+}
+
+void MacroCodeGenUnitSettings::expandPattern(CompiledPattern const& pattern, fs::path const* targetFile, std::string_view className, std::string_view classFullName, std::string& out_str) noexcept
+{
+	for (CompiledPattern::Segment const& segment : pattern.getSegments())
+	{
+		switch (segment.kind)
+		{
+			case CompiledPattern::ESegmentKind::Text:
+				out_str += pattern.getText(segment);
+				break;
+
+			case CompiledPattern::ESegmentKind::FileName:
+				assert(targetFile != nullptr);
+
+				//Replace all occurences of ##FILENAME## by the targetFile name (without its extension)
+				appendFileStem(*targetFile, out_str);
+				break;
+
+			case CompiledPattern::ESegmentKind::ClassName:
+				out_str += className;
+				break;
+
+			case CompiledPattern::ESegmentKind::ClassFullName:
+			{
+				//Replace full name :: into _ so that it makes a valid macro
+				size_t partStart	= 0u;
+				size_t separator	= classFullName.find("::");
+
+				while (separator != std::string_view::npos)
+				{
+					out_str += classFullName.substr(partStart, separator - partStart);
+					out_str += '_';
+
+					partStart	= separator + 2u;
+					separator	= classFullName.find("::", partStart);
+				}
+
+				out_str += classFullName.substr(partStart);
+				break;
+			}
+		}
+	}
+}
+
 bool MacroCodeGenUnitSettings::loadSettingsValues(toml::value const& tomlData, ILogger* logger) noexcept
 {
 	if (CodeGenUnitSettings::loadSettingsValues(tomlData, logger))
@@ -38,7 +176,7 @@ void MacroCodeGenUnitSettings::loadFileNamePatterns(toml::value const& generatio
 
 		if (logger != nullptr)
 		{
-			logger->log("[TOML] Load generated header file name pattern: " + _generatedHeaderFileNamePattern);
+			logger->log("[TOML] Load generated header file name pattern: " + _generatedHeaderFileNamePattern.getPattern());
 		}
 	}
 
@@ -49,7 +187,7 @@ void MacroCodeGenUnitSettings::loadFileNamePatterns(toml::value const& generatio
 
 		if (logger != nullptr)
 		{
-			logger->log("[TOML] Load generated source file name pattern: " + _generatedSourceFileNamePattern);
+			logger->log("[TOML] Load generated source file name pattern: " + _generatedSourceFileNamePattern.getPattern());
 		}
 	}
 }
@@ -65,7 +203,7 @@ void MacroCodeGenUnitSettings::loadClassFooterMacroPattern(toml::value const& ge
 
 		if (logger != nullptr)
 		{
-			logger->log("[TOML] Load class footer macro pattern: " + _classFooterMacroPattern);
+			logger->log("[TOML] Load class footer macro pattern: " + _classFooterMacroPattern.getPattern());
 		}
 	}
 }
@@ -81,7 +219,7 @@ void MacroCodeGenUnitSettings::loadHeaderFileFooterMacroPattern(toml::value cons
 
 		if (logger != nullptr)
 		{
-			logger->log("[TOML] Load header file footer macro pattern: " + _headerFileFooterMacroPattern);
+			logger->log("[TOML] Load header file footer macro pattern: " + _headerFileFooterMacroPattern.getPattern());
 		}
 	}
 }
@@ -120,22 +258,22 @@ void MacroCodeGenUnitSettings::loadInternalSymbolMacroName(toml::value const& ge
 
 void MacroCodeGenUnitSettings::setGeneratedHeaderFileNamePattern(std::string const& generatedHeaderFileNamePattern) noexcept
 {
-	_generatedHeaderFileNamePattern = generatedHeaderFileNamePattern;
+	_generatedHeaderFileNamePattern = compileFileNamePattern(generatedHeaderFileNamePattern);
 }
 
 void MacroCodeGenUnitSettings::setGeneratedSourceFileNamePattern(std::string const& generatedSourceFileNamePattern) noexcept
 {
-	_generatedSourceFileNamePattern = generatedSourceFileNamePattern;
+	_generatedSourceFileNamePattern = compileFileNamePattern(generatedSourceFileNamePattern);
 }
 
 void MacroCodeGenUnitSettings::setClassFooterMacroPattern(std::string const& classFooterMacroPattern) noexcept
 {
-	_classFooterMacroPattern = classFooterMacroPattern;
+	_classFooterMacroPattern = compileClassNamePattern(classFooterMacroPattern);
 }
 
 void MacroCodeGenUnitSettings::setHeaderFileFooterMacroPattern(std::string const& headerFileFooterMacroPattern) noexcept
 {
-	_headerFileFooterMacroPattern = headerFileFooterMacroPattern;
+	_headerFileFooterMacroPattern = compileFileNamePattern(headerFileFooterMacroPattern);
 }
 
 void MacroCodeGenUnitSettings::setExportSymbolMacroName(std::string const& exportSymbolMacroName) noexcept
@@ -150,71 +288,96 @@ void MacroCodeGenUnitSettings::setInternalSymbolMacroName(std::string const& int
 
 std::string const& MacroCodeGenUnitSettings::getGeneratedHeaderFileNamePattern() const noexcept
 {
-	return _generatedHeaderFileNamePattern;
+	return _generatedHeaderFileNamePattern.getPattern();
 }
 
 fs::path MacroCodeGenUnitSettings::getGeneratedHeaderFileName(fs::path const& targetFile) const noexcept
 {
-	std::string	filename = _generatedHeaderFileNamePattern;
-	
-	//Replace all occurences of ##FILENAME## by the targetFile name (without its extension)
-	replaceTags(filename, filenameTag, targetFile.filename().stem().string());
+	std::string	filename;
+
+	expandGeneratedHeaderFileName(targetFile, filename);
 
 	return filename;
 }
 
+void MacroCodeGenUnitSettings::expandGeneratedHeaderFileName(fs::path const& targetFile, std::string& out_fileName) const noexcept
+{
+	expandPattern(_generatedHeaderFileNamePattern, &targetFile, std::string_view(), std::string_view(), out_fileName);
+}
+
 std::string const&	MacroCodeGenUnitSettings::getGeneratedSourceFileNamePattern() const noexcept
 {
-	return _generatedSourceFileNamePattern;
+	return _generatedSourceFileNamePattern.getPattern();
 }
 
 fs::path MacroCodeGenUnitSettings::getGeneratedSourceFileName(fs::path const& targetFile) const noexcept
 {
-	std::string	filename = _generatedSourceFileNamePattern;
+	std::string	filename;
 
-	//Replace all occurences of ##FILENAME## by the targetFile name (without its extension)
-	replaceTags(filename, filenameTag, targetFile.filename().stem().string());
+	expandGeneratedSourceFileName(targetFile, filename);
 
 	return filename;
 }
 
+void MacroCodeGenUnitSettings::expandGeneratedSourceFileName(fs::path const& targetFile, std::string& out_fileName) const noexcept
+{
+	expandPattern(_generatedSourceFileNamePattern, &targetFile, std::string_view(), std::string_view(), out_fileName);
+}
+
 std::string const& MacroCodeGenUnitSettings::getClassFooterMacroPattern() const noexcept
 {
-	return _classFooterMacroPattern;
+	return _classFooterMacroPattern.getPattern();
 }
 
 std::string MacroCodeGenUnitSettings::getClassFooterMacro(StructClassInfo const& structClassInfo) const noexcept
 {
-	std::string	classFooterMacroName	= _classFooterMacroPattern;
-	std::string classFullName			= structClassInfo.type.getName(true, false, true);
+	std::string classFooterMacroName;
 
-	//Replace full name :: into _ so that it makes a valid macro
-	replaceTags(classFullName, "::", "_");
+	//Only compute the full name if it is used since it is built on demand
+	if (_classFooterMacroPattern.hasSegment(CompiledPattern::ESegmentKind::ClassFullName))
+	{
+		expandClassFooterMacro(structClassInfo.name, structClassInfo.type.getName(true, false, true), classFooterMacroName);
+	}
+	else
+	{
+		expandClassFooterMacro(structClassInfo.name, std::string_view(), classFooterMacroName);
+	}
 
-	replaceTags(classFooterMacroName, classNameTag, structClassInfo.name);
-	replaceTags(classFooterMacroName, classFullNameTag, classFullName);
+	return classFooterMacroName;
+}
 
-	sanitizeMacroName(classFooterMacroName);
+void MacroCodeGenUnitSettings::expandClassFooterMacro(std::string_view className, std::string_view classFullName, std::string& out_macro) const noexcept
+{
+	size_t macroStart = out_macro.size();
 
-	return classFooterMacroName;
+	expandPattern(_classFooterMacroPattern, nullptr, className, classFullName, out_macro);
+
+	sanitizeMacroName(out_macro, macroStart);
 }
 
 std::string const& MacroCodeGenUnitSettings::getHeaderFileFooterMacroPattern() const noexcept
 {
-	return _headerFileFooterMacroPattern;
+	return _headerFileFooterMacroPattern.getPattern();
 }
 
 std::string	MacroCodeGenUnitSettings::getHeaderFileFooterMacro(fs::path const& targetFile) const noexcept
 {
-	std::string headerFileFooterMacroName = _headerFileFooterMacroPattern;
-
-	replaceTags(headerFileFooterMacroName, filenameTag, targetFile.filename().stem().string());
+	std::string headerFileFooterMacroName;
 
-	sanitizeMacroName(headerFileFooterMacroName);
+	expandHeaderFileFooterMacro(targetFile, headerFileFooterMacroName);
 
 	return headerFileFooterMacroName;
 }
 
+void MacroCodeGenUnitSettings::expandHeaderFileFooterMacro(fs::path const& targetFile, std::string& out_macro) const noexcept
+{
+	size_t macroStart = out_macro.size();
+
+	expandPattern(_headerFileFooterMacroPattern, &targetFile, std::string_view(), std::string_view(), out_macro);
+
+	sanitizeMacroName(out_macro, macroStart);
+}
+
 std::string const& MacroCodeGenUnitSettings::getExportSymbolMacroName() const noexcept
 {
 	return _exportSymbolMacroName;
@@ -226,29 +389,35 @@ std::string const& MacroCodeGenUnitSettings::getInternalSymbolMacroName() const
 }
 
 bool MacroCodeGenUnitSettings::sanitizeMacroName(std::string& inout_macroName) noexcept
+{
+	return sanitizeMacroName(inout_macroName, 0u);
+}
+
+bool MacroCodeGenUnitSettings::sanitizeMacroName(std::string& inout_str, size_t startIndex) noexcept
 {
 	bool altered = false;
 
-	if (!inout_macroName.empty())
+	if (startIndex < inout_str.size())
 	{
-		char const			underscore	= '_';
-		std::locale const&	cLocale		= std::locale::classic();
+		//Get the facet once since std::isalpha looks it up in the locale on each call
+		char const				underscore	= '_';
+		std::ctype<char> const&	cType		= std::use_facet<std::ctype<char>>(std::locale::classic());
 
 		//First char can be a letter or underscore
-		if (inout_macroName[0] != underscore && !std::isalpha(inout_macroName[0], cLocale))
+		if (inout_str[startIndex] != underscore && !cType.is(std::ctype_base::alpha, inout_str[startIndex]))
 		{
-			inout_macroName[0] = underscore;
+			inout_str[startIndex] = underscore;
 			altered = true;
 		}
 
 		//Following chars can be letter/digit/underscore
-		for (std::size_t i = 1u; i < inout_macroName.size(); i++)
+		for (std::size_t i = startIndex + 1u; i < inout_str.size(); i++)
 		{
-			if (inout_macroName[i] != underscore &&
-				!std::isalpha(inout_macroName[i], cLocale) &&
-				!std::isdigit(static_cast<unsigned char>(inout_macroName[i])))
+			if (inout_str[i] != underscore &&
+				!cType.is(std::ctype_base::alpha, inout_str[i]) &&
+				!std::isdigit(static_cast<unsigned char>(inout_str[i])))
 			{
-				inout_macroName[i] = underscore;
+				inout_str[i] = underscore;
 				altered = true;
 			}
 		}
@@ -267,4 +436,18 @@ void MacroCodeGenUnitSettings::replaceTags(std::string& inout_string, std::strin
 
 		index = inout_string.find(tag, index + replacement.size());
 	}
+}
+
+uint64 MacroCodeGenUnitSettings::computeFingerprint() const noexcept
+{
+	uint64 fingerprint = CodeGenUnitSettings::computeFingerprint();
+
+	for (std::string const* setting : {	&_generatedHeaderFileNamePattern.getPattern(), &_generatedSourceFileNamePattern.getPattern(),
+										&_classFooterMacroPattern.getPattern(), &_headerFileFooterMacroPattern.getPattern(),
+										&_exportSymbolMacroName, &_internalSymbolMacroName })
+	{
+		fingerprint = Helpers::computeHash(*setting, fingerprint);
+	}
+
+	return fingerprint;
 }
\ No newline at end of file
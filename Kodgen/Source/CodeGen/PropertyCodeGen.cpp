@@ -71,4 +71,33 @@ ETraversalBehaviour PropertyCodeGen::callVisitorOnEntity(EntityInfo const& entit
 	}
 
 	return shouldIterateOnNestedEntities(entity) ? ETraversalBehaviour::Recurse : ETraversalBehaviour::Continue;
+}
+
+ETraversalBehaviour PropertyCodeGen::callVisitorOnProperty(EntityInfo const& entity, uint8 propertyIndex, CodeGenEnv& env, std::function<ETraversalBehaviour(ICodeGenerator&, EntityInfo const&, CodeGenEnv&, void const*)> visitor) noexcept
+{
+	assert(visitor != nullptr);
+	assert(propertyIndex < entity.properties.size());
+
+	AdditionalData data;
+
+	data.propertyIndex = propertyIndex;
+	data.property = &entity.properties[propertyIndex];
+
+	return (visitor(*this, entity, env, &data) == ETraversalBehaviour::AbortWithFailure) ? ETraversalBehaviour::AbortWithFailure : ETraversalBehaviour::Recurse;
+}
+
+bool PropertyCodeGen::canReachNestedEntities(EEntityType outerEntityTypes) const noexcept
+{
+	//Same rules as shouldIterateOnNestedEntities, for all outer entities at once
+	if ((outerEntityTypes && EEntityType::Namespace) && !(NamespaceInfo::nestedEntityTypes && _eligibleEntityMask))
+	{
+		return false;
+	}
+
+	if ((outerEntityTypes && (EEntityType::Struct | EEntityType::Class)) && !(StructClassInfo::nestedEntityTypes && _eligibleEntityMask))
+	{
+		return false;
+	}
+
+	return !(outerEntityTypes && EEntityType::Enum) || (EnumInfo::nestedEntityTypes && _eligibleEntityMask);
 }
\ No newline at end of file
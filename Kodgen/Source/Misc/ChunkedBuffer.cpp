@@ -0,0 +1,132 @@
+#include "Kodgen/Misc/ChunkedBuffer.h"
+
+#include <algorithm>	//std::min, std::max
+#include <cassert>
+
+#include "Kodgen/Misc/Helpers.h"
+
+using namespace kodgen;
+
+void ChunkedBuffer::adoptChunk(std::string&& chunk) noexcept
+{
+	if (!chunk.empty())
+	{
+		_chunks.emplace_back(std::move(chunk));
+	}
+
+	chunk.clear();
+}
+
+void ChunkedBuffer::append(char const* data, size_t size) noexcept
+{
+	while (size > 0u)
+	{
+		if (_chunks.empty() || _chunks.back().size() == _chunks.back().capacity())
+		{
+			size_t chunkCapacity = _chunks.empty() ? _minChunkCapacity : std::min(_chunks.back().capacity() * 2u, _maxChunkCapacity);
+
+			//Data larger than the next chunk gets a chunk of its own size so that it is not split
+			_chunks.emplace_back().reserve(std::max(chunkCapacity, size));
+		}
+
+		std::string&	lastChunk	= _chunks.back();
+		size_t			copiedSize	= std::min(size, lastChunk.capacity() - lastChunk.size());
+
+		//Never exceeds the capacity of the chunk, so the chunk is never reallocated
+		lastChunk.append(data, copiedSize);
+
+		data += copiedSize;
+		size -= copiedSize;
+	}
+}
+
+void ChunkedBuffer::append(std::string_view str) noexcept
+{
+	append(str.data(), str.size());
+}
+
+void ChunkedBuffer::append(std::string&& str) noexcept
+{
+	if (str.size() >= _minAdoptedSize)
+	{
+		adoptChunk(std::move(str));
+	}
+	else
+	{
+		append(str.data(), str.size());
+		str.clear();
+	}
+}
+
+void ChunkedBuffer::append(ChunkedBuffer&& buffer) noexcept
+{
+	assert(&buffer != this);
+
+	for (std::string& chunk : buffer._chunks)
+	{
+		append(std::move(chunk));
+	}
+
+	buffer._chunks.clear();
+}
+
+void ChunkedBuffer::clear() noexcept
+{
+	//Keep the first chunk so that a reused buffer doesn't allocate again for small contents
+	if (_chunks.size() > 1u)
+	{
+		_chunks.erase(_chunks.begin() + 1, _chunks.end());
+	}
+
+	if (!_chunks.empty())
+	{
+		_chunks.front().clear();
+	}
+}
+
+size_t ChunkedBuffer::size() const noexcept
+{
+	size_t size = 0u;
+
+	for (std::string const& chunk : _chunks)
+	{
+		size += chunk.size();
+	}
+
+	return size;
+}
+
+bool ChunkedBuffer::empty() const noexcept
+{
+	return size() == 0u;
+}
+
+std::vector<std::string> const& ChunkedBuffer::getChunks() const noexcept
+{
+	return _chunks;
+}
+
+uint64 ChunkedBuffer::computeHash() const noexcept
+{
+	uint64 hash = Helpers::computeHash(nullptr, 0u);
+
+	for (std::string const& chunk : _chunks)
+	{
+		hash = Helpers::computeHash(chunk.data(), chunk.size(), hash);
+	}
+
+	return hash;
+}
+
+std::string ChunkedBuffer::toString() const noexcept
+{
+	std::string result;
+	result.reserve(size());
+
+	for (std::string const& chunk : _chunks)
+	{
+		result += chunk;
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -3,7 +3,9 @@
 #include <cassert>
 #include <cctype>		//std::tolower
 #include <sstream>		//std::stringstream
-#include <algorithm>	//std::transform
+#include <algorithm>	//std::transform, std::all_of
+#include <fstream>
+#include <random>		//std::random_device
 
 #if _WIN32
 #include <Windows.h>	//GetModuleFileNameA, GetLastError, ERROR_INSUFFICIENT_BUFFER
@@ -15,7 +17,14 @@ using namespace kodgen;
 
 bool CompilerHelpers::isSupportedCompiler(std::string const& compiler) noexcept
 {
-	std::string normalizedCompilerExecutable = normalizeCompilerExeName(compiler);
+	std::string				normalizedCompilerExecutable = normalizeCompilerExeName(compiler);
+	std::vector<fs::path>	cachedIncludeDirectories;
+
+	//Entries are only cached for supported compilers
+	if (loadCachedIncludeDirectories(getCacheKey(normalizedCompilerExecutable), cachedIncludeDirectories))
+	{
+		return true;
+	}
 
 	return 
 #if _WIN32
@@ -110,25 +119,36 @@ std::vector<fs::path> CompilerHelpers::getCompilerNativeIncludeDirectories(std::
 	//Don't do anything if the compiler is an empty string
 	if (compiler.size() > 0)
 	{
-		std::string normalizedCompilerExeName = normalizeCompilerExeName(compiler);
+		std::string normalizedCompilerExeName	= normalizeCompilerExeName(compiler);
+		std::string cacheKey					= getCacheKey(normalizedCompilerExeName);
+
+		if (loadCachedIncludeDirectories(cacheKey, result))
+		{
+			return result;
+		}
 
 #if _WIN32
 		//Check MSVC on windows only
 		if (isMSVC(normalizedCompilerExeName))
 		{
-			return getMSVCNativeIncludeDirectories();
+			result = getMSVCNativeIncludeDirectories();
 		}
 #endif
 
 		//Check clang
 		if (isClang(normalizedCompilerExeName))
 		{
-			return getClangNativeIncludeDirectories(normalizedCompilerExeName);
+			result = getClangNativeIncludeDirectories(normalizedCompilerExeName);
 		}
 		//Check GCC
 		else if (isGCC(normalizedCompilerExeName))
 		{
-			return getGCCNativeIncludeDirectories(normalizedCompilerExeName);
+			result = getGCCNativeIncludeDirectories(normalizedCompilerExeName);
+		}
+
+		if (!result.empty())
+		{
+			saveCachedIncludeDirectories(cacheKey, result);
 		}
 	}
 
@@ -247,6 +267,164 @@ std::vector<fs::path> CompilerHelpers::getGCCNativeIncludeDirectories(std::strin
 	return result;
 }
 
+fs::path CompilerHelpers::getCacheFilePath() noexcept
+{
+	fs::path cacheDirectory = System::getUserCacheDirectory();
+
+	return (cacheDirectory.empty()) ? fs::path() : cacheDirectory / "Kodgen" / "CompilerCache.txt";
+}
+
+std::string CompilerHelpers::getCacheKey(std::string const& normalizedCompilerExeName) noexcept
+{
+	fs::path compilerPath;
+
+	if (isClang(normalizedCompilerExeName) || isGCC(normalizedCompilerExeName))
+	{
+		compilerPath = System::findExecutable(normalizedCompilerExeName);
+	}
+#if _WIN32
+	//MSVC include directories are queried through vswhere
+	else if (isMSVC(normalizedCompilerExeName))
+	{
+		compilerPath = getvswherePath();
+	}
+#endif
+
+	if (compilerPath.empty())
+	{
+		return std::string();
+	}
+
+	//Resolve symlinks so that switching the compiler an alias points to changes the key
+	std::error_code	error;
+	fs::path		resolvedPath	= fs::canonical(compilerPath, error);
+
+	if (error)
+	{
+		return std::string();
+	}
+
+	fs::file_time_type	lastWriteTime	= fs::last_write_time(resolvedPath, error);
+	uintmax_t			fileSize		= (error) ? 0u : fs::file_size(resolvedPath, error);
+
+	if (error)
+	{
+		return std::string();
+	}
+
+	return normalizedCompilerExeName + "|" + resolvedPath.string() + "|" + std::to_string(lastWriteTime.time_since_epoch().count()) + "|" + std::to_string(fileSize);
+}
+
+bool CompilerHelpers::loadCachedIncludeDirectories(std::string const& cacheKey, std::vector<fs::path>& out_includeDirectories) noexcept
+{
+	fs::path cacheFilePath = getCacheFilePath();
+
+	if (cacheKey.empty() || cacheFilePath.empty())
+	{
+		return false;
+	}
+
+	std::ifstream stream(cacheFilePath);
+
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	//Each compiler key is on its own line, followed by one line per include directory starting with a tab
+	std::string	line;
+	bool		isParsingDirectories = false;
+
+	out_includeDirectories.clear();
+
+	while (std::getline(stream, line))
+	{
+		if (!line.empty() && line.front() == '\t')
+		{
+			if (isParsingDirectories)
+			{
+				out_includeDirectories.emplace_back(line.substr(1u));
+			}
+		}
+		else if (isParsingDirectories)
+		{
+			break;
+		}
+		else
+		{
+			isParsingDirectories = (line == cacheKey);
+		}
+	}
+
+	std::error_code error;
+
+	//A directory removed by an update of the compiler SDK invalidates the entry
+	return isParsingDirectories && !out_includeDirectories.empty() &&
+			std::all_of(out_includeDirectories.cbegin(), out_includeDirectories.cend(), [&error](fs::path const& directory) { return fs::is_directory(directory, error); });
+}
+
+void CompilerHelpers::saveCachedIncludeDirectories(std::string const& cacheKey, std::vector<fs::path> const& includeDirectories) noexcept
+{
+	fs::path cacheFilePath = getCacheFilePath();
+
+	if (cacheKey.empty() || cacheFilePath.empty())
+	{
+		return;
+	}
+
+	//Entries are keyed by "compiler name|path|...", so keep entries of other compilers and drop outdated entries of this one
+	std::string		compilerPrefix = cacheKey.substr(0u, cacheKey.find('|') + 1u);
+	std::string		content;
+	std::ifstream	inputStream(cacheFilePath);
+	std::string		line;
+	bool			isKeptEntry = false;
+
+	while (std::getline(inputStream, line))
+	{
+		if (line.empty() || line.front() != '\t')
+		{
+			isKeptEntry = line.compare(0u, compilerPrefix.size(), compilerPrefix) != 0;
+		}
+
+		if (isKeptEntry)
+		{
+			content += line + "\n";
+		}
+	}
+
+	inputStream.close();
+
+	content += cacheKey + "\n";
+
+	for (fs::path const& includeDirectory : includeDirectories)
+	{
+		content += "\t" + includeDirectory.string() + "\n";
+	}
+
+	//Write to a temporary file first so that concurrent generators never read a partially written cache
+	std::error_code	error;
+	fs::path		temporaryPath = cacheFilePath;
+	temporaryPath += ".tmp" + std::to_string(std::random_device()());
+
+	fs::create_directories(cacheFilePath.parent_path(), error);
+
+	{
+		std::ofstream outputStream(temporaryPath, std::ios::out | std::ios::trunc);
+
+		if (!outputStream.is_open() || !(outputStream << content))
+		{
+			return;
+		}
+	}
+
+	fs::rename(temporaryPath, cacheFilePath, error);
+
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+	}
+}
+
 std::string CompilerHelpers::normalizeCompilerExeName(std::string const& compilerName) noexcept
 {
 	std::string result = compilerName;
@@ -1,6 +1,11 @@
 #include "Kodgen/Misc/Filesystem.h"
 
-#include <algorithm> //std::replace
+#include <algorithm>	//std::replace
+#include <fstream>
+#include <array>
+#include <random>	//std::random_device
+
+#include "Kodgen/Misc/Helpers.h"
 
 using namespace kodgen;
 
@@ -39,4 +44,55 @@ bool FilesystemHelpers::isChildPath(fs::path const& child, fs::path const& other
 	}
 
 	return false;
+}
+
+uint64 FilesystemHelpers::computeFileHash(fs::path const& file) noexcept
+{
+	std::ifstream stream(file, std::ios::in | std::ios::binary);
+
+	if (!stream.is_open())
+	{
+		return 0u;
+	}
+
+	std::array<char, 4096>	buffer;
+	uint64					hash = Helpers::computeHash(nullptr, 0u);
+
+	while (stream.read(buffer.data(), buffer.size()) || stream.gcount() > 0)
+	{
+		hash = Helpers::computeHash(buffer.data(), static_cast<size_t>(stream.gcount()), hash);
+	}
+
+	return hash;
+}
+
+bool FilesystemHelpers::writeFileAtomically(fs::path const& file, std::string const& content) noexcept
+{
+	//A unique name keeps concurrent writers of the same file from writing to the same temporary file
+	std::error_code	error;
+	fs::path		temporaryPath = file;
+	temporaryPath += ".tmp" + std::to_string(std::random_device()());
+
+	{
+		std::ofstream stream(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!stream.is_open() || !stream.write(content.data(), static_cast<std::streamsize>(content.size())) || !stream.flush())
+		{
+			stream.close();
+			fs::remove(temporaryPath, error);
+
+			return false;
+		}
+	}
+
+	fs::rename(temporaryPath, file, error);
+
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+
+		return false;
+	}
+
+	return true;
 }
\ No newline at end of file
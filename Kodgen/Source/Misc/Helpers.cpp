@@ -16,3 +16,27 @@ std::string Helpers::getDebugInfo(CXCursor const& cursor) noexcept
 	return Helpers::getString(clang_getCursorKindSpelling(cursor.kind)) + " -> " + Helpers::getString(clang_getCursorDisplayName(cursor));
 }
 
+
+
+uint64 Helpers::computeHash(void const* data, size_t size, uint64 hash) noexcept
+{
+	constexpr uint64 fnvPrime = 1099511628211ull;
+
+	uint8 const* bytes = static_cast<uint8 const*>(data);
+
+	for (size_t i = 0u; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= fnvPrime;
+	}
+
+	return hash;
+}
+
+uint64 Helpers::computeHash(std::string const& data, uint64 hash) noexcept
+{
+	//Hash the size too so that consecutive strings can't produce the same hash when split differently
+	uint64 size = data.size();
+
+	return computeHash(data.data(), data.size(), computeHash(&size, sizeof(size), hash));
+}
\ No newline at end of file
@@ -4,6 +4,24 @@
 #include <array>
 #include <memory>	//std::unique_ptr
 #include <cstdio>	//std::fgets
+#include <cstdlib>	//std::getenv
+#include <sstream>	//std::stringstream
+#include <fstream>	//std::ifstream
+#include <algorithm>	//std::min
+#include <thread>	//std::thread::hardware_concurrency
+
+#include "Kodgen/Misc/Helpers.h"
+
+#if __linux__
+#include <unistd.h>	//sysconf
+#include <link.h>	//dl_iterate_phdr
+#include <cstring>	//std::strcmp
+#endif
+
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>	//GetModuleFileNameW
+#endif
 
 using namespace kodgen;
 
@@ -31,4 +49,350 @@ std::string System::executeCommand(std::string const& cmd)
 	}
 
 	return result;
+}
+
+fs::path System::getExecutablePath() noexcept
+{
+#if _WIN32
+	std::array<wchar_t, 1024>	buffer;
+	DWORD						length = GetModuleFileNameW(nullptr, buffer.data(), static_cast<DWORD>(buffer.size()));
+
+	//A length equal to the buffer size means the path was truncated
+	return (length > 0u && length < buffer.size()) ? fs::path(std::wstring(buffer.data(), length)) : fs::path();
+#elif __linux__
+	std::error_code error;
+	fs::path		executablePath = fs::read_symlink("/proc/self/exe", error);
+
+	return (error) ? fs::path() : executablePath;
+#else
+	return fs::path();
+#endif
+}
+
+uint64 System::computeModuleFingerprint(void const* address) noexcept
+{
+	fs::path modulePath;
+
+#if _WIN32
+	HMODULE module = nullptr;
+
+	if (address != nullptr && !GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, static_cast<LPCWSTR>(address), &module))
+	{
+		return 0u;
+	}
+
+	std::array<wchar_t, 1024>	buffer;
+	DWORD						length = GetModuleFileNameW(module, buffer.data(), static_cast<DWORD>(buffer.size()));
+
+	if (length > 0u && length < buffer.size())
+	{
+		modulePath = std::wstring(buffer.data(), length);
+	}
+#elif __linux__
+	struct ModuleSearch
+	{
+		/** Address to find the module of, or nullptr for the executable. */
+		void const*	address				= nullptr;
+
+		/** Is the module found? */
+		bool		isFound				= false;
+
+		/** Hash of the build ID of the module, or 0 if it has none. */
+		uint64		buildIdHash			= 0u;
+
+		/** Path to the module, empty for the executable. */
+		std::string	path;
+	};
+
+	ModuleSearch search;
+	search.address = address;
+
+	//The executable is always the first module reported
+	dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) -> int
+	{
+		ModuleSearch*	search		= static_cast<ModuleSearch*>(data);
+		bool			isSearched	= (search->address == nullptr);
+
+		for (ElfW(Half) i = 0u; i < info->dlpi_phnum && !isSearched; i++)
+		{
+			ElfW(Phdr) const&	header		= info->dlpi_phdr[i];
+			uintptr_t			address		= reinterpret_cast<uintptr_t>(search->address);
+			uintptr_t			segmentBegin	= info->dlpi_addr + header.p_vaddr;
+
+			isSearched = header.p_type == PT_LOAD && address >= segmentBegin && address < segmentBegin + header.p_memsz;
+		}
+
+		if (!isSearched)
+		{
+			return 0;
+		}
+
+		search->isFound	= true;
+		search->path	= info->dlpi_name;
+
+		//Look for the NT_GNU_BUILD_ID note, whose descriptor changes with any change of the binary
+		for (ElfW(Half) i = 0u; i < info->dlpi_phnum && search->buildIdHash == 0u; i++)
+		{
+			ElfW(Phdr) const& header = info->dlpi_phdr[i];
+
+			if (header.p_type != PT_NOTE)
+			{
+				continue;
+			}
+
+			char const* note	= reinterpret_cast<char const*>(info->dlpi_addr + header.p_vaddr);
+			char const* end		= note + header.p_memsz;
+
+			while (note + sizeof(ElfW(Nhdr)) <= end)
+			{
+				ElfW(Nhdr) const*	noteHeader		= reinterpret_cast<ElfW(Nhdr) const*>(note);
+				char const*			name			= note + sizeof(ElfW(Nhdr));
+				char const*			descriptor		= name + ((noteHeader->n_namesz + 3u) & ~3u);
+
+				if (noteHeader->n_type == NT_GNU_BUILD_ID && noteHeader->n_namesz == 4u && std::strcmp(name, "GNU") == 0)
+				{
+					search->buildIdHash = Helpers::computeHash(descriptor, noteHeader->n_descsz);
+					break;
+				}
+
+				note = descriptor + ((noteHeader->n_descsz + 3u) & ~3u);
+			}
+		}
+
+		return 1;
+	}, &search);
+
+	if (!search.isFound)
+	{
+		return 0u;
+	}
+	else if (search.buildIdHash != 0u)
+	{
+		return search.buildIdHash;
+	}
+
+	modulePath = (search.path.empty()) ? getExecutablePath() : fs::path(search.path);
+#else
+	if (address == nullptr)
+	{
+		modulePath = getExecutablePath();
+	}
+#endif
+
+	if (modulePath.empty())
+	{
+		return 0u;
+	}
+
+	//Without build ID, a rebuilt binary is detected by its last write time and size
+	std::error_code		error;
+	fs::file_time_type	lastWriteTime	= fs::last_write_time(modulePath, error);
+	uintmax_t			size			= fs::file_size(modulePath, error);
+
+	if (error)
+	{
+		return 0u;
+	}
+
+	uint64 fingerprint	= Helpers::computeHash(modulePath.string());
+	int64  writeTime	= static_cast<int64>(lastWriteTime.time_since_epoch().count());
+
+	fingerprint = Helpers::computeHash(&writeTime, sizeof(writeTime), fingerprint);
+
+	return Helpers::computeHash(&size, sizeof(size), fingerprint);
+}
+
+fs::path System::findExecutable(std::string const& executableName) noexcept
+{
+	char const* pathVariable = std::getenv("PATH");
+
+	if (pathVariable == nullptr)
+	{
+		return fs::path();
+	}
+
+#if _WIN32
+	constexpr char separator = ';';
+#else
+	constexpr char separator = ':';
+#endif
+
+	std::stringstream	directories(pathVariable);
+	std::string			directory;
+	std::error_code		error;
+
+	while (std::getline(directories, directory, separator))
+	{
+		if (directory.empty())
+		{
+			continue;
+		}
+
+		fs::path candidate = fs::path(directory) / executableName;
+
+		if (fs::is_regular_file(candidate, error))
+		{
+			return candidate;
+		}
+
+#if _WIN32
+		candidate += ".exe";
+
+		if (fs::is_regular_file(candidate, error))
+		{
+			return candidate;
+		}
+#endif
+	}
+
+	return fs::path();
+}
+
+fs::path System::getUserCacheDirectory() noexcept
+{
+#if _WIN32
+	char const* localAppData = std::getenv("LOCALAPPDATA");
+
+	return (localAppData != nullptr) ? fs::path(localAppData) : fs::path();
+#else
+	char const* cacheHome = std::getenv("XDG_CACHE_HOME");
+
+	if (cacheHome != nullptr && cacheHome[0] != '\0')
+	{
+		return fs::path(cacheHome);
+	}
+
+	char const* home = std::getenv("HOME");
+
+	return (home != nullptr) ? fs::path(home) / ".cache" : fs::path();
+#endif
+}
+
+fs::path System::getCgroupDirectory() noexcept
+{
+#if __linux__
+	std::ifstream	cgroupFile("/proc/self/cgroup");
+	std::string		line;
+
+	//The cgroup v2 hierarchy is the entry with the hierarchy ID 0 and no controller list
+	while (std::getline(cgroupFile, line))
+	{
+		if (line.compare(0u, 3u, "0::") == 0)
+		{
+			std::error_code	error;
+			fs::path		cgroupDirectory = fs::path("/sys/fs/cgroup") / fs::path(line.substr(3u)).relative_path();
+
+			//With a cgroup namespace, the root of the hierarchy is the cgroup of the process
+			return fs::is_directory(cgroupDirectory, error) ? cgroupDirectory : fs::path("/sys/fs/cgroup");
+		}
+	}
+#endif
+
+	return fs::path();
+}
+
+uint64 System::readCgroupLimit(char const* limitFilename, uint64 (*readLimit)(std::string const&)) noexcept
+{
+	fs::path	cgroupDirectory	= getCgroupDirectory();
+	uint64		result			= 0u;
+
+	if (cgroupDirectory.empty())
+	{
+		return 0u;
+	}
+
+	//A cgroup is limited by the limits of all its ancestors
+	for (fs::path directory = cgroupDirectory; ; directory = directory.parent_path())
+	{
+		std::ifstream	limitFile(directory / limitFilename);
+		std::string		line;
+
+		if (std::getline(limitFile, line))
+		{
+			uint64 limit = readLimit(line);
+
+			if (limit != 0u)
+			{
+				result = (result == 0u) ? limit : std::min(result, limit);
+			}
+		}
+
+		if (directory == "/sys/fs/cgroup" || !directory.has_relative_path())
+		{
+			break;
+		}
+	}
+
+	return result;
+}
+
+uint32 System::getCpuQuota() noexcept
+{
+	//cpu.max contains "$MAX $PERIOD", $MAX being "max" if there is no quota
+	return static_cast<uint32>(readCgroupLimit("cpu.max", [](std::string const& line) -> uint64
+	{
+		std::stringstream	stream(line);
+		std::string			quota;
+		uint64				period = 0u;
+
+		stream >> quota >> period;
+
+		if (quota == "max" || period == 0u || quota.find_first_not_of("0123456789") != std::string::npos)
+		{
+			return 0u;
+		}
+
+		return (std::stoull(quota) + period - 1u) / period;
+	}));
+}
+
+uint32 System::getThreadCount(uint32 initialThreadCount) noexcept
+{
+	if (initialThreadCount == 0)
+	{
+		//Use hardware_concurrency if possible
+		initialThreadCount = std::thread::hardware_concurrency();
+
+		//If hardware_concurrency hints to 0, use 8 threads
+		if (initialThreadCount == 0)
+		{
+			initialThreadCount = 8u;
+		}
+
+		//Containers often get a fraction of the host CPUs
+		uint32 cpuQuota = System::getCpuQuota();
+
+		if (cpuQuota != 0u)
+		{
+			initialThreadCount = std::min(initialThreadCount, cpuQuota);
+		}
+	}
+
+	return initialThreadCount;
+}
+
+uint64 System::getMemoryLimit() noexcept
+{
+	//memory.max contains a number of bytes, or "max" if there is no limit
+	return readCgroupLimit("memory.max", [](std::string const& line) -> uint64
+	{
+		return (line.empty() || line.find_first_not_of("0123456789") != std::string::npos) ? 0u : std::stoull(line);
+	});
+}
+
+uint64 System::getResidentMemory() noexcept
+{
+#if __linux__
+	//statm contains the total program size, then the resident set size, in pages
+	std::ifstream	statmFile("/proc/self/statm");
+	uint64			programSize		= 0u;
+	uint64			residentPages	= 0u;
+
+	if (statmFile >> programSize >> residentPages)
+	{
+		return residentPages * static_cast<uint64>(sysconf(_SC_PAGESIZE));
+	}
+#endif
+
+	return 0u;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Kodgen/Parsing/FileParser.h"
 
 #include <cassert>
+#include <chrono>	//std::chrono::steady_clock
 
 #include "Kodgen/Misc/Helpers.h"
 #include "Kodgen/Misc/DisableWarningMacros.h"
@@ -19,7 +20,10 @@ FileParser::FileParser(FileParser const& other) noexcept:
 	NamespaceParser(other),
 	_clangIndex{clang_createIndex(0, 0)},	//Don't copy clang index, create a new one
 	_settings{other._settings},
-	logger{other.logger}
+	logger{other.logger},
+	translationUnitCache{other.translationUnitCache},
+	unsavedFileOverlay{other.unsavedFileOverlay},
+	hashedIncludeDirectories{other.hashedIncludeDirectories}
 {
 }
 
@@ -28,7 +32,10 @@ FileParser::FileParser(FileParser&& other) noexcept:
 	_clangIndex{std::forward<CXIndex>(other._clangIndex)},
 	_propertyParser(std::forward<PropertyParser>(other._propertyParser)),
 	_settings{other._settings},
-	logger{other.logger}
+	logger{other.logger},
+	translationUnitCache{std::move(other.translationUnitCache)},
+	unsavedFileOverlay{std::move(other.unsavedFileOverlay)},
+	hashedIncludeDirectories{std::move(other.hashedIncludeDirectories)}
 {
 	other._clangIndex = nullptr;
 }
@@ -49,10 +56,18 @@ bool FileParser::parse(fs::path const& toParseFile, FileParsingResult& out_resul
 
 	preParse(toParseFile);
 
-	if (fs::exists(toParseFile) && !fs::is_directory(toParseFile))
+	//Files overlaid in memory don't need to exist on disk
+	UnsavedFileOverlay::Snapshot	unsavedFiles	= (unsavedFileOverlay != nullptr) ? unsavedFileOverlay->takeSnapshot() : UnsavedFileOverlay::Snapshot();
+	fs::path						overlaidFile	= (unsavedFileOverlay != nullptr) ? UnsavedFileOverlay::normalizePath(toParseFile) : fs::path();
+
+	//The overlay can change while parsing, so only the snapshot provided to libclang tells whether the file is overlaid
+	bool							isOverlaid		= unsavedFileOverlay != nullptr && unsavedFiles.contains(overlaidFile);
+	fs::path						clangFile		= (isOverlaid) ? overlaidFile : toParseFile;
+
+	if (isOverlaid || (fs::exists(toParseFile) && !fs::is_directory(toParseFile)))
 	{
 		//Fill the parsed file info
-		out_result.parsedFile = FilesystemHelpers::sanitizePath(toParseFile);
+		out_result.parsedFile = (isOverlaid) ? clangFile : FilesystemHelpers::sanitizePath(toParseFile);
 
 		{
 	        // 获取Clang版本信息
@@ -65,8 +80,17 @@ bool FileParser::parse(fs::path const& toParseFile, FileParsingResult& out_resul
 	        clang_disposeString(clangVersion);
 		}
 
+		auto parsingStart = std::chrono::steady_clock::now();
+
 		//Parse the given file
-		CXTranslationUnit translationUnit = clang_parseTranslationUnit(_clangIndex, toParseFile.string().c_str(), _settings->getCompilationArguments().data(), static_cast<int32>(_settings->getCompilationArguments().size()), nullptr, 0, CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_Incomplete | CXTranslationUnit_KeepGoing);
+		unsigned			parsingOptions	= CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_Incomplete | CXTranslationUnit_KeepGoing;
+		CXTranslationUnit	translationUnit	= (translationUnitCache != nullptr) ?
+												translationUnitCache->acquire(clangFile, _settings->getCompilationArguments(), parsingOptions, unsavedFiles.getUnsavedFiles(), unsavedFiles.getUnsavedFilesCount()) :
+												clang_parseTranslationUnit(_clangIndex, clangFile.string().c_str(), _settings->getCompilationArguments().data(), static_cast<int32>(_settings->getCompilationArguments().size()), unsavedFiles.getUnsavedFiles(), unsavedFiles.getUnsavedFilesCount(), parsingOptions);
+
+		auto extractionStart = std::chrono::steady_clock::now();
+
+		out_result.translationUnitParsingDuration = std::chrono::duration<float>(extractionStart - parsingStart).count();
 
 		if (translationUnit != nullptr)
 		{
@@ -81,6 +105,14 @@ bool FileParser::parse(fs::path const& toParseFile, FileParsingResult& out_resul
 				//Refresh all outer entities contained in the final result
 				refreshOuterEntity(out_result);
 
+				//Keep track of all included files so that dependent files can be detected
+				InclusionCollection inclusions;
+				inclusions.result					= &out_result;
+				inclusions.translationUnit			= translationUnit;
+				inclusions.hashedIncludeDirectories	= (translationUnitCache == nullptr) ? &hashedIncludeDirectories : nullptr;
+
+				clang_getInclusions(translationUnit, &FileParser::collectInclusion, &inclusions);
+
 				isSuccess = true;
 			}
 
@@ -89,12 +121,21 @@ bool FileParser::parse(fs::path const& toParseFile, FileParsingResult& out_resul
 			//There should not have any context left once parsing has finished
 			assert(contextsStack.empty());
 
+			out_result.entityExtractionDuration = std::chrono::duration<float>(std::chrono::steady_clock::now() - extractionStart).count();
+
 			if (_settings->shouldLogDiagnostic)
 			{
 				logDiagnostic(translationUnit);
 			}
 
-			clang_disposeTranslationUnit(translationUnit);
+			if (translationUnitCache != nullptr)
+			{
+				translationUnitCache->release(clangFile, translationUnit);
+			}
+			else
+			{
+				clang_disposeTranslationUnit(translationUnit);
+			}
 		}
 		else
 		{
@@ -111,6 +152,56 @@ bool FileParser::parse(fs::path const& toParseFile, FileParsingResult& out_resul
 	return isSuccess;
 }
 
+bool FileParser::buildPrecompiledHeader(fs::path const& headerFile, fs::path const& precompiledHeaderFile, std::vector<fs::path>& out_includedFiles) noexcept
+{
+	assert(_settings.use_count() != 0);
+
+	CXTranslationUnit translationUnit = clang_parseTranslationUnit(_clangIndex, headerFile.string().c_str(), _settings->getCompilationArguments().data(), static_cast<int32>(_settings->getCompilationArguments().size()), nullptr, 0, CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_Incomplete | CXTranslationUnit_ForSerialization);
+
+	if (translationUnit == nullptr)
+	{
+		return false;
+	}
+
+	bool isSuccess = true;
+
+	//A precompiled header containing errors would make all parsings fail
+	for (unsigned i = 0u; i < clang_getNumDiagnostics(translationUnit) && isSuccess; i++)
+	{
+		CXDiagnostic diagnostic = clang_getDiagnostic(translationUnit, i);
+
+		if (clang_getDiagnosticSeverity(diagnostic) >= CXDiagnostic_Error)
+		{
+			if (logger != nullptr)
+			{
+				logger->log(Helpers::getString(clang_formatDiagnostic(diagnostic, clang_defaultDiagnosticDisplayOptions())), ILogger::ELogSeverity::Error);
+			}
+
+			isSuccess = false;
+		}
+
+		clang_disposeDiagnostic(diagnostic);
+	}
+
+	if (isSuccess)
+	{
+		FileParsingResult	result;
+		InclusionCollection	inclusions;
+		inclusions.result			= &result;
+		inclusions.translationUnit	= translationUnit;
+
+		clang_getInclusions(translationUnit, &FileParser::collectInclusion, &inclusions);
+
+		out_includedFiles = std::move(result.includedFiles);
+
+		isSuccess = clang_saveTranslationUnit(translationUnit, precompiledHeaderFile.string().c_str(), clang_defaultSaveOptions(translationUnit)) == CXSaveError_None;
+	}
+
+	clang_disposeTranslationUnit(translationUnit);
+
+	return isSuccess;
+}
+
 CXChildVisitResult FileParser::parseNestedEntity(CXCursor cursor, CXCursor /* parentCursor */, CXClientData clientData) noexcept
 {
 	FileParser*	parser	= reinterpret_cast<FileParser*>(clientData);
@@ -161,6 +252,46 @@ CXChildVisitResult FileParser::parseNestedEntity(CXCursor cursor, CXCursor /* pa
 	return visitResult;
 }
 
+void FileParser::collectInclusion(CXFile includedFile, CXSourceLocation* /* inclusionStack */, unsigned includeLength, CXClientData clientData) noexcept
+{
+	//The main file is reported with an empty inclusion stack, skip it
+	if (includeLength != 0u)
+	{
+		InclusionCollection*	inclusions		= reinterpret_cast<InclusionCollection*>(clientData);
+		fs::path				includedPath	= Helpers::getString(clang_getFileName(includedFile));
+		fs::path				normalizedPath	= includedPath.lexically_normal();
+
+		//Lexical normalization is wrong when a symlink is followed by .. (ex: /lib/gcc/../../include with /lib -> usr/lib)
+		if (!fs::exists(normalizedPath))
+		{
+			std::error_code error;
+			normalizedPath = fs::weakly_canonical(includedPath, error);
+		}
+
+		if (inclusions->hashedIncludeDirectories != nullptr)
+		{
+			for (fs::path const& hashedIncludeDirectory : *inclusions->hashedIncludeDirectories)
+			{
+				if (FilesystemHelpers::isChildPath(normalizedPath, hashedIncludeDirectory))
+				{
+					//Hash the buffer libclang parsed rather than the file on disk, which might have been rewritten since
+					size_t		contentSize	= 0u;
+					char const*	content		= clang_getFileContents(inclusions->translationUnit, includedFile, &contentSize);
+
+					if (content != nullptr)
+					{
+						inclusions->result->includedFilesHashes.emplace(normalizedPath, Helpers::computeHash(content, contentSize));
+					}
+
+					break;
+				}
+			}
+		}
+
+		inclusions->result->includedFiles.emplace_back(std::move(normalizedPath));
+	}
+}
+
 ParsingContext& FileParser::pushContext(CXTranslationUnit const& translationUnit, FileParsingResult& out_result) noexcept
 {
 	_propertyParser.setup(_settings->propertyParsingSettings);
@@ -0,0 +1,10 @@
+#include "Kodgen/Parsing/ParsingManager.h"
+
+#include "Kodgen/Misc/System.h"
+
+using namespace kodgen;
+
+ParsingManager::ParsingManager(uint32 threadCount) noexcept:
+	_threadPool(System::getThreadCount(threadCount), ETerminationMode::FinishAll)
+{
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Kodgen/Parsing/ParsingSettings.h"
 
+#include <algorithm>	//std::sort
+
 #include "Kodgen/Misc/CompilerHelpers.h"
 #include "Kodgen/Misc/TomlUtility.h"
 #include "Kodgen/Misc/ILogger.h"
@@ -84,6 +86,7 @@ void ParsingSettings::refreshBuildCommandStrings(ILogger* logger) noexcept
 void ParsingSettings::refreshCompilationArguments(ILogger* logger) noexcept
 {
 	_compilationArguments.clear();
+	_precompiledHeaderPath.clear();
 
 	refreshBuildCommandStrings(logger);
 
@@ -142,6 +145,8 @@ bool ParsingSettings::loadSettingsValues(toml::value const& tomlData, ILogger* l
 		loadShouldLogDiagnostic(tomlParsingSettings, logger);
 		loadCompilerExeName(tomlParsingSettings, logger);
 		loadProjectIncludeDirectories(tomlParsingSettings, logger);
+		loadShouldUsePrecompiledHeader(tomlParsingSettings, logger);
+		loadPrecompiledHeaderIncludes(tomlParsingSettings, logger);
 
 		return propertyParsingSettings.loadSettingsValues(tomlParsingSettings, logger);
 	}
@@ -298,6 +303,25 @@ void ParsingSettings::loadProjectIncludeDirectories(toml::value const& parsingSe
 	}
 }
 
+void ParsingSettings::loadShouldUsePrecompiledHeader(toml::value const& parsingSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(parsingSettings, "shouldUsePrecompiledHeader", shouldUsePrecompiledHeader, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldUsePrecompiledHeader: " + Helpers::toString(shouldUsePrecompiledHeader));
+	}
+}
+
+void ParsingSettings::loadPrecompiledHeaderIncludes(toml::value const& parsingSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(parsingSettings, "precompiledHeaderIncludes", precompiledHeaderIncludes, logger) && logger != nullptr)
+	{
+		for (std::string const& include : precompiledHeaderIncludes)
+		{
+			logger->log("[TOML] Load new precompiled header include: " + include);
+		}
+	}
+}
+
 bool ParsingSettings::addProjectIncludeDirectory(fs::path const& directoryPath) noexcept
 {
 	fs::path sanitizedPath = FilesystemHelpers::sanitizePath(directoryPath);
@@ -335,6 +359,23 @@ std::vector<char const*> const& ParsingSettings::getCompilationArguments() const
 	return _compilationArguments;
 }
 
+void ParsingSettings::setPrecompiledHeader(fs::path const& precompiledHeaderPath) noexcept
+{
+	//Precompiled header arguments are always the last 2 compilation arguments
+	if (!_precompiledHeaderPath.empty())
+	{
+		_compilationArguments.resize(_compilationArguments.size() - 2u);
+	}
+
+	_precompiledHeaderPath = precompiledHeaderPath.string();
+
+	if (!_precompiledHeaderPath.empty())
+	{
+		_compilationArguments.emplace_back("-include-pch");
+		_compilationArguments.emplace_back(_precompiledHeaderPath.data());
+	}
+}
+
 bool ParsingSettings::setCompilerExeName(std::string const& compilerExeName) noexcept
 {
 	if (CompilerHelpers::isSupportedCompiler(compilerExeName))
@@ -345,4 +386,48 @@ bool ParsingSettings::setCompilerExeName(std::string const& compilerExeName) noe
 	}
 
 	return false;
+}
+
+uint64 ParsingSettings::computeFingerprint() const noexcept
+{
+	//Sort include directories so that the fingerprint doesn't depend on the unordered_set iteration order
+	std::vector<std::string> includeDirectories;
+	includeDirectories.reserve(_projectIncludeDirectories.size());
+
+	for (fs::path const& includeDirectory : _projectIncludeDirectories)
+	{
+		includeDirectories.emplace_back(includeDirectory.string());
+	}
+
+	std::sort(includeDirectories.begin(), includeDirectories.end());
+
+	uint64 fingerprint = Helpers::computeHash(_compilerExeName);
+
+	for (std::string const& includeDirectory : includeDirectories)
+	{
+		fingerprint = Helpers::computeHash(includeDirectory, fingerprint);
+	}
+
+	bool const flags[] = {	shouldParseAllNamespaces, shouldParseAllClasses, shouldParseAllStructs,
+							shouldParseAllVariables, shouldParseAllFields, shouldParseAllFunctions,
+							shouldParseAllMethods, shouldParseAllEnums, shouldParseAllEnumValues };
+
+	fingerprint = Helpers::computeHash(&cppVersion, sizeof(cppVersion), fingerprint);
+	fingerprint = Helpers::computeHash(flags, sizeof(flags), fingerprint);
+
+	//Property parsing settings
+	fingerprint = Helpers::computeHash(&propertyParsingSettings.propertySeparator, sizeof(char), fingerprint);
+	fingerprint = Helpers::computeHash(&propertyParsingSettings.argumentSeparator, sizeof(char), fingerprint);
+	fingerprint = Helpers::computeHash(propertyParsingSettings.argumentEnclosers, sizeof(propertyParsingSettings.argumentEnclosers), fingerprint);
+
+	for (std::string const* macroName : {	&propertyParsingSettings.namespaceMacroName, &propertyParsingSettings.classMacroName,
+											&propertyParsingSettings.structMacroName, &propertyParsingSettings.variableMacroName,
+											&propertyParsingSettings.fieldMacroName, &propertyParsingSettings.functionMacroName,
+											&propertyParsingSettings.methodMacroName, &propertyParsingSettings.enumMacroName,
+											&propertyParsingSettings.enumValueMacroName })
+	{
+		fingerprint = Helpers::computeHash(*macroName, fingerprint);
+	}
+
+	return fingerprint;
 }
\ No newline at end of file
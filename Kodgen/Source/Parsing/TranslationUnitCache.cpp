@@ -0,0 +1,209 @@
+#include "Kodgen/Parsing/TranslationUnitCache.h"
+
+#include <cstring>	//std::strcmp
+#include <algorithm>	//std::min_element
+#include <unordered_set>
+
+#include "Kodgen/Misc/Helpers.h"
+
+using namespace kodgen;
+
+TranslationUnitCache::TranslationUnitCache(uint32 capacity) noexcept:
+	_capacity{capacity}
+{
+}
+
+TranslationUnitCache::~TranslationUnitCache() noexcept
+{
+	clear();
+
+	//Translation units still being used are disposed as well since nobody can release them anymore
+	for (auto& [translationUnit, cachedTranslationUnit] : _acquiredTranslationUnits)
+	{
+		dispose(cachedTranslationUnit);
+	}
+}
+
+uint64 TranslationUnitCache::computeFingerprint(std::vector<char const*> const& compilationArguments, unsigned parsingOptions) noexcept
+{
+	uint64			fingerprint = Helpers::computeHash(std::to_string(parsingOptions));
+	std::error_code	error;
+
+	for (size_t i = 0u; i < compilationArguments.size(); i++)
+	{
+		fingerprint = Helpers::computeHash(std::string(compilationArguments[i]), fingerprint);
+
+		if (std::strcmp(compilationArguments[i], "-include-pch") == 0 && i + 1u < compilationArguments.size())
+		{
+			fs::file_time_type lastWriteTime = fs::last_write_time(compilationArguments[i + 1u], error);
+
+			if (!error)
+			{
+				fingerprint = Helpers::computeHash(std::to_string(lastWriteTime.time_since_epoch().count()), fingerprint);
+			}
+		}
+	}
+
+	return fingerprint;
+}
+
+void TranslationUnitCache::dispose(CachedTranslationUnit& cachedTranslationUnit) noexcept
+{
+	if (cachedTranslationUnit.translationUnit != nullptr)
+	{
+		clang_disposeTranslationUnit(cachedTranslationUnit.translationUnit);
+		cachedTranslationUnit.translationUnit = nullptr;
+	}
+
+	if (cachedTranslationUnit.index != nullptr)
+	{
+		clang_disposeIndex(cachedTranslationUnit.index);
+		cachedTranslationUnit.index = nullptr;
+	}
+}
+
+CXTranslationUnit TranslationUnitCache::acquire(fs::path const& file, std::vector<char const*> const& compilationArguments, unsigned parsingOptions, CXUnsavedFile* unsavedFiles, unsigned unsavedFilesCount) noexcept
+{
+	CachedTranslationUnit	cachedTranslationUnit;
+	fs::path				normalizedFile	= file.lexically_normal();
+	uint64					fingerprint		= computeFingerprint(compilationArguments, parsingOptions);
+
+	//Take the cached translation unit out of the cache so that no other thread can use it
+	{
+		std::lock_guard lock(_mutex);
+
+		auto it = _translationUnits.find(normalizedFile);
+
+		if (it != _translationUnits.end())
+		{
+			cachedTranslationUnit = it->second;
+			_translationUnits.erase(it);
+		}
+	}
+
+	if (cachedTranslationUnit.translationUnit != nullptr)
+	{
+		//A translation unit that failed to reparse is invalid and must be disposed
+		if (cachedTranslationUnit.fingerprint != fingerprint ||
+			clang_reparseTranslationUnit(cachedTranslationUnit.translationUnit, unsavedFilesCount, unsavedFiles, clang_defaultReparseOptions(cachedTranslationUnit.translationUnit)) != 0)
+		{
+			dispose(cachedTranslationUnit);
+		}
+	}
+
+	if (cachedTranslationUnit.translationUnit == nullptr)
+	{
+		//Each translation unit has its own index so that translation units never share state between threads
+		cachedTranslationUnit.index				= clang_createIndex(0, 0);
+		cachedTranslationUnit.fingerprint		= fingerprint;
+		cachedTranslationUnit.translationUnit	= clang_parseTranslationUnit(cachedTranslationUnit.index, file.string().c_str(), compilationArguments.data(), static_cast<int32>(compilationArguments.size()), unsavedFiles, unsavedFilesCount, parsingOptions | CXTranslationUnit_PrecompiledPreamble | CXTranslationUnit_CreatePreambleOnFirstParse);
+
+		if (cachedTranslationUnit.translationUnit == nullptr)
+		{
+			dispose(cachedTranslationUnit);
+
+			return nullptr;
+		}
+	}
+
+	std::lock_guard lock(_mutex);
+
+	_acquiredTranslationUnits.emplace(cachedTranslationUnit.translationUnit, cachedTranslationUnit);
+
+	return cachedTranslationUnit.translationUnit;
+}
+
+void TranslationUnitCache::release(fs::path const& file, CXTranslationUnit translationUnit) noexcept
+{
+	std::vector<CachedTranslationUnit> evictedTranslationUnits;
+
+	{
+		std::lock_guard lock(_mutex);
+
+		auto it = _acquiredTranslationUnits.find(translationUnit);
+
+		if (it == _acquiredTranslationUnits.end())
+		{
+			return;
+		}
+
+		CachedTranslationUnit& previousTranslationUnit = _translationUnits[file.lexically_normal()];
+
+		//Should not happen unless the same file is acquired twice at the same time
+		if (previousTranslationUnit.translationUnit != nullptr)
+		{
+			evictedTranslationUnits.push_back(previousTranslationUnit);
+		}
+
+		previousTranslationUnit			= it->second;
+		previousTranslationUnit.lastUse	= ++_useCounter;
+		_acquiredTranslationUnits.erase(it);
+
+		//Evict the least recently used translation units, the released one being the most recently used
+		while (!_translationUnits.empty() && _translationUnits.size() + _acquiredTranslationUnits.size() > _capacity)
+		{
+			auto leastRecentlyUsed = std::min_element(_translationUnits.begin(), _translationUnits.end(), [](auto const& lhs, auto const& rhs)
+			{
+				return lhs.second.lastUse < rhs.second.lastUse;
+			});
+
+			evictedTranslationUnits.push_back(leastRecentlyUsed->second);
+			_translationUnits.erase(leastRecentlyUsed);
+		}
+	}
+
+	//Disposing a translation unit frees its whole AST, so don't hold the lock meanwhile
+	for (CachedTranslationUnit& evictedTranslationUnit : evictedTranslationUnits)
+	{
+		dispose(evictedTranslationUnit);
+	}
+}
+
+void TranslationUnitCache::retain(std::vector<fs::path> const& files) noexcept
+{
+	std::unordered_set<fs::path, PathHash> retainedFiles;
+
+	for (fs::path const& file : files)
+	{
+		retainedFiles.emplace(file.lexically_normal());
+	}
+
+	std::lock_guard lock(_mutex);
+
+	for (auto it = _translationUnits.begin(); it != _translationUnits.end();)
+	{
+		if (retainedFiles.find(it->first) == retainedFiles.cend())
+		{
+			dispose(it->second);
+			it = _translationUnits.erase(it);
+		}
+		else
+		{
+			it++;
+		}
+	}
+}
+
+void TranslationUnitCache::clear() noexcept
+{
+	std::lock_guard lock(_mutex);
+
+	for (auto& [file, cachedTranslationUnit] : _translationUnits)
+	{
+		dispose(cachedTranslationUnit);
+	}
+
+	_translationUnits.clear();
+}
+
+size_t TranslationUnitCache::getCachedTranslationUnitsCount() noexcept
+{
+	std::lock_guard lock(_mutex);
+
+	return _translationUnits.size();
+}
+
+uint32 TranslationUnitCache::getCapacity() const noexcept
+{
+	return _capacity;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "Kodgen/Parsing/UnsavedFileOverlay.h"
+
+#include <mutex>	//std::unique_lock
+
+using namespace kodgen;
+
+CXUnsavedFile* UnsavedFileOverlay::Snapshot::getUnsavedFiles() noexcept
+{
+	return _unsavedFiles.empty() ? nullptr : _unsavedFiles.data();
+}
+
+unsigned UnsavedFileOverlay::Snapshot::getUnsavedFilesCount() const noexcept
+{
+	return static_cast<unsigned>(_unsavedFiles.size());
+}
+
+bool UnsavedFileOverlay::Snapshot::contains(fs::path const& normalizedFile) const noexcept
+{
+	std::string const normalizedFilename = normalizedFile.string();
+
+	for (std::shared_ptr<std::string const> const& filename : _filenames)
+	{
+		if (*filename == normalizedFilename)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+fs::path UnsavedFileOverlay::normalizePath(fs::path const& path) noexcept
+{
+	std::error_code	error;
+	fs::path		normalizedPath = fs::weakly_canonical(fs::absolute(path, error), error);
+
+	return (error) ? fs::absolute(path, error).lexically_normal().make_preferred() : normalizedPath.make_preferred();
+}
+
+void UnsavedFileOverlay::setContent(fs::path const& file, std::shared_ptr<std::string const> content) noexcept
+{
+	fs::path	normalizedFile = normalizePath(file);
+	Entry		entry{ std::make_shared<std::string const>(normalizedFile.string()), (content != nullptr) ? std::move(content) : std::make_shared<std::string const>() };
+
+	std::unique_lock lock(_mutex);
+
+	_entries[normalizedFile] = std::move(entry);
+}
+
+void UnsavedFileOverlay::setContent(fs::path const& file, std::string content) noexcept
+{
+	setContent(file, std::make_shared<std::string const>(std::move(content)));
+}
+
+bool UnsavedFileOverlay::removeContent(fs::path const& file) noexcept
+{
+	fs::path normalizedFile = normalizePath(file);
+
+	std::unique_lock lock(_mutex);
+
+	return _entries.erase(normalizedFile) != 0u;
+}
+
+void UnsavedFileOverlay::clear() noexcept
+{
+	std::unique_lock lock(_mutex);
+
+	_entries.clear();
+}
+
+std::shared_ptr<std::string const> UnsavedFileOverlay::getContent(fs::path const& file) const noexcept
+{
+	fs::path normalizedFile = normalizePath(file);
+
+	std::shared_lock lock(_mutex);
+
+	auto it = _entries.find(normalizedFile);
+
+	return (it != _entries.end()) ? it->second.content : nullptr;
+}
+
+bool UnsavedFileOverlay::isEmpty() const noexcept
+{
+	std::shared_lock lock(_mutex);
+
+	return _entries.empty();
+}
+
+UnsavedFileOverlay::Snapshot UnsavedFileOverlay::takeSnapshot() const noexcept
+{
+	Snapshot snapshot;
+
+	{
+		std::shared_lock lock(_mutex);
+
+		snapshot._filenames.reserve(_entries.size());
+		snapshot._contents.reserve(_entries.size());
+
+		for (auto const& [file, entry] : _entries)
+		{
+			snapshot._filenames.push_back(entry.filename);
+			snapshot._contents.push_back(entry.content);
+		}
+	}
+
+	//Unsaved files reference the shared strings, which are kept alive by the snapshot
+	snapshot._unsavedFiles.reserve(snapshot._contents.size());
+
+	for (size_t i = 0u; i < snapshot._contents.size(); i++)
+	{
+		snapshot._unsavedFiles.push_back(CXUnsavedFile{ snapshot._filenames[i]->c_str(), snapshot._contents[i]->data(), static_cast<unsigned long>(snapshot._contents[i]->size()) });
+	}
+
+	return snapshot;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "Kodgen/Threading/MemoryBudgetController.h"
+
+#include <algorithm>	//std::clamp, std::max
+
+using namespace kodgen;
+
+MemoryBudgetController::MemoryBudgetController(uint64 memoryBudget, uint32 maxAdmittedCount, MemorySampler memorySampler) noexcept:
+	_memorySampler{memorySampler},
+	_memoryBudget{memoryBudget},
+	_baselineMemory{memorySampler()},
+	_maxAdmittedCount{std::max(maxAdmittedCount, 1u)},
+	_admittedLimit{std::max(maxAdmittedCount, 1u)}
+{
+}
+
+MemoryBudgetController::Admission::Admission(MemoryBudgetController* controller) noexcept:
+	_controller{controller}
+{
+	if (_controller != nullptr)
+	{
+		_controller->acquire();
+	}
+}
+
+MemoryBudgetController::Admission::~Admission() noexcept
+{
+	if (_controller != nullptr)
+	{
+		_controller->release();
+	}
+}
+
+void MemoryBudgetController::sampleMemory() noexcept
+{
+	uint64 memory = _memorySampler();
+
+	if (_admittedCount == 0u)
+	{
+		//No task is running, so all the memory is kept by something else (parsing results, caches, heap not returned to the system...)
+		_baselineMemory = memory;
+	}
+	else
+	{
+		//Memory used on top of the last idle sample is attributed to running tasks evenly
+		uint64 taskMemory = (memory > _baselineMemory) ? (memory - _baselineMemory) / _admittedCount : 0u;
+
+		//Smooth samples, which are noisy since tasks are sampled at different stages of their execution
+		_taskMemoryEstimate = (_taskMemoryEstimate == 0u) ? taskMemory : (_taskMemoryEstimate * 3u + taskMemory) / 4u;
+	}
+
+	if (_taskMemoryEstimate == 0u)
+	{
+		_admittedLimit = _maxAdmittedCount;
+	}
+	else
+	{
+		//Memory which is not used by running tasks can grow while they run, so the headroom is computed from the current memory
+		uint64 inFlightMemory	= _admittedCount * _taskMemoryEstimate;
+		uint64 otherMemory		= (memory > inFlightMemory) ? memory - inFlightMemory : 0u;
+		uint64 headroom			= (_memoryBudget > otherMemory) ? _memoryBudget - otherMemory : 0u;
+
+		_admittedLimit = static_cast<uint32>(std::clamp<uint64>(headroom / _taskMemoryEstimate, 1u, _maxAdmittedCount));
+	}
+}
+
+void MemoryBudgetController::acquire() noexcept
+{
+	std::unique_lock lock(_mutex);
+
+	sampleMemory();
+
+	_admissionCondition.wait(lock, [this]() { return _admittedCount < _admittedLimit; });
+
+	_admittedCount++;
+}
+
+void MemoryBudgetController::release() noexcept
+{
+	{
+		std::lock_guard lock(_mutex);
+
+		_admittedCount--;
+
+		//Sample once the task is not counted anymore, since its memory has just been released
+		sampleMemory();
+	}
+
+	_admissionCondition.notify_all();
+}
+
+uint32 MemoryBudgetController::getAdmittedLimit() const noexcept
+{
+	std::lock_guard lock(_mutex);
+
+	return _admittedLimit;
+}
+
+uint64 MemoryBudgetController::getTaskMemoryEstimate() const noexcept
+{
+	std::lock_guard lock(_mutex);
+
+	return _taskMemoryEstimate;
+}
\ No newline at end of file
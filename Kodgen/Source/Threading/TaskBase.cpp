@@ -4,10 +4,57 @@ using namespace kodgen;
 
 TaskBase::TaskBase(char const* name, std::vector<std::shared_ptr<TaskBase>>&& deps) noexcept:
 	_name{name},
+	_remainingDependenciesCount{0u},
 	dependencies{std::forward<std::vector<std::shared_ptr<TaskBase>>>(deps)}
 {
 }
 
+bool TaskBase::addDependent(std::shared_ptr<TaskBase> const& dependent) noexcept
+{
+	std::lock_guard lock(_dependentsMutex);
+
+	if (_isCompleted)
+	{
+		return false;
+	}
+
+	//Increment the counter before registering so that the dependent can't be notified before being counted
+	dependent->_remainingDependenciesCount.fetch_add(1u);
+	_dependents.emplace_back(dependent);
+
+	return true;
+}
+
+std::vector<std::shared_ptr<TaskBase>> TaskBase::complete() noexcept
+{
+	std::vector<std::shared_ptr<TaskBase>> result;
+
+	{
+		std::lock_guard lock(_dependentsMutex);
+
+		_isCompleted = true;
+
+		//Move dependents out so that this task doesn't keep them alive anymore
+		result = std::move(_dependents);
+	}
+
+	_completionCondition.notify_all();
+
+	return result;
+}
+
+void TaskBase::wait() noexcept
+{
+	std::unique_lock lock(_dependentsMutex);
+
+	_completionCondition.wait(lock, [this]() { return _isCompleted; });
+}
+
+bool TaskBase::isReadyToExecute() const noexcept
+{
+	return _remainingDependenciesCount.load() == 0u;
+}
+
 std::string const& TaskBase::getName() const noexcept
 {
 	return _name;
@@ -0,0 +1,50 @@
+#include "Kodgen/Threading/TaskQueue.h"
+
+using namespace kodgen;
+
+void TaskQueue::pushBack(std::shared_ptr<TaskBase> task) noexcept
+{
+	std::lock_guard lock(_mutex);
+
+	_tasks.emplace_back(std::move(task));
+}
+
+std::shared_ptr<TaskBase> TaskQueue::popBack() noexcept
+{
+	std::lock_guard lock(_mutex);
+
+	if (_tasks.empty())
+	{
+		return nullptr;
+	}
+
+	std::shared_ptr<TaskBase> result = std::move(_tasks.back());
+	_tasks.pop_back();
+
+	return result;
+}
+
+std::shared_ptr<TaskBase> TaskQueue::popFront() noexcept
+{
+	std::lock_guard lock(_mutex);
+
+	if (_tasks.empty())
+	{
+		return nullptr;
+	}
+
+	std::shared_ptr<TaskBase> result = std::move(_tasks.front());
+	_tasks.pop_front();
+
+	return result;
+}
+
+std::vector<std::shared_ptr<TaskBase>> TaskQueue::clear() noexcept
+{
+	std::lock_guard lock(_mutex);
+
+	std::vector<std::shared_ptr<TaskBase>> result(std::make_move_iterator(_tasks.begin()), std::make_move_iterator(_tasks.end()));
+	_tasks.clear();
+
+	return result;
+}
\ No newline at end of file
@@ -4,19 +4,33 @@
 
 using namespace kodgen;
 
+thread_local ThreadPool*	ThreadPool::_currentPool		= nullptr;
+thread_local uint32			ThreadPool::_currentWorkerIndex	= 0u;
+
 ThreadPool::ThreadPool(uint32 threadCount, ETerminationMode	terminationMode) noexcept:
 	_destructorCalled{false},
-	_workingWorkers{threadCount},
+	_joiningThreads{0u},
+	_workingWorkers{0u},
+	_sleepingWorkers{0u},
+	_readyTasksCount{0u},
+	_unfinishedTasksCount{0u},
 	terminationMode{terminationMode}
 {
 	assert(threadCount > 0u);
 
 	//Preallocate enough space to avoid reallocations
 	_workers.reserve(threadCount);
+	_workerQueues.reserve(threadCount);
 
+	//All queues must exist before any worker starts since workers steal from each other
 	for (uint32 i = 0u; i < threadCount; i++)
 	{
-		_workers.emplace_back(std::thread(std::bind(&ThreadPool::workerRoutine, this)));
+		_workerQueues.emplace_back(std::make_unique<TaskQueue>());
+	}
+
+	for (uint32 i = 0u; i < threadCount; i++)
+	{
+		_workers.emplace_back(std::thread(&ThreadPool::workerRoutine, this, i));
 	}
 }
 
@@ -24,6 +38,13 @@ ThreadPool::~ThreadPool() noexcept
 {
 	_taskMutex.lock();
 	_destructorCalled = true;
+
+	//Remaining tasks can't be processed if workers are not running
+	if (terminationMode == ETerminationMode::FinishAll)
+	{
+		_isRunning = true;
+	}
+
 	_taskMutex.unlock();
 
 	//Awake threads so that they can perform necessary tests to exit their routine
@@ -37,60 +58,177 @@ ThreadPool::~ThreadPool() noexcept
 			worker.join();
 		}
 	}
+
+	//Discarded tasks still reference their dependents, release them to break reference cycles
+	std::vector<std::shared_ptr<TaskBase>> discardedTasks = _submittedTasks.clear();
+
+	for (std::unique_ptr<TaskQueue>& queue : _workerQueues)
+	{
+		std::vector<std::shared_ptr<TaskBase>> queuedTasks = queue->clear();
+
+		discardedTasks.insert(discardedTasks.end(), std::make_move_iterator(queuedTasks.begin()), std::make_move_iterator(queuedTasks.end()));
+	}
+
+	while (!discardedTasks.empty())
+	{
+		std::shared_ptr<TaskBase> task = std::move(discardedTasks.back());
+		discardedTasks.pop_back();
+
+		std::vector<std::shared_ptr<TaskBase>> dependents = task->complete();
+
+		discardedTasks.insert(discardedTasks.end(), std::make_move_iterator(dependents.begin()), std::make_move_iterator(dependents.end()));
+	}
 }
 
-void ThreadPool::workerRoutine() noexcept
+void ThreadPool::workerRoutine(uint32 workerIndex) noexcept
 {
-	std::unique_lock lock(_taskMutex);
+	_currentPool		= this;
+	_currentWorkerIndex	= workerIndex;
 
 	while (shouldKeepRunning())
 	{
-		if (!_tasks.empty() && _isRunning)
+		//Count the worker as working before grabbing a task so that joinWorkers can't miss it
+		_workingWorkers.fetch_add(1u);
+
+		std::shared_ptr<TaskBase> task = (_isRunning) ? getTask(workerIndex) : nullptr;
+
+		if (task != nullptr)
 		{
-			//We own the mutex before grabbing a task
-			std::shared_ptr<TaskBase> task = getTask();
+			task->execute();
 
-			if (task != nullptr)
-			{
-				//Release the mutex before executing the task to allow other workers to grab tasks during execution
-				lock.unlock();
+			//Dependency results are only read during the execution, so they don't have to live as long as this task
+			task->dependencies.clear();
 
-				task->execute();
+			completeTask(task);
+		}
 
-				lock.lock();
-			}
+		//Threads joining a paused pool wait for all workers to be done with their current task
+		if (_workingWorkers.fetch_sub(1u) == 1u && _joiningThreads.load() != 0u)
+		{
+			notify(_idleCondition, true);
 		}
 
-		if (!_destructorCalled && (_tasks.empty() || !_isRunning))
+		if (task == nullptr)
 		{
-			//A worker is about to sleep, decrement working workers count
-			_workingWorkers.fetch_sub(1u);
+			std::unique_lock lock(_taskMutex);
+
+			//Must be incremented before checking the wait predicate, see pushReadyTask
+			_sleepingWorkers.fetch_add(1u);
 
-			_taskCondition.wait(lock);
+			_taskCondition.wait(lock, [this]() { return (_isRunning && _readyTasksCount.load() != 0u) || !shouldKeepRunning(); });
 
-			//A worker is resuming its activity, increment working workers count
-			_workingWorkers.fetch_add(1u);
+			_sleepingWorkers.fetch_sub(1u);
 		}
 	}
 }
 
-std::shared_ptr<TaskBase> ThreadPool::getTask() noexcept
+std::shared_ptr<TaskBase> ThreadPool::getTask(uint32 workerIndex) noexcept
 {
-	//Iterate over all tasks
-	for (decltype(_tasks)::iterator it = _tasks.begin(); it != _tasks.end(); it++)
+	//Last pushed tasks first: they are often dependents of the task this worker just executed
+	std::shared_ptr<TaskBase> result = _workerQueues[workerIndex]->popBack();
+
+	if (result == nullptr)
 	{
-		//Get the first ready task
-		if ((*it)->isReadyToExecute())
+		result = _submittedTasks.popFront();
+	}
+
+	//Steal the oldest task of another worker
+	for (std::size_t i = 1u; result == nullptr && i < _workerQueues.size(); i++)
+	{
+		result = _workerQueues[(workerIndex + i) % _workerQueues.size()]->popFront();
+	}
+
+	if (result != nullptr)
+	{
+		_readyTasksCount.fetch_sub(1u);
+	}
+
+	return result;
+}
+
+void ThreadPool::registerTask(std::shared_ptr<TaskBase> const& task) noexcept
+{
+	_unfinishedTasksCount.fetch_add(1u);
+
+	//Hold an extra dependency while registering so that the task can't be queued by a completing dependency meanwhile
+	task->_remainingDependenciesCount.store(1u);
+
+	for (std::shared_ptr<TaskBase> const& dependency : task->dependencies)
+	{
+		dependency->addDependent(task);
+	}
+
+	if (task->_remainingDependenciesCount.fetch_sub(1u) == 1u)
+	{
+		pushReadyTask(task);
+	}
+}
+
+void ThreadPool::pushReadyTask(std::shared_ptr<TaskBase> task) noexcept
+{
+	//Incremented before the task is queued so that the counter never underflows when the task is grabbed right away
+	_readyTasksCount.fetch_add(1u);
+
+	if (_currentPool == this)
+	{
+		_workerQueues[_currentWorkerIndex]->pushBack(std::move(task));
+	}
+	else
+	{
+		_submittedTasks.pushBack(std::move(task));
+	}
+
+	//Either a sleeping worker is counted here, or it will see the incremented _readyTasksCount before waiting
+	if (_sleepingWorkers.load() != 0u)
+	{
+		notify(_taskCondition, false);
+	}
+}
+
+void ThreadPool::completeTask(std::shared_ptr<TaskBase> const& task) noexcept
+{
+	for (std::shared_ptr<TaskBase>& dependent : task->complete())
+	{
+		if (dependent->_remainingDependenciesCount.fetch_sub(1u) == 1u)
 		{
-			std::shared_ptr<TaskBase> result = std::move(*it);
+			pushReadyTask(std::move(dependent));
+		}
+	}
 
-			_tasks.erase(it);
+	if (_unfinishedTasksCount.fetch_sub(1u) == 1u)
+	{
+		//Workers waiting for the pool destruction must check whether they can exit
+		if (_destructorCalled)
+		{
+			notify(_taskCondition, true);
+		}
 
-			return result;
+		if (_joiningThreads.load() != 0u)
+		{
+			notify(_idleCondition, true);
 		}
 	}
+}
+
+void ThreadPool::notify(std::condition_variable& condition, bool notifyAll) noexcept
+{
+	{
+		std::lock_guard lock(_taskMutex);
+	}
 
-	return nullptr;
+	if (notifyAll)
+	{
+		condition.notify_all();
+	}
+	else
+	{
+		condition.notify_one();
+	}
+}
+
+bool ThreadPool::isIdle() const noexcept
+{
+	return (_isRunning) ? _unfinishedTasksCount.load() == 0u : _workingWorkers.load() == 0u;
 }
 
 void ThreadPool::joinWorkers() noexcept
@@ -115,19 +253,29 @@ void ThreadPool::joinWorkers() noexcept
 	}
 	else
 	{
-		lock.unlock();
+		//Must be incremented before checking the wait predicate so that completing tasks notify this thread
+		_joiningThreads.fetch_add(1u);
 
-		//Just wait for all workers to be blocked on the _taskCondition
-		while (_workingWorkers.load() != 0u || (_isRunning && !_tasks.empty()))
-		{
-			std::this_thread::yield();
-		}
+		_idleCondition.wait(lock, [this]() { return isIdle(); });
+
+		_joiningThreads.fetch_sub(1u);
+	}
+}
+
+void ThreadPool::waitForTasks(std::vector<std::shared_ptr<TaskBase>> const& tasks) noexcept
+{
+	//A worker waiting for tasks which are not its dependencies could deadlock the pool
+	assert(_currentPool != this);
+
+	for (std::shared_ptr<TaskBase> const& task : tasks)
+	{
+		task->wait();
 	}
 }
 
 bool ThreadPool::shouldKeepRunning() const noexcept
 {
-	return	!_destructorCalled || (terminationMode == ETerminationMode::FinishAll && _tasks.size() != 0u);
+	return	!_destructorCalled || (terminationMode == ETerminationMode::FinishAll && _unfinishedTasksCount.load() != 0u);
 }
 
 void ThreadPool::setIsRunning(bool isRunning) noexcept
@@ -144,5 +292,20 @@ void ThreadPool::setIsRunning(bool isRunning) noexcept
 		{
 			_taskCondition.notify_all();
 		}
+		else
+		{
+			//Joining threads only wait for executing tasks when the pool is paused
+			_idleCondition.notify_all();
+		}
 	}
+}
+
+uint32 ThreadPool::getWorkerCount() const noexcept
+{
+	return static_cast<uint32>(_workers.size());
+}
+
+int32 ThreadPool::getCurrentWorkerIndex() const noexcept
+{
+	return (_currentPool == this) ? static_cast<int32>(_currentWorkerIndex) : -1;
 }
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <chrono>
+
+#include <Kodgen/CodeGen/CodeGenManager.h>
+#include <Kodgen/CodeGen/CodeGenServer.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+#include <Kodgen/Parsing/FileParser.h>
+#include <Kodgen/Parsing/TranslationUnitCache.h>
+#include <Kodgen/Misc/Filesystem.h>
+
+using namespace kodgen;
+
+/**
+*	Check that files modified between requests to a code generation server are reparsed with their new content,
+*	and that the server doesn't keep more translation units than its cache capacity, nor the translation units of removed files.
+*/
+
+/**
+*	Module writing each entity it runs on.
+*/
+class EntityListModule : public MacroCodeGenModule
+{
+	protected:
+		virtual ETraversalBehaviour generateHeaderFileHeaderCodeForEntity(EntityInfo const& entity, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += "//Entity " + entity.getFullName() + "\n";
+
+			return ETraversalBehaviour::Recurse;
+		}
+
+	public:
+		virtual EntityListModule* clone() const noexcept override
+		{
+			return new EntityListModule(*this);
+		}
+};
+
+void writeFile(fs::path const& file, std::string const& content)
+{
+	std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+
+	stream << content;
+}
+
+std::string readFile(fs::path const& file)
+{
+	std::ifstream		stream(file, std::ios::binary);
+	std::ostringstream	content;
+
+	content << stream.rdbuf();
+
+	return content.str();
+}
+
+/**
+*	@brief Write a header containing a class with the given fields, seen as modified since any previous write.
+*
+*	@param file			Path to the header to write.
+*	@param className	Name of the class.
+*	@param fields		Declarations of the fields of the class.
+*/
+void writeHeader(fs::path const& file, std::string const& className, std::string const& fields)
+{
+	writeFile(file, "#pragma once\n\nclass CLASS() " + className + "\n{\n" + fields + "};\n");
+
+	//Make sure the modification is noticed even if the file was written during the same second
+	std::error_code error;
+	fs::last_write_time(file, fs::file_time_type::clock::now() + std::chrono::seconds(2), error);
+}
+
+/**
+*	@brief Send a generation request to the server, waiting for the server to listen.
+*
+*	@param socketPath	Path to the socket file the server listens to.
+*	@param out_response	Response of the server.
+*
+*	@return true if the generation completed, else false.
+*/
+bool requestGeneration(fs::path const& socketPath, std::string& out_response)
+{
+	for (int i = 0; i < 100 && !CodeGenServer::sendRequest(socketPath, "generate", out_response); i++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+
+	if (out_response.rfind("completed", 0) != 0)
+	{
+		std::cerr << "Generation failed: " << out_response << std::endl;
+
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	fs::path directory	= fs::temp_directory_path() / "KodgenCodeGenServer";
+	fs::path socketPath	= directory / "Server.sock";
+
+	fs::remove_all(directory);
+	fs::create_directories(directory / "Input");
+
+	writeHeader(directory / "Input" / "A.h", "A", "\tFIELD() int first;\n");
+	writeHeader(directory / "Input" / "B.h", "B", "\tFIELD() int first;\n");
+	writeHeader(directory / "Input" / "C.h", "C", "\tFIELD() int first;\n");
+
+	FileParser fileParser;
+
+	if (!fileParser.getSettings().setCompilerExeName("clang++") && !fileParser.getSettings().setCompilerExeName("g++"))
+	{
+		std::cerr << "No supported compiler found." << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	fileParser.translationUnitCache = std::make_shared<TranslationUnitCache>(2u);
+
+	MacroCodeGenUnitSettings codeGenUnitSettings;
+	codeGenUnitSettings.setOutputDirectory(directory / "Generated");
+
+	EntityListModule entityListModule;
+
+	MacroCodeGenUnit codeGenUnit;
+	codeGenUnit.setSettings(codeGenUnitSettings);
+	codeGenUnit.addModule(entityListModule);
+
+	CodeGenManager codeGenManager(2u);
+	codeGenManager.settings.addToProcessDirectory(directory / "Input");
+	codeGenManager.settings.addSupportedFileExtension(".h");
+
+	CodeGenServer	codeGenServer(codeGenManager);
+	bool			isServerStopped = false;
+	std::thread		serverThread([&]()
+	{
+		isServerStopped = codeGenServer.serve(fileParser, codeGenUnit, socketPath);
+	});
+
+	bool		result = true;
+	std::string	response;
+
+	//Initial generation of all files
+	if (!requestGeneration(socketPath, response))
+	{
+		result = false;
+	}
+	else if (readFile(directory / "Generated" / "A.h.h").find("//Entity A::first") == std::string::npos)
+	{
+		std::cerr << "A.h entities were not generated." << std::endl;
+
+		result = false;
+	}
+	else if (fileParser.translationUnitCache->getCachedTranslationUnitsCount() != 2u)
+	{
+		std::cerr << "The translation unit cache doesn't respect its capacity." << std::endl;
+
+		result = false;
+	}
+
+	//The reparsed translation unit must give the new entities
+	if (result)
+	{
+		writeHeader(directory / "Input" / "A.h", "A", "\tFIELD() int first;\n\tFIELD() int second;\n");
+
+		if (!requestGeneration(socketPath, response))
+		{
+			result = false;
+		}
+		else if (response.find("parsed " + (directory / "Input" / "A.h").string()) == std::string::npos)
+		{
+			std::cerr << "Modified file A.h was not reparsed: " << response << std::endl;
+
+			result = false;
+		}
+		else if (readFile(directory / "Generated" / "A.h.h").find("//Entity A::second") == std::string::npos)
+		{
+			std::cerr << "The entities added to A.h were not generated." << std::endl;
+
+			result = false;
+		}
+	}
+
+	//Translation units of removed files must be disposed
+	if (result)
+	{
+		fs::remove(directory / "Input" / "B.h");
+		fs::remove(directory / "Input" / "C.h");
+
+		if (!requestGeneration(socketPath, response))
+		{
+			result = false;
+		}
+		else if (fileParser.translationUnitCache->getCachedTranslationUnitsCount() != 1u)
+		{
+			std::cerr << "Translation units of removed files were kept." << std::endl;
+
+			result = false;
+		}
+	}
+
+	if (!CodeGenServer::sendRequest(socketPath, "stop", response) || response != "stopped\n")
+	{
+		std::cerr << "The server didn't stop." << std::endl;
+
+		result = false;
+	}
+
+	serverThread.join();
+
+	if (!isServerStopped)
+	{
+		std::cerr << "The server didn't stop after the stop request." << std::endl;
+
+		result = false;
+	}
+
+	fs::remove_all(directory);
+
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
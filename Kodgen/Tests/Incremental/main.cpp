@@ -0,0 +1,203 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <algorithm>
+
+#include <Kodgen/CodeGen/CodeGenManager.h>
+#include <Kodgen/CodeGen/IncludeDependencyGraph.h>
+#include <Kodgen/CodeGen/GenerationManifest.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/Parsing/FileParser.h>
+#include <Kodgen/Misc/Filesystem.h>
+
+using namespace kodgen;
+
+/**
+*	Check that running a generation again only regenerates the files which changed (or which included files changed),
+*	and reports all other files as up-to-date.
+*/
+
+void writeFile(fs::path const& file, std::string const& content)
+{
+	std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+
+	stream << content;
+}
+
+/**
+*	@brief Generate code for all headers of a directory, as a new generator process would do.
+*
+*	@param directory Directory containing the headers to process.
+*
+*	@return The generation result.
+*/
+CodeGenResult generate(fs::path const& directory)
+{
+	FileParser fileParser;
+
+	if (!fileParser.getSettings().setCompilerExeName("clang++") && !fileParser.getSettings().setCompilerExeName("g++"))
+	{
+		std::cerr << "No supported compiler found." << std::endl;
+
+		return CodeGenResult();
+	}
+
+	MacroCodeGenUnitSettings codeGenUnitSettings;
+	codeGenUnitSettings.setOutputDirectory(directory / "Generated");
+
+	MacroCodeGenUnit codeGenUnit;
+	codeGenUnit.setSettings(codeGenUnitSettings);
+
+	CodeGenManager codeGenManager(2u);
+	codeGenManager.settings.addToProcessDirectory(directory);
+	codeGenManager.settings.addIgnoredDirectory(directory / "Generated");
+	codeGenManager.settings.addIgnoredDirectory(directory / "Shared");
+	codeGenManager.settings.addSupportedFileExtension(".h");
+	codeGenManager.settings.shouldUseGenerationManifest = true;
+	codeGenManager.settings.shouldTrackIncludeDependencies = true;
+	codeGenManager.settings.shouldSkipFilesWithoutAnnotations = true;
+	codeGenManager.settings.setStateDirectory(directory / "State");
+
+	return codeGenManager.run(fileParser, codeGenUnit);
+}
+
+/**
+*	@brief Check the files reported as parsed by a generation.
+*
+*	@param step				Name of the checked step, used in error messages.
+*	@param genResult		Result of the generation.
+*	@param expectedParsed	Names of the files which must have been parsed.
+*	@param fileCount		Total number of processed files.
+*	@param expectedSkipped	Names of the files which must have been regenerated without being parsed. All other files must be up-to-date.
+*
+*	@return true if the generation reported the expected files, else false.
+*/
+bool checkResult(std::string const& step, CodeGenResult const& genResult, std::vector<std::string> expectedParsed, size_t fileCount, std::vector<std::string> expectedSkipped = {})
+{
+	std::vector<std::string> parsed;
+	std::vector<std::string> skipped;
+
+	for (fs::path const& file : genResult.parsedFiles)
+	{
+		parsed.push_back(file.filename().string());
+	}
+
+	for (fs::path const& file : genResult.skippedFiles)
+	{
+		skipped.push_back(file.filename().string());
+	}
+
+	std::sort(parsed.begin(), parsed.end());
+	std::sort(expectedParsed.begin(), expectedParsed.end());
+	std::sort(skipped.begin(), skipped.end());
+	std::sort(expectedSkipped.begin(), expectedSkipped.end());
+
+	size_t expectedUpToDateCount = fileCount - expectedParsed.size() - expectedSkipped.size();
+
+	if (!genResult.completed)
+	{
+		std::cerr << step << ": code generation failed." << std::endl;
+
+		return false;
+	}
+	else if (parsed != expectedParsed || skipped != expectedSkipped || genResult.upToDateFiles.size() != expectedUpToDateCount)
+	{
+		std::cerr << step << ": " << parsed.size() << " files parsed, " << skipped.size() << " skipped and " << genResult.upToDateFiles.size() << " up-to-date, expected "
+				  << expectedParsed.size() << " parsed, " << expectedSkipped.size() << " skipped and " << expectedUpToDateCount << " up-to-date." << std::endl;
+
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	fs::path directory = fs::temp_directory_path() / "KodgenIncremental";
+
+	fs::remove_all(directory);
+	fs::create_directories(directory / "Shared");
+
+	writeFile(directory / "Shared" / "Common.h", "#pragma once\n\nstruct Common { int value; };\n");
+	writeFile(directory / "File0.h", "#pragma once\n\n#include \"Shared/Common.h\"\n\nclass CLASS() File0Class { FIELD() Common common; };\n");
+	writeFile(directory / "File1.h", "#pragma once\n\nclass CLASS() File1Class { FIELD() int field; };\n");
+	writeFile(directory / "File2.h", "#pragma once\n\nclass CLASS() File2Class { FIELD() int field; };\n");
+
+	bool result = checkResult("First run", generate(directory), { "File0.h", "File1.h", "File2.h" }, 3u) &&
+				  checkResult("Unchanged run", generate(directory), {}, 3u);
+
+	//Files kept between runs must not be written next to the generated files when a state directory is set
+	if (result && fs::exists(directory / "Generated" / GenerationManifest::filename))
+	{
+		std::cerr << "The generation manifest was saved in the output directory." << std::endl;
+
+		result = false;
+	}
+
+	//Changing the last write time of a file without changing its content must not regenerate it
+	if (result)
+	{
+		fs::last_write_time(directory / "File1.h", fs::last_write_time(directory / "File1.h") + std::chrono::hours(1));
+
+		result = checkResult("Touched file", generate(directory), {}, 3u);
+	}
+
+	if (result)
+	{
+		writeFile(directory / "File2.h", "#pragma once\n\nclass CLASS() File2Class { FIELD() int field; FIELD() int otherField; };\n");
+
+		result = checkResult("Modified file", generate(directory), { "File2.h" }, 3u);
+	}
+
+	//File0.h must be regenerated when a header it includes changed
+	if (result)
+	{
+		writeFile(directory / "Shared" / "Common.h", "#pragma once\n\nstruct Common { int value; int otherValue; };\n");
+
+		result = checkResult("Modified include", generate(directory), { "File0.h" }, 3u) &&
+				 checkResult("Unchanged run after modifications", generate(directory), {}, 3u);
+	}
+
+	if (result)
+	{
+		fs::last_write_time(directory / "Shared" / "Common.h", fs::last_write_time(directory / "Shared" / "Common.h") + std::chrono::hours(1));
+
+		result = checkResult("Touched include", generate(directory), {}, 3u);
+	}
+
+	//Files can't be known up-to-date anymore when their include dependencies are lost
+	if (result)
+	{
+		for (fs::directory_entry const& entry : fs::recursive_directory_iterator(directory / "State"))
+		{
+			if (entry.path().filename() == IncludeDependencyGraph::filename)
+			{
+				writeFile(entry.path(), "File0.h\n\tnot a dependency\n");
+			}
+		}
+
+		result = checkResult("Corrupt include dependencies", generate(directory), { "File0.h", "File1.h", "File2.h" }, 3u);
+	}
+
+	//Files without annotations are not parsed, but still get their (empty) generated files
+	if (result)
+	{
+		writeFile(directory / "File3.h", "#pragma once\n\nstruct Plain { int value; };\n");
+
+		result = checkResult("File without annotations", generate(directory), {}, 4u, { "File3.h" });
+
+		if (result && (!fs::exists(directory / "Generated" / "File3.h.h") || !fs::exists(directory / "Generated" / "File3.src.h")))
+		{
+			std::cerr << "No code was generated for the file without annotations." << std::endl;
+
+			result = false;
+		}
+
+		result = result && checkResult("Unchanged run with a file without annotations", generate(directory), {}, 4u);
+	}
+
+	fs::remove_all(directory);
+
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
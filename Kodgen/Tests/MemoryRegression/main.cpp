@@ -0,0 +1,167 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include <Kodgen/CodeGen/CodeGenManager.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/Parsing/FileParser.h>
+#include <Kodgen/Misc/Filesystem.h>
+
+using namespace kodgen;
+
+/**
+*	Check that the peak memory of a code generation doesn't grow with the number of processed files,
+*	since parsing results and tasks of a file are released once its code is generated.
+*	Usage: MemoryRegression [smallFileCount] [largeFileCount]
+*/
+
+/**
+*	@brief Read a memory counter of this process from /proc/self/status.
+*
+*	@param counterName Name of the counter, VmRSS or VmHWM.
+*
+*	@return The counter value in kB, or 0 if it can't be read.
+*/
+uint64 readMemoryCounter(std::string const& counterName)
+{
+	std::ifstream	status("/proc/self/status");
+	std::string		line;
+
+	while (std::getline(status, line))
+	{
+		if (line.compare(0u, counterName.size() + 1u, counterName + ":") == 0)
+		{
+			return std::stoull(line.substr(counterName.size() + 1u));
+		}
+	}
+
+	return 0u;
+}
+
+/**
+*	@brief Reset the peak resident set size of this process to its current resident set size.
+*
+*	@return true if the peak has been reset, else false.
+*/
+bool resetPeakMemory()
+{
+	std::ofstream clearRefs("/proc/self/clear_refs");
+
+	clearRefs << "5";
+
+	return clearRefs.good();
+}
+
+void writeHeaders(fs::path const& directory, uint32 fileCount)
+{
+	fs::create_directories(directory);
+
+	for (uint32 fileIndex = 0u; fileIndex < fileCount; fileIndex++)
+	{
+		std::ofstream file(directory / ("File" + std::to_string(fileIndex) + ".h"));
+
+		file << "#pragma once\n\n";
+
+		for (uint32 classIndex = 0u; classIndex < 64u; classIndex++)
+		{
+			file << "class CLASS() File" << fileIndex << "Class" << classIndex << "\n{\n";
+
+			for (uint32 fieldIndex = 0u; fieldIndex < 32u; fieldIndex++)
+			{
+				file << "\tFIELD() int field" << fieldIndex << ";\n";
+			}
+
+			file << "};\n\n";
+		}
+	}
+}
+
+/**
+*	@brief Generate code for all headers of a directory.
+*
+*	@param directory Directory containing the headers to process.
+*
+*	@return The growth of the peak resident set size during the generation in kB, or -1 if the generation failed.
+*/
+int64 generate(fs::path const& directory)
+{
+	FileParser fileParser;
+
+	if (!fileParser.getSettings().setCompilerExeName("clang++") && !fileParser.getSettings().setCompilerExeName("g++"))
+	{
+		std::cerr << "No supported compiler found." << std::endl;
+
+		return -1;
+	}
+
+	MacroCodeGenUnitSettings codeGenUnitSettings;
+	codeGenUnitSettings.setOutputDirectory(directory / "Generated");
+
+	MacroCodeGenUnit codeGenUnit;
+	codeGenUnit.setSettings(codeGenUnitSettings);
+
+	CodeGenManager codeGenManager(2u);
+	codeGenManager.settings.addToProcessDirectory(directory);
+	codeGenManager.settings.addIgnoredDirectory(directory / "Generated");
+	codeGenManager.settings.addSupportedFileExtension(".h");
+
+	//Parsing results kept for next iterations must still be released once a file completed its last iteration
+	codeGenManager.settings.shouldReuseParsingResults = true;
+
+	int64 baseline = static_cast<int64>(readMemoryCounter("VmRSS"));
+
+	resetPeakMemory();
+
+	CodeGenResult genResult = codeGenManager.run(fileParser, codeGenUnit, true);
+
+	int64 peak = static_cast<int64>(readMemoryCounter("VmHWM"));
+
+	return genResult.completed ? peak - baseline : -1;
+}
+
+int main(int argc, char** argv)
+{
+	uint32		smallFileCount	= (argc > 1) ? static_cast<uint32>(std::stoul(argv[1])) : 16u;
+	uint32		largeFileCount	= (argc > 2) ? static_cast<uint32>(std::stoul(argv[2])) : 128u;
+	fs::path	directory		= fs::temp_directory_path() / "KodgenMemoryRegression";
+
+	if (readMemoryCounter("VmHWM") == 0u || !resetPeakMemory())
+	{
+		std::cout << "Peak memory can't be measured on this platform, skip." << std::endl;
+
+		return EXIT_SUCCESS;
+	}
+
+	fs::remove_all(directory);
+	writeHeaders(directory / "Small", smallFileCount);
+	writeHeaders(directory / "Large", largeFileCount);
+
+	//Warm up so that memory allocated once per process is not measured
+	generate(directory / "Small");
+
+	int64 smallPeak	= generate(directory / "Small");
+	int64 largePeak	= generate(directory / "Large");
+
+	fs::remove_all(directory);
+
+	std::cout << smallFileCount << " files: peak memory +" << smallPeak << "kB" << std::endl;
+	std::cout << largeFileCount << " files: peak memory +" << largePeak << "kB" << std::endl;
+
+	if (smallPeak < 0 || largePeak < 0)
+	{
+		std::cerr << "Code generation failed." << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	//Peak memory must stay flat, with some slack for allocator fragmentation
+	if (largePeak > smallPeak * 2 + 16 * 1024)
+	{
+		std::cerr << "Peak memory grows with the number of processed files." << std::endl;
+
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
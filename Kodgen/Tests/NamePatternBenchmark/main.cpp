@@ -0,0 +1,164 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+
+using namespace kodgen;
+
+/**
+*	Measure the cost of expanding the generated file name and macro patterns once per class and per file.
+*	Usage: NamePatternBenchmark [expansionCount]
+*/
+
+/**
+*	Settings expanding patterns by searching and replacing the tags on each call, as patterns were expanded before being compiled.
+*/
+class TagReplacingSettings : public MacroCodeGenUnitSettings
+{
+	public:
+		std::string replaceClassFooterMacroTags(std::string const& className, std::string classFullName) const noexcept
+		{
+			std::string classFooterMacroName = getClassFooterMacroPattern();
+
+			replaceTags(classFullName, "::", "_");
+
+			replaceTags(classFooterMacroName, "##CLASSNAME##", className);
+			replaceTags(classFooterMacroName, "##CLASSFULLNAME##", classFullName);
+
+			sanitizeMacroName(classFooterMacroName);
+
+			return classFooterMacroName;
+		}
+
+		std::string replaceHeaderFileFooterMacroTags(fs::path const& targetFile) const noexcept
+		{
+			std::string headerFileFooterMacroName = getHeaderFileFooterMacroPattern();
+
+			replaceTags(headerFileFooterMacroName, "##FILENAME##", targetFile.filename().stem().string());
+
+			sanitizeMacroName(headerFileFooterMacroName);
+
+			return headerFileFooterMacroName;
+		}
+
+		fs::path replaceGeneratedHeaderFileNameTags(fs::path const& targetFile) const noexcept
+		{
+			std::string filename = getGeneratedHeaderFileNamePattern();
+
+			replaceTags(filename, "##FILENAME##", targetFile.filename().stem().string());
+
+			return filename;
+		}
+};
+
+template <typename Expand>
+double runBenchmark(char const* name, size_t expansionCount, Expand&& expand)
+{
+	size_t totalSize = 0u;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0u; i < expansionCount; i++)
+	{
+		totalSize += expand(i);
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << name << ": " << expansionCount << " expansions in " << elapsed.count() * 1000.0 << "ms ("
+		<< elapsed.count() * 1000000000.0 / expansionCount << "ns/expansion, " << totalSize << " bytes)" << std::endl;
+
+	return elapsed.count();
+}
+
+int main(int argc, char** argv)
+{
+	size_t	expansionCount	= (argc > 1) ? std::stoul(argv[1]) : 1000000u;
+	bool	success			= true;
+
+	TagReplacingSettings settings;
+	settings.setClassFooterMacroPattern("##CLASSFULLNAME##_##CLASSNAME##_GENERATED");
+	settings.setHeaderFileFooterMacroPattern("File_##FILENAME##_GENERATED");
+
+	//Names of the classes and files of a large project
+	std::vector<std::string>	classNames;
+	std::vector<std::string>	classFullNames;
+	std::vector<fs::path>		files;
+
+	for (size_t i = 0u; i < 64u; i++)
+	{
+		classNames.push_back("SomeReflectedClass" + std::to_string(i));
+		classFullNames.push_back("project::module" + std::to_string(i % 8u) + "::" + classNames.back());
+		files.push_back(fs::path("Source") / ("Module" + std::to_string(i % 8u)) / ("SomeReflectedClass" + std::to_string(i) + ".h"));
+	}
+
+	//Compiled patterns must expand exactly like replaced tags
+	std::string buffer;
+
+	for (size_t i = 0u; i < classNames.size(); i++)
+	{
+		buffer.clear();
+		settings.expandClassFooterMacro(classNames[i], classFullNames[i], buffer);
+
+		if (buffer != settings.replaceClassFooterMacroTags(classNames[i], classFullNames[i]))
+		{
+			std::cerr << "Class footer macro of " << classFullNames[i] << " is " << buffer << ", expected " << settings.replaceClassFooterMacroTags(classNames[i], classFullNames[i]) << std::endl;
+			success = false;
+		}
+
+		buffer.clear();
+		settings.expandHeaderFileFooterMacro(files[i], buffer);
+
+		if (buffer != settings.replaceHeaderFileFooterMacroTags(files[i]) ||
+			settings.getGeneratedHeaderFileName(files[i]) != settings.replaceGeneratedHeaderFileNameTags(files[i]))
+		{
+			std::cerr << "Generated names of " << files[i] << " differ from the replaced tags." << std::endl;
+			success = false;
+		}
+	}
+
+	double replacedTagsDuration = runBenchmark("Class footer macro, replaced tags", expansionCount, [&](size_t i)
+												{
+													return settings.replaceClassFooterMacroTags(classNames[i % classNames.size()], classFullNames[i % classNames.size()]).size();
+												});
+
+	double compiledPatternDuration = runBenchmark("Class footer macro, compiled pattern", expansionCount, [&](size_t i)
+												{
+													buffer.clear();
+													settings.expandClassFooterMacro(classNames[i % classNames.size()], classFullNames[i % classNames.size()], buffer);
+
+													return buffer.size();
+												});
+
+	runBenchmark("Header file footer macro, replaced tags", expansionCount, [&](size_t i)
+				{
+					return settings.replaceHeaderFileFooterMacroTags(files[i % files.size()]).size();
+				});
+
+	runBenchmark("Header file footer macro, compiled pattern", expansionCount, [&](size_t i)
+				{
+					buffer.clear();
+					settings.expandHeaderFileFooterMacro(files[i % files.size()], buffer);
+
+					return buffer.size();
+				});
+
+	runBenchmark("Generated header file name, replaced tags", expansionCount, [&](size_t i)
+				{
+					return settings.replaceGeneratedHeaderFileNameTags(files[i % files.size()]).native().size();
+				});
+
+	runBenchmark("Generated header file name, compiled pattern", expansionCount, [&](size_t i)
+				{
+					buffer.clear();
+					settings.expandGeneratedHeaderFileName(files[i % files.size()], buffer);
+
+					return buffer.size();
+				});
+
+	std::cout << "Class footer macro speedup: " << replacedTagsDuration / compiledPatternDuration << "x" << std::endl;
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
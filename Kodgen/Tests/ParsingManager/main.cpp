@@ -0,0 +1,127 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+
+#include <Kodgen/Parsing/ParsingManager.h>
+#include <Kodgen/Parsing/FileParser.h>
+#include <Kodgen/Misc/Filesystem.h>
+
+using namespace kodgen;
+
+/**
+*	Check that the ParsingManager provides the parsing result of each selected file exactly once,
+*	and reports files which could not be parsed.
+*/
+
+void writeFile(fs::path const& file, std::string const& content)
+{
+	std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+
+	stream << content;
+}
+
+/**
+*	@brief Parse all headers of a directory, and collect a "File:Class" entry for each class of each parsed file.
+*
+*	@param directory		Directory containing the headers to parse.
+*	@param out_entries		Collected entries, sorted.
+*	@param out_isSuccessful	Value returned by ParsingManager::run.
+*
+*	@return false if no compiler could be found, else true.
+*/
+bool parse(fs::path const& directory, std::vector<std::string>& out_entries, bool& out_isSuccessful)
+{
+	FileParser fileParser;
+
+	if (!fileParser.getSettings().setCompilerExeName("clang++") && !fileParser.getSettings().setCompilerExeName("g++"))
+	{
+		std::cerr << "No supported compiler found." << std::endl;
+
+		return false;
+	}
+
+	ParsingManager parsingManager(2u);
+	parsingManager.settings.addToProcessDirectory(directory);
+	parsingManager.settings.addSupportedFileExtension(".h");
+
+	//Results are provided by several threads at once
+	std::mutex entriesMutex;
+
+	out_isSuccessful = parsingManager.run(fileParser, [&](FileParsingResult& parsingResult)
+	{
+		std::lock_guard<std::mutex> lock(entriesMutex);
+
+		std::string fileName = parsingResult.parsedFile.filename().string();
+
+		if (parsingResult.classes.empty())
+		{
+			out_entries.push_back(fileName + ":");
+		}
+
+		for (StructClassInfo const& classInfo : parsingResult.classes)
+		{
+			out_entries.push_back(fileName + ":" + classInfo.name);
+		}
+	});
+
+	std::sort(out_entries.begin(), out_entries.end());
+
+	return true;
+}
+
+int main()
+{
+	constexpr size_t const	fileCount	= 8u;
+	fs::path				directory	= fs::temp_directory_path() / "KodgenParsingManager";
+	std::vector<std::string>	expectedEntries;
+
+	fs::remove_all(directory);
+	fs::create_directories(directory);
+
+	for (size_t i = 0u; i < fileCount; i++)
+	{
+		std::string name = "File" + std::to_string(i);
+
+		writeFile(directory / (name + ".h"), "#pragma once\n\nclass CLASS() " + name + "Class { FIELD() int field; };\n");
+		expectedEntries.push_back(name + ".h:" + name + "Class");
+	}
+
+	std::sort(expectedEntries.begin(), expectedEntries.end());
+
+	std::vector<std::string>	entries;
+	bool						isSuccessful	= false;
+	bool						result			= parse(directory, entries, isSuccessful);
+
+	if (result && (!isSuccessful || entries != expectedEntries))
+	{
+		std::cerr << "Valid files: " << entries.size() << " results received, expected " << expectedEntries.size()
+				  << (isSuccessful ? "." : ", and parsing failed.") << std::endl;
+
+		result = false;
+	}
+
+	//A file which can't be parsed must still be provided to the callback, and fail the run
+	if (result)
+	{
+		writeFile(directory / "Invalid.h", "#pragma once\n\nclass CLASS(FirstProperty(1) SecondProperty) InvalidClass { FIELD() int field; };\n");
+		expectedEntries.insert(std::upper_bound(expectedEntries.begin(), expectedEntries.end(), "Invalid.h:"), "Invalid.h:");
+
+		entries.clear();
+		result = parse(directory, entries, isSuccessful);
+
+		if (result && (isSuccessful || entries.size() != expectedEntries.size()))
+		{
+			std::cerr << "Invalid file: " << entries.size() << " results received, expected " << expectedEntries.size()
+					  << (isSuccessful ? ", and parsing succeeded." : ".") << std::endl;
+
+			result = false;
+		}
+	}
+
+	fs::remove_all(directory);
+
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,321 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <Kodgen/CodeGen/CodeGenManager.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+#include <Kodgen/CodeGen/Macro/MacroPropertyCodeGen.h>
+#include <Kodgen/CodeGen/Macro/StaticMacroCodeGenUnit.h>
+#include <Kodgen/Parsing/FileParser.h>
+#include <Kodgen/Misc/Filesystem.h>
+
+using namespace kodgen;
+
+/**
+*	Check that property code generators dispatched through the property index generate exactly the same code
+*	as property code generators traversing all entities, and that overrides of shouldGenerateCodeForEntity are honored.
+*/
+
+/**
+*	Property code generator writing the entity and property it runs on.
+*/
+class TracePropertyCodeGen : public MacroPropertyCodeGen
+{
+	private:
+		static std::string trace(EntityInfo const& entity, Property const& property, uint8 propertyIndex, char const* location) noexcept
+		{
+			return std::string("/* ") + location + " " + entity.getFullName() + " " + property.name + "#" + std::to_string(propertyIndex) + " */";
+		}
+
+	protected:
+		virtual bool generateHeaderFileHeaderCodeForEntity(EntityInfo const& entity, Property const& property, uint8 propertyIndex, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += trace(entity, property, propertyIndex, "HeaderFileHeader") + "\n";
+
+			return true;
+		}
+
+		virtual bool generateSourceFileHeaderCodeForEntity(EntityInfo const& entity, Property const& property, uint8 propertyIndex, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += trace(entity, property, propertyIndex, "SourceFileHeader") + "\n";
+
+			return true;
+		}
+
+	public:
+		TracePropertyCodeGen(std::string const& propertyName, EEntityType eligibleEntityMask) noexcept:
+			MacroPropertyCodeGen(propertyName, eligibleEntityMask)
+		{}
+};
+
+/**
+*	Same generator overriding shouldGenerateCodeForEntity without changing its behaviour, so it traverses all entities.
+*/
+class TraversedTracePropertyCodeGen : public TracePropertyCodeGen
+{
+	public:
+		using TracePropertyCodeGen::TracePropertyCodeGen;
+
+		virtual bool shouldGenerateCodeForEntity(EntityInfo const& entity, Property const& property, uint8 propertyIndex) const noexcept override
+		{
+			return TracePropertyCodeGen::shouldGenerateCodeForEntity(entity, property, propertyIndex);
+		}
+};
+
+/**
+*	Generator also running on the properties named after it with an "Alias" suffix.
+*/
+class AliasTracePropertyCodeGen : public TracePropertyCodeGen
+{
+	public:
+		using TracePropertyCodeGen::TracePropertyCodeGen;
+
+		virtual bool shouldGenerateCodeForEntity(EntityInfo const& entity, Property const& property, uint8 propertyIndex) const noexcept override
+		{
+			return TracePropertyCodeGen::shouldGenerateCodeForEntity(entity, property, propertyIndex) ||
+				   (property.name == getPropertyName() + "Alias" && (entity.entityType && getEligibleEntityMask()));
+		}
+};
+
+/**
+*	Module registering a generator running on Trace properties of most entities, and a generator running on Trace properties of fields only.
+*/
+template <typename PropertyCodeGenType>
+class TraceModule : public MacroCodeGenModule
+{
+	private:
+		PropertyCodeGenType _tracePropertyCodeGen{ "Trace", EEntityType::Namespace | EEntityType::Class | EEntityType::Struct | EEntityType::Field |
+														   EEntityType::Method | EEntityType::Enum | EEntityType::EnumValue | EEntityType::Function };
+		PropertyCodeGenType	_fieldTracePropertyCodeGen{ "Trace", EEntityType::Field };
+
+	public:
+		TraceModule() noexcept
+		{
+			addPropertyCodeGen(_tracePropertyCodeGen);
+			addPropertyCodeGen(_fieldTracePropertyCodeGen);
+		}
+
+		TraceModule(TraceModule const&) noexcept:
+			TraceModule() //Register the property code generators of the copy
+		{
+		}
+
+		virtual TraceModule* clone() const noexcept override
+		{
+			return new TraceModule(*this);
+		}
+};
+
+/**
+*	Module skipping the entities following the Stop entities, with a property code generator running on Break properties.
+*/
+class BreakModule : public MacroCodeGenModule
+{
+	private:
+		TracePropertyCodeGen _breakPropertyCodeGen{ "Break", EEntityType::Class | EEntityType::Field };
+
+	protected:
+		virtual ETraversalBehaviour generateHeaderFileHeaderCodeForEntity(EntityInfo const& entity, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += "//Break " + entity.getFullName() + "\n";
+
+			return (entity.name == "Stop") ? ETraversalBehaviour::Break : ETraversalBehaviour::Recurse;
+		}
+
+	public:
+		BreakModule() noexcept
+		{
+			addPropertyCodeGen(_breakPropertyCodeGen);
+		}
+
+		BreakModule(BreakModule const&) noexcept:
+			BreakModule() //Register the property code generator of the copy
+		{
+		}
+
+		virtual BreakModule* clone() const noexcept override
+		{
+			return new BreakModule(*this);
+		}
+};
+
+void writeFile(fs::path const& file, std::string const& content)
+{
+	std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+
+	stream << content;
+}
+
+std::string readFile(fs::path const& file)
+{
+	std::ifstream		stream(file, std::ios::binary);
+	std::ostringstream	content;
+
+	content << stream.rdbuf();
+
+	return content.str();
+}
+
+/**
+*	@brief Generate code for all headers of a directory.
+*
+*	@param directory		Directory containing the headers to process.
+*	@param outputDirectory	Directory the generated files are written to.
+*	@param codeGenUnit		Generation unit used to generate code.
+*
+*	@return true if the generation completed successfully, else false.
+*/
+template <typename CodeGenUnitType>
+bool generate(fs::path const& directory, fs::path const& outputDirectory, CodeGenUnitType& codeGenUnit)
+{
+	FileParser fileParser;
+
+	if (!fileParser.getSettings().setCompilerExeName("clang++") && !fileParser.getSettings().setCompilerExeName("g++"))
+	{
+		std::cerr << "No supported compiler found." << std::endl;
+
+		return false;
+	}
+
+	MacroCodeGenUnitSettings codeGenUnitSettings;
+	codeGenUnitSettings.setOutputDirectory(outputDirectory);
+
+	codeGenUnit.setSettings(codeGenUnitSettings);
+
+	CodeGenManager codeGenManager(2u);
+	codeGenManager.settings.addToProcessDirectory(directory);
+	codeGenManager.settings.addSupportedFileExtension(".h");
+
+	return codeGenManager.run(fileParser, codeGenUnit, true).completed;
+}
+
+/**
+*	@brief Compare all files generated in a directory with the files generated in a reference directory.
+*
+*	@param referenceDirectory	Directory containing the reference files.
+*	@param directory			Directory containing the compared files.
+*
+*	@return true if both directories contain the same files with the same content, else false.
+*/
+bool compareDirectories(fs::path const& referenceDirectory, fs::path const& directory)
+{
+	size_t comparedFileCount = 0u;
+
+	for (fs::directory_entry const& entry : fs::directory_iterator(referenceDirectory))
+	{
+		fs::path file = directory / entry.path().filename();
+
+		if (readFile(entry.path()) != readFile(file))
+		{
+			std::cerr << file.string() << " differs from " << entry.path().string() << "." << std::endl;
+
+			return false;
+		}
+
+		comparedFileCount++;
+	}
+
+	if (comparedFileCount != static_cast<size_t>(std::distance(fs::directory_iterator(directory), fs::directory_iterator())))
+	{
+		std::cerr << directory.string() << " and " << referenceDirectory.string() << " don't contain the same files." << std::endl;
+
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	fs::path directory = fs::temp_directory_path() / "KodgenPropertyDispatch";
+
+	fs::remove_all(directory);
+	fs::create_directories(directory / "Input");
+
+	writeFile(directory / "Input" / "Entities.h",
+			  "#pragma once\n\n"
+			  "namespace NAMESPACE(Trace) Outer\n{\n"
+			  "\tnamespace NAMESPACE() Inner\n\t{\n"
+			  "\t\tclass CLASS(Trace, Break) Base\n\t\t{\n"
+			  "\t\t\tFIELD(Trace, Break) int field;\n"
+			  "\t\t\tMETHOD(Trace) void method();\n"
+			  "\t\t\tstruct STRUCT(Trace) Nested { FIELD(Trace) int nestedField; };\n"
+			  "\t\t};\n\n"
+			  "\t\tclass CLASS(Break) Stop { FIELD(Trace) int stopField; };\n\n"
+			  "\t\tclass CLASS(Trace) AfterStop { FIELD(TraceAlias, Trace) int aliasField; };\n"
+			  "\t}\n\n"
+			  "\tenum class ENUM(Trace) Color { Red ENUMVALUE(Trace), Green };\n"
+			  "}\n\n"
+			  "struct STRUCT(Trace) Plain { FIELD(Trace, Trace) int twice; };\n\n"
+			  "FUNCTION(Trace) void freeFunction();\n");
+
+	TraceModule<TracePropertyCodeGen>			indexedTraceModule;
+	TraceModule<TraversedTracePropertyCodeGen>	traversedTraceModule;
+	TraceModule<AliasTracePropertyCodeGen>		aliasTraceModule;
+	BreakModule									breakModule;
+
+	bool result = true;
+
+	//Make sure both dispatch paths are actually compared
+	if (!indexedTraceModule.getPropertyCodeGenerators()[0]->isDispatchedByPropertyName() ||
+		traversedTraceModule.getPropertyCodeGenerators()[0]->isDispatchedByPropertyName())
+	{
+		std::cerr << "Overrides of shouldGenerateCodeForEntity are not detected." << std::endl;
+
+		result = false;
+	}
+
+	MacroCodeGenUnit indexedCodeGenUnit;
+	indexedCodeGenUnit.addModule(indexedTraceModule);
+	indexedCodeGenUnit.addModule(breakModule);
+
+	MacroCodeGenUnit traversedCodeGenUnit;
+	traversedCodeGenUnit.addModule(traversedTraceModule);
+	traversedCodeGenUnit.addModule(breakModule);
+
+	MacroCodeGenUnit aliasCodeGenUnit;
+	aliasCodeGenUnit.addModule(aliasTraceModule);
+
+	StaticMacroCodeGenUnit<TraceModule<TracePropertyCodeGen>, BreakModule>			staticIndexedCodeGenUnit;
+	StaticMacroCodeGenUnit<TraceModule<TraversedTracePropertyCodeGen>, BreakModule>	staticTraversedCodeGenUnit;
+
+	if (result)
+	{
+		result = generate(directory / "Input", directory / "Indexed", indexedCodeGenUnit) &&
+				 generate(directory / "Input", directory / "Traversed", traversedCodeGenUnit) &&
+				 generate(directory / "Input", directory / "StaticIndexed", staticIndexedCodeGenUnit) &&
+				 generate(directory / "Input", directory / "StaticTraversed", staticTraversedCodeGenUnit) &&
+				 generate(directory / "Input", directory / "Alias", aliasCodeGenUnit);
+
+		if (!result)
+		{
+			std::cerr << "Code generation failed." << std::endl;
+		}
+	}
+
+	result = result &&
+			 compareDirectories(directory / "Indexed", directory / "Traversed") &&
+			 compareDirectories(directory / "Indexed", directory / "StaticIndexed") &&
+			 compareDirectories(directory / "Indexed", directory / "StaticTraversed");
+
+	if (result && readFile(directory / "Indexed" / "Entities.h.h").find("HeaderFileHeader Outer::Inner::Base::field Trace#0") == std::string::npos)
+	{
+		std::cerr << "Property code generators didn't run." << std::endl;
+
+		result = false;
+	}
+
+	if (result && readFile(directory / "Alias" / "Entities.h.h").find("HeaderFileHeader Outer::Inner::AfterStop::aliasField TraceAlias#0") == std::string::npos)
+	{
+		std::cerr << "The override of shouldGenerateCodeForEntity accepting aliases was ignored." << std::endl;
+
+		result = false;
+	}
+
+	fs::remove_all(directory);
+
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
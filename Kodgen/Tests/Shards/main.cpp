@@ -0,0 +1,284 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <atomic>
+
+#include <Kodgen/CodeGen/CodeGenManager.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+#include <Kodgen/CodeGen/Macro/MacroPropertyCodeGen.h>
+#include <Kodgen/Parsing/FileParser.h>
+#include <Kodgen/Misc/Filesystem.h>
+
+using namespace kodgen;
+
+/**
+*	Check that the code of a large file generated in shards is exactly the same as the code generated serially,
+*	whether the shards could be merged or the file had to be generated again by a traversal of the whole file.
+*/
+
+/**
+*	Generation unit counting the shard units it merged the code of.
+*/
+class ShardCountingCodeGenUnit : public MacroCodeGenUnit
+{
+	protected:
+		virtual void mergeShardCode(std::vector<CodeGenUnit*> const& shardUnits) noexcept override
+		{
+			mergedShardsCount += shardUnits.size();
+
+			MacroCodeGenUnit::mergeShardCode(shardUnits);
+		}
+
+	public:
+		static std::atomic<size_t> mergedShardsCount;
+};
+
+std::atomic<size_t> ShardCountingCodeGenUnit::mergedShardsCount = 0u;
+
+/**
+*	Property code generator writing the entity and property it runs on.
+*/
+class TracePropertyCodeGen : public MacroPropertyCodeGen
+{
+	protected:
+		virtual bool generateHeaderFileHeaderCodeForEntity(EntityInfo const& entity, Property const& property, uint8 propertyIndex, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += "/* " + entity.getFullName() + " " + property.name + "#" + std::to_string(propertyIndex) + " */\n";
+
+			return true;
+		}
+
+	public:
+		TracePropertyCodeGen() noexcept:
+			MacroPropertyCodeGen("Trace", EEntityType::Class | EEntityType::Struct | EEntityType::Field)
+		{}
+};
+
+/**
+*	Module writing each visited entity, which doesn't visit the entities nested in the Skipped entities
+*	and skips the entities following the entity named on construction.
+*/
+class TraversalModule : public MacroCodeGenModule
+{
+	private:
+		TracePropertyCodeGen	_tracePropertyCodeGen;
+		std::string				_breakEntityName;
+
+	protected:
+		virtual ETraversalBehaviour generateHeaderFileHeaderCodeForEntity(EntityInfo const& entity, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += "//Visit " + entity.getFullName() + "\n";
+
+			if (entity.name == "Skipped")
+			{
+				return ETraversalBehaviour::Continue;
+			}
+
+			return (entity.name == _breakEntityName) ? ETraversalBehaviour::Break : ETraversalBehaviour::Recurse;
+		}
+
+	public:
+		TraversalModule(std::string const& breakEntityName) noexcept:
+			_breakEntityName{breakEntityName}
+		{
+			addPropertyCodeGen(_tracePropertyCodeGen);
+		}
+
+		TraversalModule(TraversalModule const& other) noexcept:
+			TraversalModule(other._breakEntityName) //Register the property code generator of the copy
+		{
+		}
+
+		virtual TraversalModule* clone() const noexcept override
+		{
+			return new TraversalModule(*this);
+		}
+};
+
+void writeFile(fs::path const& file, std::string const& content)
+{
+	std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+
+	stream << content;
+}
+
+std::string readFile(fs::path const& file)
+{
+	std::ifstream		stream(file, std::ios::binary);
+	std::ostringstream	content;
+
+	content << stream.rdbuf();
+
+	return content.str();
+}
+
+/**
+*	@brief Generate code for all headers of a directory.
+*
+*	@param directory		Directory containing the headers to process.
+*	@param outputDirectory	Directory the generated files are written to.
+*	@param codeGenModule	Module used to generate code.
+*	@param splitLargeFiles	Should the code of large files be generated in shards?
+*
+*	@return true if the generation completed successfully, else false.
+*/
+bool generate(fs::path const& directory, fs::path const& outputDirectory, TraversalModule& codeGenModule, bool splitLargeFiles)
+{
+	FileParser fileParser;
+
+	if (!fileParser.getSettings().setCompilerExeName("clang++") && !fileParser.getSettings().setCompilerExeName("g++"))
+	{
+		std::cerr << "No supported compiler found." << std::endl;
+
+		return false;
+	}
+
+	MacroCodeGenUnitSettings codeGenUnitSettings;
+	codeGenUnitSettings.setOutputDirectory(outputDirectory);
+
+	ShardCountingCodeGenUnit codeGenUnit;
+	codeGenUnit.setSettings(codeGenUnitSettings);
+	codeGenUnit.addModule(codeGenModule);
+
+	CodeGenManager codeGenManager(4u);
+	codeGenManager.settings.addToProcessDirectory(directory);
+	codeGenManager.settings.addSupportedFileExtension(".h");
+	codeGenManager.settings.shouldSplitLargeFiles	= splitLargeFiles;
+	codeGenManager.settings.minEntitiesPerShard		= 2u;
+
+	return codeGenManager.run(fileParser, codeGenUnit, true).completed;
+}
+
+/**
+*	@brief Compare all files generated in a directory with the files generated in a reference directory.
+*
+*	@param referenceDirectory	Directory containing the reference files.
+*	@param directory			Directory containing the compared files.
+*
+*	@return true if both directories contain the same files with the same content, else false.
+*/
+bool compareDirectories(fs::path const& referenceDirectory, fs::path const& directory)
+{
+	size_t comparedFileCount = 0u;
+
+	for (fs::directory_entry const& entry : fs::directory_iterator(referenceDirectory))
+	{
+		fs::path file = directory / entry.path().filename();
+
+		if (readFile(entry.path()) != readFile(file))
+		{
+			std::cerr << file.string() << " differs from " << entry.path().string() << "." << std::endl;
+
+			return false;
+		}
+
+		comparedFileCount++;
+	}
+
+	if (comparedFileCount != static_cast<size_t>(std::distance(fs::directory_iterator(directory), fs::directory_iterator())))
+	{
+		std::cerr << directory.string() << " and " << referenceDirectory.string() << " don't contain the same files." << std::endl;
+
+		return false;
+	}
+
+	return true;
+}
+
+/**
+*	@brief Generate code serially then in shards, and compare the generated files.
+*
+*	@param directory			Directory containing the Input directory to process.
+*	@param name					Name of the directories the generated files are written to.
+*	@param breakEntityName		Name of the entities the traversal breaks on.
+*	@param expectedMerge		Should the code generated in shards be merged, rather than generated again by a traversal of the whole file?
+*
+*	@return true if the code generated in shards is the same as the code generated serially, through the expected path, else false.
+*/
+bool checkShards(fs::path const& directory, std::string const& name, std::string const& breakEntityName, bool expectedMerge)
+{
+	TraversalModule traversalModule(breakEntityName);
+
+	if (!generate(directory / "Input", directory / (name + "Serial"), traversalModule, false))
+	{
+		std::cerr << "Serial code generation failed." << std::endl;
+
+		return false;
+	}
+
+	ShardCountingCodeGenUnit::mergedShardsCount = 0u;
+
+	if (!generate(directory / "Input", directory / (name + "Split"), traversalModule, true))
+	{
+		std::cerr << "Code generation in shards failed." << std::endl;
+
+		return false;
+	}
+
+	if (expectedMerge && ShardCountingCodeGenUnit::mergedShardsCount < 2u)
+	{
+		std::cerr << name << ": the code was not merged from shards." << std::endl;
+
+		return false;
+	}
+	else if (!expectedMerge && ShardCountingCodeGenUnit::mergedShardsCount != 0u)
+	{
+		std::cerr << name << ": the code was merged from shards which skipped different entities than a traversal of the whole file." << std::endl;
+
+		return false;
+	}
+
+	return compareDirectories(directory / (name + "Serial"), directory / (name + "Split"));
+}
+
+int main()
+{
+	fs::path directory = fs::temp_directory_path() / "KodgenShards";
+
+	fs::remove_all(directory);
+	fs::create_directories(directory / "Input");
+
+	std::string content = "#pragma once\n\n";
+
+	for (int i = 0; i < 12; i++)
+	{
+		std::string index = std::to_string(i);
+
+		content += "class CLASS(Trace) Class" + index + "\n{\n"
+				   "\tFIELD(Trace) int first" + index + ";\n"
+				   "\tFIELD() int Stop;\n"
+				   "\tFIELD(Trace) int last" + index + ";\n"
+				   "};\n\n";
+
+		content += "struct STRUCT() Struct" + index + " { FIELD(Trace) int field" + index + "; };\n\n";
+	}
+
+	content += "namespace NAMESPACE() Outer\n{\n"
+			   "\tclass CLASS(Trace) Skipped { FIELD(Trace) int skippedField; };\n\n"
+			   "\tclass CLASS(Trace) Visited { FIELD(Trace) int visitedField; };\n"
+			   "}\n";
+
+	writeFile(directory / "Input" / "Entities.h", content);
+
+	bool result = true;
+
+	//Breaking on fields and skipping the nested entities of a class don't skip entities of the following shards
+	result &= checkShards(directory, "Merged", "Stop", true);
+
+	//Breaking on a struct skips the structs of the following shards
+	result &= checkShards(directory, "Fallback", "Struct3", false);
+
+	if (result && readFile(directory / "MergedSplit" / "Entities.h.h").find("/* Class11::last11 Trace#0 */") == std::string::npos)
+	{
+		std::cerr << "Property code generators didn't run." << std::endl;
+
+		result = false;
+	}
+
+	fs::remove_all(directory);
+
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
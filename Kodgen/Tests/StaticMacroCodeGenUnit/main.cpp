@@ -0,0 +1,286 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <Kodgen/CodeGen/CodeGenManager.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+#include <Kodgen/CodeGen/Macro/MacroPropertyCodeGen.h>
+#include <Kodgen/CodeGen/Macro/StaticMacroCodeGenUnit.h>
+#include <Kodgen/Parsing/FileParser.h>
+#include <Kodgen/Misc/Filesystem.h>
+
+using namespace kodgen;
+
+/**
+*	Check that a StaticMacroCodeGenUnit generates exactly the same files as a MacroCodeGenUnit with the same modules.
+*/
+
+/**
+*	Property code generator writing the entity and property it runs on in every code location.
+*/
+class TracePropertyCodeGen : public MacroPropertyCodeGen
+{
+	private:
+		static std::string trace(EntityInfo const& entity, Property const& property, uint8 propertyIndex, char const* location) noexcept
+		{
+			std::string result = std::string("/* ") + location + " " + entity.getFullName() + " " + property.name + "#" + std::to_string(propertyIndex);
+
+			for (std::string const& argument : property.arguments)
+			{
+				result += " " + argument;
+			}
+
+			return result + " */";
+		}
+
+	protected:
+		virtual bool generateHeaderFileHeaderCodeForEntity(EntityInfo const& entity, Property const& property, uint8 propertyIndex, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += trace(entity, property, propertyIndex, "HeaderFileHeader") + "\n";
+
+			return true;
+		}
+
+		virtual bool generateClassFooterCodeForEntity(EntityInfo const& entity, Property const& property, uint8 propertyIndex, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += trace(entity, property, propertyIndex, "ClassFooter");
+
+			return true;
+		}
+
+		virtual bool generateHeaderFileFooterCodeForEntity(EntityInfo const& entity, Property const& property, uint8 propertyIndex, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += trace(entity, property, propertyIndex, "HeaderFileFooter");
+
+			return true;
+		}
+
+		virtual bool generateSourceFileHeaderCodeForEntity(EntityInfo const& entity, Property const& property, uint8 propertyIndex, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += trace(entity, property, propertyIndex, "SourceFileHeader") + "\n";
+
+			return true;
+		}
+
+	public:
+		TracePropertyCodeGen(std::string const& propertyName) noexcept:
+			MacroPropertyCodeGen(propertyName, EEntityType::Class | EEntityType::Struct | EEntityType::Field | EEntityType::Method |
+								 EEntityType::Enum | EEntityType::EnumValue | EEntityType::Function | EEntityType::Variable)
+		{}
+};
+
+/**
+*	Module writing every entity it traverses, with the property code generator running on Trace properties.
+*/
+class TraceModule : public MacroCodeGenModule
+{
+	private:
+		TracePropertyCodeGen _tracePropertyCodeGen{ "Trace" };
+
+	protected:
+		virtual ETraversalBehaviour generateHeaderFileHeaderCodeForEntity(EntityInfo const& entity, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += "//Trace " + entity.getFullName() + "\n";
+
+			return ETraversalBehaviour::Recurse;
+		}
+
+		virtual ETraversalBehaviour generateClassFooterCodeForEntity(EntityInfo const& entity, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += "/* Trace " + entity.name + " */";
+
+			return ETraversalBehaviour::Recurse;
+		}
+
+	public:
+		TraceModule() noexcept
+		{
+			addPropertyCodeGen(_tracePropertyCodeGen);
+		}
+
+		TraceModule(TraceModule const&) noexcept:
+			TraceModule() //Register the property code generator of the copy
+		{
+		}
+
+		virtual TraceModule* clone() const noexcept override
+		{
+			return new TraceModule(*this);
+		}
+};
+
+/**
+*	Module generating code in other code locations, skipping the content of enums, with the property code generator running on Summary properties.
+*/
+class SummaryModule : public MacroCodeGenModule
+{
+	private:
+		TracePropertyCodeGen _summaryPropertyCodeGen{ "Summary" };
+
+	protected:
+		virtual ETraversalBehaviour generateHeaderFileFooterCodeForEntity(EntityInfo const& entity, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += "/* Summary " + entity.getFullName() + " */";
+
+			return (entity.entityType == EEntityType::Enum) ? ETraversalBehaviour::Continue : ETraversalBehaviour::Recurse;
+		}
+
+		virtual ETraversalBehaviour generateSourceFileHeaderCodeForEntity(EntityInfo const& entity, MacroCodeGenEnv&, std::string& inout_result) noexcept override
+		{
+			inout_result += "//Summary " + entity.getFullName() + "\n";
+
+			return (entity.entityType == EEntityType::Enum) ? ETraversalBehaviour::Continue : ETraversalBehaviour::Recurse;
+		}
+
+	public:
+		SummaryModule() noexcept
+		{
+			addPropertyCodeGen(_summaryPropertyCodeGen);
+		}
+
+		SummaryModule(SummaryModule const&) noexcept:
+			SummaryModule() //Register the property code generator of the copy
+		{
+		}
+
+		virtual SummaryModule* clone() const noexcept override
+		{
+			return new SummaryModule(*this);
+		}
+};
+
+void writeFile(fs::path const& file, std::string const& content)
+{
+	std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+
+	stream << content;
+}
+
+std::string readFile(fs::path const& file)
+{
+	std::ifstream		stream(file, std::ios::binary);
+	std::ostringstream	content;
+
+	content << stream.rdbuf();
+
+	return content.str();
+}
+
+/**
+*	@brief Generate code for all headers of a directory.
+*
+*	@param directory		Directory containing the headers to process.
+*	@param outputDirectory	Directory the generated files are written to.
+*	@param codeGenUnit		Generation unit used to generate code.
+*
+*	@return true if the generation completed successfully, else false.
+*/
+template <typename CodeGenUnitType>
+bool generate(fs::path const& directory, fs::path const& outputDirectory, CodeGenUnitType& codeGenUnit)
+{
+	FileParser fileParser;
+
+	if (!fileParser.getSettings().setCompilerExeName("clang++") && !fileParser.getSettings().setCompilerExeName("g++"))
+	{
+		std::cerr << "No supported compiler found." << std::endl;
+
+		return false;
+	}
+
+	MacroCodeGenUnitSettings codeGenUnitSettings;
+	codeGenUnitSettings.setOutputDirectory(outputDirectory);
+
+	codeGenUnit.setSettings(codeGenUnitSettings);
+
+	CodeGenManager codeGenManager(2u);
+	codeGenManager.settings.addToProcessDirectory(directory);
+	codeGenManager.settings.addSupportedFileExtension(".h");
+
+	return codeGenManager.run(fileParser, codeGenUnit, true).completed;
+}
+
+int main()
+{
+	fs::path directory = fs::temp_directory_path() / "KodgenStaticMacroCodeGenUnit";
+
+	fs::remove_all(directory);
+	fs::create_directories(directory / "Input");
+
+	writeFile(directory / "Input" / "Entities.h",
+			  "#pragma once\n\n"
+			  "namespace NAMESPACE() Outer\n{\n"
+			  "\tclass CLASS(Trace) Base\n\t{\n"
+			  "\t\tFIELD(Trace(const, &)) int field;\n"
+			  "\t\tMETHOD(Trace, Summary) void method();\n"
+			  "\t\tFIELD() float untraced;\n"
+			  "\t\tstruct STRUCT(Trace) Nested { FIELD(Trace) int nestedField; };\n"
+			  "\t};\n\n"
+			  "\tenum class ENUM(Trace) Color { Red ENUMVALUE(Trace), Green };\n"
+			  "}\n\n"
+			  "FUNCTION(Trace) void freeFunction();\n"
+			  "VARIABLE(Trace) extern int freeVariable;\n");
+
+	writeFile(directory / "Input" / "Other.h",
+			  "#pragma once\n\n"
+			  "struct STRUCT(Summary) Plain { FIELD(Trace, Trace(second)) int twice; };\n");
+
+	MacroCodeGenUnit	macroCodeGenUnit;
+	TraceModule			traceModule;
+	SummaryModule		summaryModule;
+
+	macroCodeGenUnit.addModule(traceModule);
+	macroCodeGenUnit.addModule(summaryModule);
+
+	StaticMacroCodeGenUnit<TraceModule, SummaryModule> staticMacroCodeGenUnit;
+
+	bool result = generate(directory / "Input", directory / "Dynamic", macroCodeGenUnit) &&
+				  generate(directory / "Input", directory / "Static", staticMacroCodeGenUnit);
+
+	if (!result)
+	{
+		std::cerr << "Code generation failed." << std::endl;
+	}
+
+	size_t comparedFileCount = 0u;
+
+	for (fs::directory_entry const& entry : fs::directory_iterator(directory / "Dynamic"))
+	{
+		if (!result)
+		{
+			break;
+		}
+
+		fs::path staticFile = directory / "Static" / entry.path().filename();
+
+		if (readFile(entry.path()) != readFile(staticFile))
+		{
+			std::cerr << staticFile.string() << " differs from " << entry.path().string() << "." << std::endl;
+
+			result = false;
+		}
+
+		comparedFileCount++;
+	}
+
+	//Both units must generate the same set of files, with some generated code
+	if (result && (comparedFileCount < 4u || comparedFileCount != static_cast<size_t>(std::distance(fs::directory_iterator(directory / "Static"), fs::directory_iterator()))))
+	{
+		std::cerr << "The generation units didn't generate the same files." << std::endl;
+
+		result = false;
+	}
+
+	if (result && readFile(directory / "Static" / "Entities.h.h").find("ClassFooter Outer::Base::field Trace#0 const &") == std::string::npos)
+	{
+		std::cerr << "Property code generators didn't run." << std::endl;
+
+		result = false;
+	}
+
+	fs::remove_all(directory);
+
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
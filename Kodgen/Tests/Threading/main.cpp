@@ -2,6 +2,7 @@
 
 #include <Kodgen/Threading/ThreadPool.h>
 #include <Kodgen/Threading/TaskHelper.h>
+#include <Kodgen/Threading/MemoryBudgetController.h>
 
 using namespace kodgen;
 
@@ -15,6 +16,9 @@ struct B
 	void operator()(TaskBase*) noexcept { std::cout << "I am B!" << std::endl; }
 };
 
+/** Memory returned by the memory sampler of the memory budget controller. */
+uint64 sampledMemory = 0u;
+
 int main()
 {
 	ThreadPool threadPool;
@@ -42,5 +46,138 @@ int main()
 	//A is not callable, doesn't compile
 	//auto t4 = threadPool.submitTask(A());
 
+	//Wait for a subset of the submitted tasks only
+	threadPool.waitForTasks({ t2, t3 });
+
+	//Tasks submitted to a paused pool are not executed until the pool runs again
+	std::atomic_uint executedTasks = 0u;
+
+	threadPool.setIsRunning(false);
+
+	for (uint32 i = 0u; i < 100u; i++)
+	{
+		threadPool.submitTask("Count", [&executedTasks](TaskBase*) { executedTasks.fetch_add(1u); });
+	}
+
+	threadPool.joinWorkers();
+
+	if (executedTasks.load() != 0u)
+	{
+		return EXIT_FAILURE;
+	}
+
+	threadPool.setIsRunning(true);
+	threadPool.joinWorkers();
+
+	if (executedTasks.load() != 100u)
+	{
+		return EXIT_FAILURE;
+	}
+
+	//Parallel loops complete when called from a worker, even if all other workers are busy
+	std::vector<std::atomic_uint> calls(64u);
+
+	threadPool.submitTask("Parallel for", [&threadPool, &calls](TaskBase*)
+	{
+		threadPool.parallelFor(calls.size(), [&calls](size_t index) { calls[index].fetch_add(1u); });
+	});
+
+	threadPool.parallelFor(calls.size(), [&calls](size_t index) { calls[index].fetch_add(1u); });
+
+	threadPool.joinWorkers();
+
+	for (std::atomic_uint const& callsCount : calls)
+	{
+		if (callsCount.load() != 2u)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+
+	//Fewer tasks are admitted as memory grows, and more again when memory is released
+	sampledMemory = 100u;
+
+	MemoryBudgetController memoryBudgetController(1000u, 8u, []() { return sampledMemory; });
+
+	memoryBudgetController.acquire();
+	sampledMemory = 400u;
+	memoryBudgetController.acquire();
+
+	//300 per task out of a headroom of 900
+	if (memoryBudgetController.getAdmittedLimit() != 3u)
+	{
+		return EXIT_FAILURE;
+	}
+
+	sampledMemory = 1000u;
+	memoryBudgetController.release();
+
+	//The remaining task is estimated to 450 out of a headroom of 450
+	if (memoryBudgetController.getAdmittedLimit() != 1u)
+	{
+		return EXIT_FAILURE;
+	}
+
+	sampledMemory = 150u;
+
+	for (uint32 i = 0u; i < 20u; i++)
+	{
+		memoryBudgetController.acquire();
+		memoryBudgetController.release();
+	}
+
+	memoryBudgetController.release();
+
+	if (memoryBudgetController.getAdmittedLimit() != 8u)
+	{
+		return EXIT_FAILURE;
+	}
+
+	//Memory kept after tasks complete is not attributed to later tasks, but still reduces the headroom
+	sampledMemory = 100u;
+
+	MemoryBudgetController retainingBudgetController(1000u, 8u, []() { return sampledMemory; });
+
+	uint64 retainedMemory = 0u;
+
+	for (uint32 i = 0u; i < 20u; i++)
+	{
+		//2 overlapping tasks using 100 each while running and keeping 15 each once completed
+		retainingBudgetController.acquire();
+		sampledMemory += 100u;
+		retainingBudgetController.acquire();
+		sampledMemory += 100u;
+
+		retainedMemory += 15u;
+		sampledMemory = 100u + retainedMemory + 100u;
+		retainingBudgetController.release();
+
+		retainedMemory += 15u;
+		sampledMemory = 100u + retainedMemory;
+		retainingBudgetController.release();
+	}
+
+	if (retainingBudgetController.getTaskMemoryEstimate() > 150u || retainingBudgetController.getAdmittedLimit() != 300u / retainingBudgetController.getTaskMemoryEstimate())
+	{
+		return EXIT_FAILURE;
+	}
+
+	//Memory which is not used by tasks exceeds the budget
+	sampledMemory = 950u;
+	retainingBudgetController.acquire();
+
+	if (retainingBudgetController.getAdmittedLimit() != 1u)
+	{
+		return EXIT_FAILURE;
+	}
+
+	sampledMemory = 200u;
+	retainingBudgetController.release();
+
+	if (retainingBudgetController.getAdmittedLimit() != 800u / retainingBudgetController.getTaskMemoryEstimate())
+	{
+		return EXIT_FAILURE;
+	}
+
 	return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <Kodgen/Threading/ThreadPool.h>
+#include <Kodgen/Threading/TaskHelper.h>
+
+using namespace kodgen;
+
+/**
+*	Measure the scheduling overhead of the thread pool on empty tasks.
+*	Usage: ThreadingBenchmark [taskCount] [threadCount]
+*/
+
+template <typename Submitter>
+bool runBenchmark(char const* name, uint32 threadCount, uint32 expectedExecutions, std::atomic_uint& executionCounter, Submitter&& submitter)
+{
+	executionCounter.store(0u);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	{
+		ThreadPool threadPool(threadCount);
+
+		submitter(threadPool);
+
+		threadPool.joinWorkers();
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << name << ": " << expectedExecutions << " tasks in " << elapsed.count() * 1000.0 << "ms ("
+		<< elapsed.count() * 1000000000.0 / expectedExecutions << "ns/task)" << std::endl;
+
+	if (executionCounter.load() != expectedExecutions)
+	{
+		std::cerr << name << ": executed " << executionCounter.load() << " tasks, expected " << expectedExecutions << std::endl;
+
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	uint32	taskCount	= (argc > 1) ? static_cast<uint32>(std::stoul(argv[1])) : 100000u;
+	uint32	threadCount	= (argc > 2) ? static_cast<uint32>(std::stoul(argv[2])) : std::thread::hardware_concurrency();
+	bool	success		= true;
+
+	if (threadCount == 0u)
+	{
+		threadCount = 1u;
+	}
+
+	std::atomic_uint executionCounter;
+
+	//Tasks without any dependency
+	success &= runBenchmark("Independent tasks", threadCount, taskCount, executionCounter, [&](ThreadPool& threadPool)
+				{
+					for (uint32 i = 0u; i < taskCount; i++)
+					{
+						threadPool.submitTask("Independent", [&executionCounter](TaskBase*) { executionCounter.fetch_add(1u); });
+					}
+				});
+
+	//Pairs of tasks where the second one consumes the result of the first one, like parsing and generation tasks
+	success &= runBenchmark("Dependent pairs", threadCount, taskCount, executionCounter, [&](ThreadPool& threadPool)
+				{
+					for (uint32 i = 0u; i < taskCount / 2u; i++)
+					{
+						std::shared_ptr<TaskBase> first = threadPool.submitTask("First", [&executionCounter](TaskBase*) -> uint32
+														  {
+															  return executionCounter.fetch_add(1u);
+														  });
+
+						threadPool.submitTask("Second", [&executionCounter](TaskBase* task)
+											  {
+												  TaskHelper::getDependencyResult<uint32>(task, 0u);
+												  executionCounter.fetch_add(1u);
+											  }, { first });
+					}
+				});
+
+	//All tasks wait for a single task submitted first
+	success &= runBenchmark("Fan out", threadCount, taskCount, executionCounter, [&](ThreadPool& threadPool)
+				{
+					std::shared_ptr<TaskBase> root = threadPool.submitTask("Root", [&executionCounter](TaskBase*) { executionCounter.fetch_add(1u); });
+
+					for (uint32 i = 1u; i < taskCount; i++)
+					{
+						threadPool.submitTask("Leaf", [&executionCounter](TaskBase*) { executionCounter.fetch_add(1u); }, { root });
+					}
+				});
+
+	//Half of the tasks wait for a long task while the other half is ready, submitted in a single batch like CodeGenManager does
+	success &= runBenchmark("Blocked tasks", threadCount, taskCount, executionCounter, [&](ThreadPool& threadPool)
+				{
+					threadPool.setIsRunning(false);
+
+					std::shared_ptr<TaskBase> root = threadPool.submitTask("Root", [&executionCounter](TaskBase*)
+																		   {
+																			   //Keep blocked tasks blocked while other workers look for ready tasks
+																			   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+																			   executionCounter.fetch_add(1u);
+																		   });
+
+					for (uint32 i = 1u; i < taskCount / 2u; i++)
+					{
+						threadPool.submitTask("Blocked", [&executionCounter](TaskBase*) { executionCounter.fetch_add(1u); }, { root });
+					}
+
+					for (uint32 i = 0u; i < taskCount / 2u; i++)
+					{
+						threadPool.submitTask("Ready", [&executionCounter](TaskBase*) { executionCounter.fetch_add(1u); });
+					}
+
+					threadPool.setIsRunning(true);
+				});
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file